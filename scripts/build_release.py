@@ -43,11 +43,12 @@ def write_binary_at_offset(output_file, data, offset):
     output_file.seek(offset)
     output_file.write(data)
 
-def create_combined_binary(prebuilt_dir, firmware_bin_path, output_path):
+def create_combined_binary(prebuilt_dir, firmware_bin_path, output_path, partitions_path=None):
     """Creates a combined binary from all components"""
     boot_app0_path = os.path.join(prebuilt_dir, 'boot_app0.bin')
     bootloader_path = os.path.join(prebuilt_dir, 'bootloader.bin')
-    partitions_path = os.path.join(prebuilt_dir, 'partitions.bin')
+    if partitions_path is None:
+        partitions_path = os.path.join(prebuilt_dir, 'partitions.bin')
     
     # Check if files exist
     if not os.path.exists(boot_app0_path):
@@ -173,7 +174,7 @@ def create_addresses_file(partitions, binary_addrs, output_path):
         'NVS partition data (must be compiled to nvs.bin using nvs_partition_gen.py)'
     ])
     
-    # Write partition entries from default.csv
+    # Write partition entries from the partition table
     for name, addr in sorted(partitions.items()):
         writer.writerow([
             'partition',
@@ -192,6 +193,10 @@ def main():
     
     # Path to compiled firmware.bin
     firmware_bin = project_dir / '.pio' / 'build' / 'modesp32v1' / 'firmware.bin'
+
+    # Project partition table (adds the samples partition), built by PlatformIO
+    project_csv = project_dir / 'partitions.csv'
+    partitions_bin = project_dir / '.pio' / 'build' / 'modesp32v1' / 'partitions.bin'
     
     # Output files
     output_dir = project_dir / '.pio' / 'build' / 'modesp32v1'
@@ -208,13 +213,15 @@ def main():
         raise FileNotFoundError(f"Firmware binary not found: {firmware_bin}")
     
     # Parse partition addresses
-    print(f"Reading partitions from: {default_csv}")
-    partitions = parse_partitions_csv(default_csv)
+    partitions_csv = project_csv if project_csv.exists() else default_csv
+    print(f"Reading partitions from: {partitions_csv}")
+    partitions = parse_partitions_csv(partitions_csv)
     print(f"Found partitions: {list(partitions.keys())}")
     
     # Create combined binary
     print(f"Creating combined binary...")
-    binary_addrs = create_combined_binary(prebuilt_dir, firmware_bin, combined_bin)
+    binary_addrs = create_combined_binary(prebuilt_dir, firmware_bin, combined_bin,
+                                          partitions_bin if partitions_bin.exists() else None)
     
     # Create addresses file
     print(f"Creating addresses file...")
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Band-limited wavetable generator for the Mozzi voice engine:
+- Builds per-octave mip-mapped tables (sine, triangle, saw, square, Chebyshev 5th)
+  by additive synthesis, so no table contains harmonics above Nyquist for the
+  notes it is selected for
+- Writes src/osc/wavetables.h
+- Fold-back through the voice engine is measured by test/test_wavetable_aliasing
+"""
+
+import argparse
+import math
+import os
+
+AUDIO_RATE = 32768
+NYQUIST = AUDIO_RATE // 2
+CELLS = 256
+MIPS = 8
+MAX_HARMONICS = CELLS // 2 - 1
+
+WAVES = ["Sine", "Triangle", "Saw", "Square", "Chebyshev"]
+
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "osc", "wavetables.h")
+
+
+def mip_harmonics(mip):
+    """Harmonics a mip may hold. Mip m is used up to NYQUIST / (128 >> m) Hz."""
+    return min(MAX_HARMONICS, 128 >> mip)
+
+
+def chebyshev_5th(x):
+    return 16 * x ** 5 - 20 * x ** 3 + 5 * x
+
+
+def raw_wave(name):
+    """One naive period of the waveform, as the old tables had it"""
+    out = []
+    for i in range(CELLS):
+        t = i / CELLS
+        if name == "Sine":
+            out.append(math.sin(2 * math.pi * t))
+        elif name == "Triangle":
+            out.append(4 * t - 1 if t < 0.5 else 3 - 4 * t)
+        elif name == "Saw":
+            out.append(2 * t - 1)
+        elif name == "Square":
+            out.append(1.0 if t < 0.5 else -1.0)
+        elif name == "Chebyshev":
+            # Mozzi's waveshape table: T5 over a ramp from -1 to 1
+            out.append(chebyshev_5th(2 * t - 1))
+    return out
+
+
+def dft(samples):
+    """Complex harmonic amplitudes 0..CELLS/2 of one period"""
+    n = len(samples)
+    coeffs = []
+    for k in range(n // 2 + 1):
+        re = sum(s * math.cos(2 * math.pi * k * i / n) for i, s in enumerate(samples))
+        im = -sum(s * math.sin(2 * math.pi * k * i / n) for i, s in enumerate(samples))
+        coeffs.append(complex(re, im) / n)
+    return coeffs
+
+
+def band_limited(coeffs, harmonics):
+    """Resynthesize from harmonics 1..harmonics (DC dropped), scaled to int8"""
+    out = []
+    for i in range(CELLS):
+        v = 0.0
+        for k in range(1, harmonics + 1):
+            c = coeffs[k]
+            v += 2 * (c.real * math.cos(2 * math.pi * k * i / CELLS) - c.imag * math.sin(2 * math.pi * k * i / CELLS))
+        out.append(v)
+    peak = max(abs(v) for v in out) or 1.0
+    return [max(-128, min(127, int(round(v * 127 / peak)))) for v in out]
+
+
+def generate():
+    tables = {}
+    for name in WAVES:
+        coeffs = dft(raw_wave(name))
+        tables[name] = [band_limited(coeffs, mip_harmonics(m)) for m in range(MIPS)]
+    return tables
+
+
+def write_header(tables, path):
+    with open(path, "w") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by scripts/gen_wavetables.py, do not edit.\n")
+        f.write(f"// Band-limited {CELLS} cell tables, one mip per octave. Mip m holds at most\n")
+        f.write(f"// 128 >> m harmonics and is used for fundamentals up to {NYQUIST} / (128 >> m) Hz.\n\n")
+        f.write("#include <stdint.h>\n")
+        f.write("#include <mozzi_pgmspace.h>\n\n")
+        f.write("enum Waveform {\n")
+        for name in WAVES:
+            f.write(f"    Wave{name},\n")
+        f.write("    WaveCount\n")
+        f.write("};\n\n")
+        f.write(f"const int WAVE_CELLS = {CELLS};\n")
+        f.write(f"const int WAVE_MIPS = {MIPS};\n")
+        f.write(f"const uint32_t WAVE_NYQUIST = {NYQUIST};\n\n")
+        f.write("CONSTTABLE_STORAGE(int8_t) WAVETABLES[WaveCount][WAVE_MIPS][WAVE_CELLS] = {\n")
+        for name in WAVES:
+            f.write(f"    {{ // {name}\n")
+            for m, table in enumerate(tables[name]):
+                f.write(f"        {{ // mip {m}, {mip_harmonics(m)} harmonics\n")
+                for row in range(0, CELLS, 16):
+                    f.write("            " + ", ".join(str(v) for v in table[row:row + 16]) + ",\n")
+                f.write("        },\n")
+            f.write("    },\n")
+        f.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--output", default=OUTPUT, help="header to write")
+    args = parser.parse_args()
+
+    tables = generate()
+    write_header(tables, args.output)
+    print(f"Wrote {os.path.normpath(args.output)}")
+
+
+if __name__ == "__main__":
+    main()
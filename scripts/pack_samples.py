@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+"""
+Sample bank packer for the Mozzi sample voice:
+- Reads WAV files (8/16/24/32 bit PCM, mono or stereo) and maps each to a MIDI note
+- Mixes to mono, resamples to the audio rate and converts to signed 8 bit
+- Writes the "samples" partition image read by src/osc/sample_bank.cpp:
+  header, note index (offset/length/loop points), then the PCM
+
+Usage:
+    pack_samples.py -o samples.bin 36=kick.wav 38=snare.wav 42=hat.wav
+    pack_samples.py -o samples.bin 60=pad.wav,12000,24000   # loop frames 12000..24000
+
+Flash the image at the offset of the samples partition in partitions.csv
+(the script prints the esptool command).
+"""
+
+import argparse
+import os
+import struct
+import sys
+import wave
+from pathlib import Path
+
+from build_release import parse_partitions_csv
+
+MAGIC = 0x31504d53  # "SMP1"
+VERSION = 1
+AUDIO_RATE = 32768
+HEADER_FORMAT = '<IHHII'   # magic, version, count, rate, reserved
+ENTRY_FORMAT = '<BBHIIII'  # note, flags, reserved, offset, length, loop_start, loop_end
+FLAG_LOOP = 1
+MAX_SAMPLES = 128
+DATA_ALIGN = 4
+FLASH_SECTOR = 4096
+PARTITION_LABEL = 'samples'
+DEFAULT_PARTITION_SIZE = 0x160000
+
+
+def parse_spec(spec):
+    """NOTE=FILE[,LOOP_START,LOOP_END] -> (note, path, loop or None)"""
+    if '=' not in spec:
+        raise ValueError(f"Expected NOTE=FILE, got: {spec}")
+    note_str, rest = spec.split('=', 1)
+    parts = rest.split(',')
+    note = int(note_str)
+    if not 0 <= note <= 127:
+        raise ValueError(f"Note out of range: {note}")
+    loop = None
+    if len(parts) == 3:
+        loop = (int(parts[1]), int(parts[2]))
+    elif len(parts) != 1:
+        raise ValueError(f"Expected NOTE=FILE or NOTE=FILE,LOOP_START,LOOP_END, got: {spec}")
+    return note, parts[0], loop
+
+
+def read_wav(path):
+    """Reads a PCM WAV file, returns (mono samples in -1..1, rate)"""
+    with wave.open(path, 'rb') as w:
+        channels = w.getnchannels()
+        width = w.getsampwidth()
+        rate = w.getframerate()
+        raw = w.readframes(w.getnframes())
+
+    frames = len(raw) // (width * channels)
+    out = []
+    for f in range(frames):
+        acc = 0.0
+        for c in range(channels):
+            pos = (f * channels + c) * width
+            chunk = raw[pos:pos + width]
+            if width == 1:
+                value = (chunk[0] - 128) / 128.0  # 8 bit WAV is unsigned
+            else:
+                value = int.from_bytes(chunk, 'little', signed=True) / float(1 << (8 * width - 1))
+            acc += value
+        out.append(acc / channels)
+    return out, rate
+
+
+def resample(samples, rate):
+    """Linear interpolation to AUDIO_RATE"""
+    if rate == AUDIO_RATE or not samples:
+        return samples
+    length = int(len(samples) * AUDIO_RATE / rate)
+    step = rate / AUDIO_RATE
+    out = []
+    for i in range(length):
+        pos = i * step
+        idx = int(pos)
+        frac = pos - idx
+        a = samples[idx]
+        b = samples[idx + 1] if idx + 1 < len(samples) else a
+        out.append(a + (b - a) * frac)
+    return out
+
+
+def to_int8(samples):
+    return bytes((max(-128, min(127, int(round(s * 127)))) & 0xff) for s in samples)
+
+
+def build_image(specs):
+    """Returns (image bytes, list of entry dicts for the report)"""
+    if len(specs) > MAX_SAMPLES:
+        raise ValueError(f"At most {MAX_SAMPLES} samples")
+
+    notes = [note for note, _, _ in specs]
+    if len(set(notes)) != len(notes):
+        raise ValueError("Each note can have one sample")
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    offset = header_size + entry_size * len(specs)
+
+    entries = []
+    data = bytearray()
+    for note, path, loop in specs:
+        samples, rate = read_wav(path)
+        pcm = to_int8(resample(samples, rate))
+
+        flags = 0
+        loop_start, loop_end = 0, 0
+        if loop is not None:
+            loop_start, loop_end = loop
+            if not 0 <= loop_start < loop_end <= len(pcm):
+                raise ValueError(f"{path}: loop {loop_start}..{loop_end} outside 0..{len(pcm)} frames")
+            flags |= FLAG_LOOP
+
+        pad = (-(offset + len(data))) % DATA_ALIGN
+        data += b'\x00' * pad
+        entries.append({
+            'note': note, 'flags': flags, 'offset': offset + len(data), 'length': len(pcm),
+            'loop_start': loop_start, 'loop_end': loop_end, 'path': path, 'rate': rate,
+        })
+        data += pcm
+
+    image = bytearray(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(entries), AUDIO_RATE, 0))
+    for e in entries:
+        image += struct.pack(ENTRY_FORMAT, e['note'], e['flags'], 0, e['offset'], e['length'],
+                             e['loop_start'], e['loop_end'])
+    image += data
+
+    # Whole flash sectors, erased value past the end
+    image += b'\xff' * ((-len(image)) % FLASH_SECTOR)
+    return bytes(image), entries
+
+
+def partition_info(csv_path):
+    """Offset and size of the samples partition from partitions.csv, or None"""
+    if not csv_path.exists():
+        return None, DEFAULT_PARTITION_SIZE
+    offset = parse_partitions_csv(csv_path).get(PARTITION_LABEL)
+    size = DEFAULT_PARTITION_SIZE
+    with open(csv_path, 'r') as f:
+        for line in f:
+            row = [c.strip() for c in line.split(',')]
+            if row and row[0] == PARTITION_LABEL and len(row) >= 5:
+                size = int(row[4], 0)
+    return offset, size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('samples', nargs='+', help='NOTE=FILE[,LOOP_START,LOOP_END]')
+    parser.add_argument('-o', '--output', default='samples.bin', help='partition image to write')
+    args = parser.parse_args()
+
+    project_dir = Path(__file__).parent.parent
+    offset, size = partition_info(project_dir / 'partitions.csv')
+
+    specs = [parse_spec(s) for s in args.samples]
+    image, entries = build_image(specs)
+    if len(image) > size:
+        raise ValueError(f"Image is {len(image)} bytes, the {PARTITION_LABEL} partition holds {size}")
+
+    with open(args.output, 'wb') as f:
+        f.write(image)
+
+    for e in entries:
+        seconds = e['length'] / AUDIO_RATE
+        loop = f" loop {e['loop_start']}..{e['loop_end']}" if e['flags'] & FLAG_LOOP else ""
+        print(f"  note {e['note']:3d}: {os.path.basename(e['path'])} {e['rate']} Hz -> {e['length']} frames ({seconds:.2f} s){loop}")
+    print(f"\n✓ Wrote {args.output}: {len(entries)} samples, {len(image)} of {size} bytes")
+    if offset is not None:
+        print(f"  Flash with: esptool.py write_flash 0x{offset:X} {args.output}")
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except Exception as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
@@ -48,6 +48,10 @@ const OutChannel OUT_CHANNELS[OutChannelCount] = {
 
 const int ADC_0 = 36;
 const int ADC_1 = 37;
+
+// CV input network (IN 0 / IN 1): ADC pin voltage change per volt at the input (nominal).
+// The 0 V level is measured during output calibration.
+const int ADC_IN_MV_PER_V = 156;
 const int SYNC_IN = 18;
 const int SYNC_OUT = 19;
 const int NEO_PIXEL_PIN = 23;
@@ -70,4 +74,8 @@ const int MIDI_SETTINGS_EEPROM_ADDR = 0;
 const size_t EEPROM_SIZE = 64;
 
 const bool DEBUG_MIDI_PROCESSOR = false;
+const bool DEBUG_OSC = false; // print mozzi voice events and the active voices on every note
 const bool DEBUG_BLE_MIDI = true;
+const bool PROFILE_AUDIO = false; // print updateAudio() cycle counts once per second
+const bool PROFILE_SCOPE = false; // print the scope trace render time once per second
+const bool AUDIO_SUB_BLOCK_TIMING = true; // start mozzi notes at their offset within the audio block
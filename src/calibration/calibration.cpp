@@ -0,0 +1,125 @@
+#include <Arduino.h>
+#include <nvs.h>
+#include <esp_err.h>
+#include "calibration.h"
+
+#define NVS_NAMESPACE "calibration"
+
+Calibration::Calibration(void) {
+    set_default();
+}
+
+void Calibration::begin(void) {
+    recall();
+}
+
+int32_t Calibration::get_default_code_q4(int note) {
+    // codes per semitone = 2^PWM_RESOLUTION / (12 * Vpp)
+    const int32_t num = (int32_t)(1 << PWM_RESOLUTION) * (1 << CODE_FRAC_BITS) * 100;
+    const int32_t den = 12 * DEFAULT_VPP_X100;
+    int32_t offset = (note - MIDDLE_NOTE) * num;
+    offset += offset >= 0 ? den / 2 : -den / 2;
+    return (DEFAULT_ZERO_CODE << CODE_FRAC_BITS) + offset / den;
+}
+
+void Calibration::set_default(void) {
+    for (size_t out = 0; out < CAL_OUTPUT_COUNT; out++) {
+        set_default(out);
+    }
+}
+
+void Calibration::set_default(size_t out) {
+    if (out >= CAL_OUTPUT_COUNT) return;
+
+    for (size_t p = 0; p < POINT_COUNT; p++) {
+        points[out][p] = get_default_code_q4(p * POINT_SPACING);
+    }
+    build_table(out);
+}
+
+void Calibration::set_point(size_t out, size_t point, uint16_t code_q4) {
+    if (out >= CAL_OUTPUT_COUNT || point >= POINT_COUNT) return;
+    points[out][point] = code_q4;
+}
+
+uint16_t Calibration::get_point(size_t out, size_t point) const {
+    if (out >= CAL_OUTPUT_COUNT || point >= POINT_COUNT) return 0;
+    return points[out][point];
+}
+
+void Calibration::build_table(size_t out) {
+    if (out >= CAL_OUTPUT_COUNT) return;
+
+    const int32_t max_code_q4 = (int32_t)PWM_MAX_VAL << CODE_FRAC_BITS;
+
+    for (int note = 0; note < NOTE_COUNT; note++) {
+        // Piecewise linear between octave points, the last segment is extrapolated above C9
+        int segment = note / POINT_SPACING;
+        if (segment > POINT_COUNT - 2) {
+            segment = POINT_COUNT - 2;
+        }
+        int32_t c0 = points[out][segment];
+        int32_t c1 = points[out][segment + 1];
+        int32_t offset = note - segment * POINT_SPACING;
+        int32_t code_q4 = c0 + (c1 - c0) * offset / POINT_SPACING;
+
+        if (code_q4 < 0) code_q4 = 0;
+        if (code_q4 > max_code_q4) code_q4 = max_code_q4;
+        note_table[out][note] = code_q4;
+    }
+}
+
+void Calibration::store(void) {
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs_handle);
+    if (err != ESP_OK) {
+        Serial.printf("calibration store: failed to open NVS namespace, err=0x%x\n", err);
+        return;
+    }
+
+    for (size_t out = 0; out < CAL_OUTPUT_COUNT; out++) {
+        char key[10];
+        snprintf(key, sizeof(key), "out%zu", out);
+        err = nvs_set_blob(nvs_handle, key, points[out], sizeof(points[out]));
+        if (err != ESP_OK) {
+            Serial.printf("calibration store: failed to set %s, err=0x%x\n", key, err);
+            nvs_close(nvs_handle);
+            return;
+        }
+    }
+
+    err = nvs_commit(nvs_handle);
+    if (err != ESP_OK) {
+        Serial.printf("calibration store: failed to commit, err=0x%x\n", err);
+    }
+    nvs_close(nvs_handle);
+}
+
+void Calibration::recall(void) {
+    set_default();
+
+    nvs_handle_t nvs_handle;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs_handle);
+    if (err != ESP_OK) {
+        // Not calibrated yet, keep defaults
+        return;
+    }
+
+    for (size_t out = 0; out < CAL_OUTPUT_COUNT; out++) {
+        char key[10];
+        snprintf(key, sizeof(key), "out%zu", out);
+        uint16_t stored[POINT_COUNT];
+        size_t size = sizeof(stored);
+        err = nvs_get_blob(nvs_handle, key, stored, &size);
+        if (err == ESP_OK && size == sizeof(stored)) {
+            for (size_t p = 0; p < POINT_COUNT; p++) {
+                points[out][p] = stored[p];
+            }
+            build_table(out);
+        } else if (err != ESP_ERR_NVS_NOT_FOUND) {
+            Serial.printf("calibration recall: failed to get %s, err=0x%x\n", key, err);
+        }
+    }
+
+    nvs_close(nvs_handle);
+}
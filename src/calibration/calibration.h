@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../board.h"
+
+// Number of CV outputs that can be calibrated (A, B, C)
+const int CAL_OUTPUT_COUNT = OutChannelClk;
+
+// Per-output pitch CV calibration.
+// Each output stores the DAC code (1/16 code units) of every C note from C-1 (note 0)
+// to C9 (note 120) in NVS. From these points a 128-note DAC code table is built per
+// output, so pitch updates are integer table reads with linear interpolation for bend.
+class Calibration {
+public:
+    static const int POINT_COUNT = 11;        // one point per octave, notes 0, 12, ..., 120
+    static const int POINT_SPACING = 12;      // semitones between points
+    static const int NOTE_COUNT = 128;
+    static const int CODE_FRAC_BITS = 4;      // table and points are stored in 1/16 DAC codes
+    static const int BEND_FRAC_BITS = 12;     // bend is passed as semitones in Q12
+    static const int MIDDLE_NOTE = 60;        // C4 (middle C), 0 V
+
+    Calibration();
+
+    // Load from NVS (or defaults) and build the note tables
+    void begin(void);
+    void store(void);
+    void recall(void);
+    void set_default(void);
+    void set_default(size_t out);
+
+    void set_point(size_t out, size_t point, uint16_t code_q4);
+    uint16_t get_point(size_t out, size_t point) const;
+    // Rebuild the note table of an output after its points changed
+    void build_table(size_t out);
+
+    // DAC code for a note with bend in semitones (Q12), clamped to the DAC range
+    inline int get_pitch_code(size_t out, int note, int32_t bend_q12) const {
+        note += bend_q12 >> BEND_FRAC_BITS;
+        int32_t frac = bend_q12 & ((1 << BEND_FRAC_BITS) - 1);
+
+        if (note < 0) {
+            note = 0;
+            frac = 0;
+        } else if (note >= NOTE_COUNT - 1) {
+            note = NOTE_COUNT - 1;
+            frac = 0;
+        }
+
+        const uint16_t* table = note_table[out];
+        int32_t code_q4 = table[note];
+        if (frac != 0) {
+            code_q4 += ((int32_t)(table[note + 1] - table[note]) * frac) >> BEND_FRAC_BITS;
+        }
+        return (code_q4 + (1 << (CODE_FRAC_BITS - 1))) >> CODE_FRAC_BITS;
+    }
+
+    // DAC code for 0 V on an output
+    inline int get_zero_code(size_t out) const {
+        return (note_table[out][MIDDLE_NOTE] + (1 << (CODE_FRAC_BITS - 1))) >> CODE_FRAC_BITS;
+    }
+
+    // Default (uncalibrated) DAC code for a note, 1/16 code units
+    static int32_t get_default_code_q4(int note);
+
+private:
+    // Nominal output: 10.99 Vpp over the DAC range, 1 V/oct, 0 V at MIDDLE_NOTE
+    static const int DEFAULT_ZERO_CODE = 498;
+    static const int DEFAULT_VPP_X100 = 1099;
+
+    uint16_t points[CAL_OUTPUT_COUNT][POINT_COUNT];
+    uint16_t note_table[CAL_OUTPUT_COUNT][NOTE_COUNT];
+};
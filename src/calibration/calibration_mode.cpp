@@ -0,0 +1,194 @@
+#include "calibration_mode.h"
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "../input/input.h"
+#include "../board.h"
+
+static const int SWEEP_STEP = 32;                                  // DAC codes between sweep points
+static const int SWEEP_POINTS = (PWM_MAX_VAL + 1) / SWEEP_STEP + 1;
+static const int SETTLE_MS = 20;                                   // output filter settling per step
+static const int ADC_AVERAGE = 64;                                 // ADC samples averaged per step
+static const int ADC_MIN_VALID_MV = 50;                            // readings outside are saturated
+static const int ADC_MAX_VALID_MV = 3100;
+static const int SLOPE_TOLERANCE_PCT = 30;                         // allowed deviation from nominal gain
+
+// Measured transfer curve of one output: DAC code -> ADC pin millivolts (1/16 mV)
+struct Sweep {
+    int count;
+    int16_t code[SWEEP_POINTS];
+    int32_t mv_q4[SWEEP_POINTS];
+};
+
+static int32_t read_mv_q4(int pin) {
+    int32_t sum = 0;
+    for (int i = 0; i < ADC_AVERAGE; i++) {
+        sum += analogReadMilliVolts(pin);
+    }
+    return sum * 16 / ADC_AVERAGE;
+}
+
+static void display_message(Adafruit_SSD1306* display, const char* line1, const char* line2, const char* line3) {
+    display->clearDisplay();
+    display->setTextSize(1);
+    display->setTextColor(SSD1306_WHITE);
+    display->setCursor(0, 0);
+
+    display->setTextSize(2);
+    display->println("calibrate");
+    display->setTextSize(1);
+
+    display->println(line1);
+    display->println(line2);
+    display->println();
+    display->println(line3);
+
+    display->display();
+}
+
+// Returns true when the encoder switch is pressed, false when button A cancels
+static bool wait_for_button(Input* input) {
+    for (;;) {
+        Event event = input->get_inputs();
+        if (event.button_sw == ButtonPress) return true;
+        if (event.button_a == ButtonPress) return false;
+        delay(10);
+    }
+}
+
+static void sweep(SignalProcessor* signal_processor, const int* outs, const int* pins, int count, Sweep* sweeps) {
+    for (int i = 0; i < count; i++) {
+        sweeps[i].count = 0;
+    }
+
+    for (int step = 0; step < SWEEP_POINTS; step++) {
+        int code = step * SWEEP_STEP;
+        if (code > int(PWM_MAX_VAL)) code = PWM_MAX_VAL;
+
+        for (int i = 0; i < count; i++) {
+            signal_processor->out_code(outs[i], code);
+        }
+        delay(SETTLE_MS);
+
+        for (int i = 0; i < count; i++) {
+            int32_t mv_q4 = read_mv_q4(pins[i]);
+            if (mv_q4 < ADC_MIN_VALID_MV * 16 || mv_q4 > ADC_MAX_VALID_MV * 16) continue;
+
+            Sweep* s = &sweeps[i];
+            s->code[s->count] = code;
+            s->mv_q4[s->count] = mv_q4;
+            s->count++;
+        }
+    }
+}
+
+// Fit calibration points of an output from its sweep. Leaves the calibration untouched on failure.
+static bool fit(const Sweep& sweep, int32_t zero_mv_q4, Calibration* calibration, size_t out) {
+    if (sweep.count < 2) return false;
+
+    int first = 0;
+    int last = sweep.count - 1;
+    int32_t span_mv_q4 = sweep.mv_q4[last] - sweep.mv_q4[first];
+    int32_t span_code = sweep.code[last] - sweep.code[first];
+    if (span_code <= 0 || span_mv_q4 <= 0) return false;
+
+    // Nominal: 2^PWM_RESOLUTION codes per 10.99 V, ADC_IN_MV_PER_V at the ADC pin
+    int32_t nominal_mv_q4 = (int32_t)ADC_IN_MV_PER_V * 16 * 1099 / 100 * span_code / (1 << PWM_RESOLUTION);
+    int32_t deviation = span_mv_q4 - nominal_mv_q4;
+    if (deviation < 0) deviation = -deviation;
+    if (deviation * 100 > nominal_mv_q4 * SLOPE_TOLERANCE_PCT) return false; // not patched or wrong jack
+
+    uint16_t points[Calibration::POINT_COUNT];
+    for (int p = 0; p < Calibration::POINT_COUNT; p++) {
+        int note = p * Calibration::POINT_SPACING;
+        int32_t target = zero_mv_q4 + (note - Calibration::MIDDLE_NOTE) * ADC_IN_MV_PER_V * 16 / 12;
+
+        // Segment containing the target, the end segments are extrapolated
+        int seg = 0;
+        while (seg < sweep.count - 2 && target > sweep.mv_q4[seg + 1]) {
+            seg++;
+        }
+
+        int32_t m0 = sweep.mv_q4[seg];
+        int32_t m1 = sweep.mv_q4[seg + 1];
+        int32_t c0 = sweep.code[seg] << Calibration::CODE_FRAC_BITS;
+        int32_t c1 = sweep.code[seg + 1] << Calibration::CODE_FRAC_BITS;
+        if (m1 <= m0) return false; // not monotonic
+
+        int32_t code_q4 = c0 + (target - m0) * (c1 - c0) / (m1 - m0);
+        if (code_q4 < 0) code_q4 = 0;
+        if (code_q4 > (int32_t)PWM_MAX_VAL << Calibration::CODE_FRAC_BITS) {
+            code_q4 = (int32_t)PWM_MAX_VAL << Calibration::CODE_FRAC_BITS;
+        }
+        points[p] = code_q4;
+    }
+
+    for (int p = 0; p < Calibration::POINT_COUNT; p++) {
+        calibration->set_point(out, p, points[p]);
+    }
+    calibration->build_table(out);
+    return true;
+}
+
+bool calibration_mode(Adafruit_SSD1306* display, Input* input, SignalProcessor* signal_processor) {
+    Calibration* calibration = &signal_processor->calibration;
+    bool ok[CAL_OUTPUT_COUNT] = {false, false, false};
+    int32_t zero_mv_q4[2];
+    Sweep sweeps[2];
+
+    signal_processor->set_output_hold(true);
+
+    for (int step = CalStepZero; step < CalStepDone; step++) {
+        switch (step) {
+            case CalStepZero:
+                display_message(display, "Unpatch IN 0, IN 1", "", "SW: next  A: cancel");
+                break;
+            case CalStepAB:
+                display_message(display, "Patch A -> IN 0", "      B -> IN 1", "SW: next  A: cancel");
+                break;
+            case CalStepC:
+                display_message(display, "Patch C -> IN 0", "", "SW: next  A: cancel");
+                break;
+        }
+
+        if (!wait_for_button(input)) {
+            // Cancelled, drop any points fitted so far
+            calibration->recall();
+            signal_processor->set_output_hold(false);
+            return false;
+        }
+
+        display_message(display, "Measuring...", "", "");
+
+        if (step == CalStepZero) {
+            zero_mv_q4[0] = read_mv_q4(ADC_0);
+            zero_mv_q4[1] = read_mv_q4(ADC_1);
+        } else if (step == CalStepAB) {
+            const int outs[2] = {OutChannelA, OutChannelB};
+            const int pins[2] = {ADC_0, ADC_1};
+            sweep(signal_processor, outs, pins, 2, sweeps);
+            ok[OutChannelA] = fit(sweeps[0], zero_mv_q4[0], calibration, OutChannelA);
+            ok[OutChannelB] = fit(sweeps[1], zero_mv_q4[1], calibration, OutChannelB);
+        } else if (step == CalStepC) {
+            const int outs[1] = {OutChannelC};
+            const int pins[1] = {ADC_0};
+            sweep(signal_processor, outs, pins, 1, sweeps);
+            ok[OutChannelC] = fit(sweeps[0], zero_mv_q4[0], calibration, OutChannelC);
+        }
+    }
+
+    bool all_ok = ok[OutChannelA] && ok[OutChannelB] && ok[OutChannelC];
+    if (ok[OutChannelA] || ok[OutChannelB] || ok[OutChannelC]) {
+        calibration->store();
+    }
+
+    char result[32];
+    snprintf(result, sizeof(result), "A %s  B %s  C %s",
+             ok[OutChannelA] ? "OK" : "FAIL",
+             ok[OutChannelB] ? "OK" : "FAIL",
+             ok[OutChannelC] ? "OK" : "FAIL");
+    display_message(display, result, all_ok ? "Saved" : "Failed kept previous", "SW: done");
+    wait_for_button(input);
+
+    signal_processor->set_output_hold(false);
+    return all_ok;
+}
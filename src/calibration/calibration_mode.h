@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Adafruit_SSD1306.h>
+#include "../signal_processor/signal_processor.h"
+
+class Input;
+
+enum CalibrationStep {
+    CalStepZero,   // inputs unpatched, measure 0 V level of IN 0 / IN 1
+    CalStepAB,     // A -> IN 0, B -> IN 1
+    CalStepC,      // C -> IN 0
+    CalStepDone,
+    CalStepCount
+};
+
+// Automatic CV output calibration through ADC loopback.
+// Sweeps DAC codes on outputs patched into IN 0 / IN 1, fits a piecewise-linear
+// transfer curve and stores the per-output calibration points in NVS.
+// Returns true if all outputs were calibrated.
+bool calibration_mode(Adafruit_SSD1306* display, Input* input, SignalProcessor* signal_processor);
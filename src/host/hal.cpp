@@ -0,0 +1,390 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <esp_partition.h>
+#include <nvs.h>
+#include <nvs_flash.h>
+#include <stdarg.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "hal.h"
+
+HostSerial Serial;
+HostSerial Serial2;
+HostEsp ESP;
+
+// Time
+
+static uint64_t time_us = 0;
+
+uint64_t host_get_time_us(void) {
+    return time_us;
+}
+
+void host_set_time_us(uint64_t us) {
+    time_us = us;
+}
+
+int64_t esp_timer_get_time(void) {
+    return (int64_t)time_us;
+}
+
+unsigned long millis(void) {
+    return (unsigned long)(time_us / 1000);
+}
+
+unsigned long micros(void) {
+    return (unsigned long)time_us;
+}
+
+// Nothing else runs meanwhile, so waiting only moves the clock
+void delay(uint32_t ms) {
+    time_us += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us) {
+    time_us += us;
+}
+
+uint32_t HostEsp::getCycleCount(void) {
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return (uint32_t)(ns * CPU_FREQ_MHZ / 1000);
+}
+
+// Pins
+
+static FILE* trace_file = nullptr;
+static uint32_t trace_count = 0;
+
+bool host_trace_open(const char* path) {
+    trace_file = fopen(path, "w");
+    if (trace_file == nullptr) return false;
+    fprintf(trace_file, "time_us,kind,pin,value\n");
+    return true;
+}
+
+void host_trace_close(void) {
+    if (trace_file != nullptr) {
+        fclose(trace_file);
+        trace_file = nullptr;
+    }
+}
+
+uint32_t host_get_trace_count(void) {
+    return trace_count;
+}
+
+static void trace(const char* kind, uint8_t pin, uint32_t value) {
+    trace_count++;
+    if (trace_file != nullptr) {
+        fprintf(trace_file, "%llu,%s,%u,%u\n", (unsigned long long)time_us, kind, pin, value);
+    }
+}
+
+static uint8_t pin_level[256];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    pin_level[pin] = val ? HIGH : LOW;
+    trace("gpio", pin, pin_level[pin]);
+}
+
+int digitalRead(uint8_t pin) {
+    return pin_level[pin];
+}
+
+uint16_t analogRead(uint8_t pin) {
+    (void)pin;
+    return 0;
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin) {
+    (void)pin;
+    return 0;
+}
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution) {
+    (void)pin;
+    (void)freq;
+    (void)resolution;
+    return true;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t duty) {
+    trace("ledc", pin, duty);
+    return true;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    const long run = in_max - in_min;
+    if (run == 0) return 0;
+    return (x - in_min) * (out_max - out_min) / run + out_min;
+}
+
+// Serial
+
+void HostSerial::begin(unsigned long baud, uint32_t config, int8_t rx_pin, int8_t tx_pin) {
+    (void)baud;
+    (void)config;
+    (void)rx_pin;
+    (void)tx_pin;
+}
+
+size_t HostSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HostSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n < 0 ? 0 : (size_t)n;
+}
+
+size_t HostSerial::print(const char* s) { return printf("%s", s); }
+size_t HostSerial::print(char c) { return write((uint8_t)c); }
+size_t HostSerial::print(int n) { return printf("%d", n); }
+size_t HostSerial::print(unsigned int n) { return printf("%u", n); }
+size_t HostSerial::print(long n) { return printf("%ld", n); }
+size_t HostSerial::print(unsigned long n) { return printf("%lu", n); }
+size_t HostSerial::print(double n, int digits) { return printf("%.*f", digits, n); }
+size_t HostSerial::println(void) { return print("\r\n"); }
+
+void host_error_check_failed(esp_err_t err, const char* file, int line, const char* expression) {
+    fprintf(stderr, "ESP_ERROR_CHECK failed: esp_err_t 0x%x at %s:%d\nexpression: %s\n", err, file, line, expression);
+    abort();
+}
+
+// FreeRTOS
+
+struct HostSemaphore {
+    std::timed_mutex mutex;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new HostSemaphore();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait) {
+    if (ticks_to_wait == portMAX_DELAY) {
+        semaphore->mutex.lock();
+        return pdTRUE;
+    }
+    return semaphore->mutex.try_lock_for(std::chrono::milliseconds(ticks_to_wait)) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    semaphore->mutex.unlock();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stack_depth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* created_task,
+                                   BaseType_t core_id) {
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    (void)core_id;
+    if (created_task != nullptr) *created_task = nullptr;
+    task(parameter);
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks * portTICK_PERIOD_MS);
+}
+
+// NVS
+
+enum NvsType : uint8_t {
+    NvsU8,
+    NvsU32,
+    NvsBlob
+};
+
+struct NvsValue {
+    NvsType type;
+    std::vector<uint8_t> data;
+};
+
+struct NvsOpen {
+    std::string name_space;
+    bool writable;
+};
+
+static bool nvs_initialized = false;
+static std::map<std::string, NvsValue> nvs_values; // "namespace/key"
+static std::map<nvs_handle_t, NvsOpen> nvs_handles;
+static nvs_handle_t nvs_next_handle = 1;
+
+esp_err_t nvs_flash_init(void) {
+    nvs_initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase(void) {
+    nvs_values.clear();
+    return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t open_mode, nvs_handle_t* out_handle) {
+    if (!nvs_initialized) return ESP_ERR_NVS_NOT_INITIALIZED;
+
+    // A namespace exists once something was written to it
+    if (open_mode == NVS_READONLY) {
+        std::string prefix = std::string(name) + "/";
+        auto it = nvs_values.lower_bound(prefix);
+        if (it == nvs_values.end() || it->first.compare(0, prefix.size(), prefix) != 0) {
+            return ESP_ERR_NVS_NOT_FOUND;
+        }
+    }
+
+    *out_handle = nvs_next_handle++;
+    nvs_handles[*out_handle] = NvsOpen{name, open_mode == NVS_READWRITE};
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+    nvs_handles.erase(handle);
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    return nvs_handles.count(handle) ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE;
+}
+
+static esp_err_t nvs_set(nvs_handle_t handle, const char* key, NvsType type, const void* value, size_t length) {
+    auto open = nvs_handles.find(handle);
+    if (open == nvs_handles.end() || !open->second.writable) return ESP_ERR_NVS_INVALID_HANDLE;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(value);
+    nvs_values[open->second.name_space + "/" + key] = NvsValue{type, std::vector<uint8_t>(bytes, bytes + length)};
+    return ESP_OK;
+}
+
+static const NvsValue* nvs_get(nvs_handle_t handle, const char* key, NvsType type, esp_err_t* err) {
+    auto open = nvs_handles.find(handle);
+    if (open == nvs_handles.end()) {
+        *err = ESP_ERR_NVS_INVALID_HANDLE;
+        return nullptr;
+    }
+    auto it = nvs_values.find(open->second.name_space + "/" + key);
+    if (it == nvs_values.end() || it->second.type != type) {
+        *err = ESP_ERR_NVS_NOT_FOUND;
+        return nullptr;
+    }
+    *err = ESP_OK;
+    return &it->second;
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char* key, uint8_t value) {
+    return nvs_set(handle, key, NvsU8, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char* key, uint8_t* out_value) {
+    esp_err_t err;
+    const NvsValue* value = nvs_get(handle, key, NvsU8, &err);
+    if (value != nullptr) memcpy(out_value, value->data.data(), sizeof(*out_value));
+    return err;
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char* key, uint32_t value) {
+    return nvs_set(handle, key, NvsU32, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char* key, uint32_t* out_value) {
+    esp_err_t err;
+    const NvsValue* value = nvs_get(handle, key, NvsU32, &err);
+    if (value != nullptr) memcpy(out_value, value->data.data(), sizeof(*out_value));
+    return err;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    return nvs_set(handle, key, NvsBlob, value, length);
+}
+
+// Like the device: a null out_value queries the length
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length) {
+    esp_err_t err;
+    const NvsValue* value = nvs_get(handle, key, NvsBlob, &err);
+    if (value == nullptr) return err;
+    if (out_value == nullptr) {
+        *length = value->data.size();
+        return ESP_OK;
+    }
+    if (*length < value->data.size()) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out_value, value->data.data(), value->data.size());
+    *length = value->data.size();
+    return ESP_OK;
+}
+
+// Partitions
+
+struct HostPartition {
+    esp_partition_t info;
+    std::vector<uint8_t> data;
+};
+
+static std::vector<HostPartition*> partitions;
+
+bool host_load_partition(const char* label, const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return false;
+
+    HostPartition* partition = new HostPartition();
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        partition->data.insert(partition->data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    partition->info.type = ESP_PARTITION_TYPE_DATA;
+    partition->info.subtype = ESP_PARTITION_SUBTYPE_ANY;
+    partition->info.address = 0;
+    partition->info.size = partition->data.size();
+    snprintf(partition->info.label, sizeof(partition->info.label), "%s", label);
+    partition->info.encrypted = false;
+    partitions.push_back(partition);
+    return true;
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    for (HostPartition* p : partitions) {
+        if (p->info.type != type) continue;
+        if (subtype != ESP_PARTITION_SUBTYPE_ANY && p->info.subtype != subtype) continue;
+        if (label != nullptr && strcmp(p->info.label, label) != 0) continue;
+        return &p->info;
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void** out_ptr,
+                             esp_partition_mmap_handle_t* out_handle) {
+    (void)memory;
+    for (HostPartition* p : partitions) {
+        if (&p->info != partition) continue;
+        if (offset > p->data.size() || size > p->data.size() - offset) return ESP_ERR_INVALID_ARG;
+        *out_ptr = p->data.data() + offset;
+        *out_handle = 0;
+        return ESP_OK;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle) {
+    (void)handle;
+}
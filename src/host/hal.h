@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Host side of the HAL shims in host/include. Everything runs on one thread:
+// the renderer drives time through audioHook() and reads the results here.
+
+// Simulated time, advanced one audio sample per audioHook() call
+uint64_t host_get_time_us(void);
+void host_set_time_us(uint64_t time_us);
+
+// CSV trace of every ledcWrite()/digitalWrite(): time_us,kind,pin,value.
+// Writes are counted but not recorded while no trace is open.
+bool host_trace_open(const char* path);
+void host_trace_close(void);
+uint32_t host_get_trace_count(void);
+
+// Load a data partition image (e.g. "samples" from scripts/pack_samples.py)
+// for esp_partition_find_first()/esp_partition_mmap()
+bool host_load_partition(const char* label, const char* path);
+
+// Called by audioHook() before each updateControl(), and with each output
+// sample as PWM codes (0 .. 2^MOZZI_AUDIO_BITS - 1, bias included)
+typedef void (*HostControlHook)(void);
+typedef void (*HostAudioSink)(int left, int right);
+void host_mozzi_set_hooks(HostControlHook control_hook, HostAudioSink audio_sink);
+
+// Thrown by a hook to leave the audio task, which otherwise loops forever
+struct HostStop {};
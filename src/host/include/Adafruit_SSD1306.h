@@ -0,0 +1,5 @@
+#pragma once
+
+// Host build: only the type is needed, by urack_types.h
+
+class Adafruit_SSD1306;
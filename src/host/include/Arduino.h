@@ -0,0 +1,88 @@
+#pragma once
+
+// Host build: the subset of the Arduino-ESP32 core used by the signal path.
+// Pin writes go to the trace in host/hal.cpp, time is the simulated clock.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define PI 3.1415926535897932384626433832795
+
+#define SERIAL_8N1 0x800001c
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+#define F(string_literal) (string_literal)
+
+typedef uint8_t byte;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+
+bool ledcAttach(uint8_t pin, uint32_t freq, uint8_t resolution);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// Serial console, printed to stdout
+class HostSerial {
+public:
+    void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rx_pin = -1, int8_t tx_pin = -1);
+    int available(void) { return 0; }
+    int read(void) { return -1; }
+    size_t write(uint8_t c);
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(int n);
+    size_t print(unsigned int n);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(double n, int digits = 2);
+    size_t println(void);
+    template <typename T>
+    size_t println(T value) { return print(value) + println(); }
+};
+
+typedef HostSerial HardwareSerial;
+extern HostSerial Serial;
+extern HostSerial Serial2;
+
+// Cycle counter for the profiling code: host time scaled to the ESP32 clock
+class HostEsp {
+public:
+    uint32_t getCycleCount(void);
+    uint32_t getCpuFreqMHz(void) { return CPU_FREQ_MHZ; }
+    uint32_t getFreeHeap(void) { return 0; }
+
+    static const uint32_t CPU_FREQ_MHZ = 240;
+};
+
+extern HostEsp ESP;
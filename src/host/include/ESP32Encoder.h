@@ -0,0 +1,12 @@
+#pragma once
+
+// Host build: only the type is needed, by input/input.h
+
+#include <stdint.h>
+
+class ESP32Encoder {
+public:
+    void attachHalfQuad(int a, int b) { (void)a; (void)b; }
+    int64_t getCount(void) { return 0; }
+    void clearCount(void) {}
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host build: serial MIDI has no port to read. The renderer posts the file's
+// messages to SignalProcessor directly, so read() never dispatches.
+
+#include <Arduino.h>
+
+#define MIDI_CHANNEL_OMNI 0
+#define MIDI_CHANNEL_OFF 17
+
+class HostMidi {
+public:
+    void begin(int channel = 1) { (void)channel; }
+    bool read(void) { return false; }
+
+    void setHandleNoteOn(void (*handler)(uint8_t, uint8_t, uint8_t)) { (void)handler; }
+    void setHandleNoteOff(void (*handler)(uint8_t, uint8_t, uint8_t)) { (void)handler; }
+    void setHandleControlChange(void (*handler)(uint8_t, uint8_t, uint8_t)) { (void)handler; }
+    void setHandleAfterTouchChannel(void (*handler)(uint8_t, uint8_t)) { (void)handler; }
+    void setHandlePitchBend(void (*handler)(uint8_t, int)) { (void)handler; }
+    void setHandleClock(void (*handler)(void)) { (void)handler; }
+    void setHandleStart(void (*handler)(void)) { (void)handler; }
+    void setHandleStop(void (*handler)(void)) { (void)handler; }
+};
+
+#define MIDI_CREATE_INSTANCE(Type, SerialPort, Name) static HostMidi Name;
@@ -0,0 +1,72 @@
+#pragma once
+
+// Host build: the Mozzi entry points and output types used by SignalProcessor.
+// The MOZZI_* configuration comes from signal_processor.h as on the device;
+// audioHook() in host/mozzi.cpp calls updateControl() and updateAudio().
+
+#include <Arduino.h>
+#include <MozziConfigValues.h>
+
+#ifndef MOZZI_CONTROL_RATE
+#define MOZZI_CONTROL_RATE 64
+#endif
+#ifndef MOZZI_AUDIO_RATE
+#define MOZZI_AUDIO_RATE 32768
+#endif
+#ifndef MOZZI_OUTPUT_BUFFER_SIZE
+#define MOZZI_OUTPUT_BUFFER_SIZE 256
+#endif
+#ifndef MOZZI_AUDIO_BITS
+#define MOZZI_AUDIO_BITS 10 // ESP32 PWM mode
+#endif
+
+#define MOZZI_AUDIO_BIAS ((uint16_t)1 << (MOZZI_AUDIO_BITS - 1))
+#define AUDIO_RATE MOZZI_AUDIO_RATE
+#define MOZZI_AUDIO_RANGE (1 << MOZZI_AUDIO_BITS)
+
+#define MOZZI_SCALE_AUDIO(x, bits) \
+    ((bits) > MOZZI_AUDIO_BITS ? (x) >> ((bits) - MOZZI_AUDIO_BITS) : (x) << (MOZZI_AUDIO_BITS - (bits)))
+
+typedef int32_t AudioOutputStorage_t;
+
+struct StereoOutput {
+    StereoOutput(AudioOutputStorage_t l, AudioOutputStorage_t r) : _l(l), _r(r) {}
+    StereoOutput() : _l(0), _r(0) {}
+
+    AudioOutputStorage_t l() const { return _l; }
+    AudioOutputStorage_t r() const { return _r; }
+
+    StereoOutput& clip() {
+        _l = constrain_audio(_l);
+        _r = constrain_audio(_r);
+        return *this;
+    }
+
+    static StereoOutput fromNBit(uint8_t bits, int32_t l, int32_t r) {
+        return StereoOutput(MOZZI_SCALE_AUDIO(l, bits), MOZZI_SCALE_AUDIO(r, bits));
+    }
+    static StereoOutput from8Bit(int16_t l, int16_t r) { return fromNBit(8, l, r); }
+    static StereoOutput from16Bit(int16_t l, int16_t r) { return fromNBit(16, l, r); }
+
+    AudioOutputStorage_t _l;
+    AudioOutputStorage_t _r;
+
+private:
+    static AudioOutputStorage_t constrain_audio(AudioOutputStorage_t v) {
+        if (v < -(int32_t)MOZZI_AUDIO_BIAS) return -(int32_t)MOZZI_AUDIO_BIAS;
+        if (v > (int32_t)MOZZI_AUDIO_BIAS - 1) return (int32_t)MOZZI_AUDIO_BIAS - 1;
+        return v;
+    }
+};
+
+typedef StereoOutput AudioOutput;
+
+// Provided by the sketch
+void updateControl(void);
+AudioOutput updateAudio(void);
+
+void startMozzi(int control_rate_hz = MOZZI_CONTROL_RATE);
+void stopMozzi(void);
+void audioHook(void);
+unsigned long audioTicks(void);
+unsigned long mozziMicros(void);
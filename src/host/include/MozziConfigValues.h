@@ -0,0 +1,8 @@
+#pragma once
+
+#define MOZZI_OUTPUT_PWM 1
+#define MOZZI_OUTPUT_EXTERNAL_TIMED 2
+#define MOZZI_OUTPUT_EXTERNAL_CUSTOM 3
+
+#define MOZZI_ANALOG_READ_NONE 0
+#define MOZZI_ANALOG_READ_STANDARD 1
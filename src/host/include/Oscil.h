@@ -0,0 +1,45 @@
+#pragma once
+
+// Host build: Mozzi's table oscillator, same phase accumulator layout
+// (16 fractional bits of a table cell) and read order
+
+#include <Mozzi.h>
+#include "mozzi_fixmath.h"
+#include "mozzi_pgmspace.h"
+
+#define OSCIL_F_BITS 16
+
+template <uint16_t NUM_TABLE_CELLS, uint16_t UPDATE_RATE>
+class Oscil {
+    static_assert((NUM_TABLE_CELLS & (NUM_TABLE_CELLS - 1)) == 0, "Oscil table size must be a power of two");
+
+public:
+    Oscil(const int8_t* table_data) : table(table_data), phase_fractional(0), phase_increment_fractional(0) {}
+    Oscil() : table(nullptr), phase_fractional(0), phase_increment_fractional(0) {}
+
+    inline int8_t next(void) {
+        phase_fractional += phase_increment_fractional;
+        return FLASH_OR_RAM_READ<const int8_t>(table + ((phase_fractional >> OSCIL_F_BITS) & (NUM_TABLE_CELLS - 1)));
+    }
+
+    void setTable(const int8_t* table_data) { table = table_data; }
+    void setPhase(unsigned int phase) { phase_fractional = (uint32_t)phase << OSCIL_F_BITS; }
+
+    void setFreq(int frequency) {
+        phase_increment_fractional = (uint32_t)(((uint64_t)frequency * NUM_TABLE_CELLS << OSCIL_F_BITS) / UPDATE_RATE);
+    }
+    void setFreq(float frequency) {
+        phase_increment_fractional = (uint32_t)((frequency * NUM_TABLE_CELLS / UPDATE_RATE) * (1 << OSCIL_F_BITS));
+    }
+    void setFreq_Q16n16(Q16n16 frequency) {
+        phase_increment_fractional = (uint32_t)(((uint64_t)frequency * NUM_TABLE_CELLS) / UPDATE_RATE);
+    }
+    void setFreq_Q24n8(Q24n8 frequency) {
+        phase_increment_fractional = (uint32_t)((((uint64_t)frequency << 8) * NUM_TABLE_CELLS) / UPDATE_RATE);
+    }
+
+private:
+    const int8_t* table;
+    uint32_t phase_fractional;
+    uint32_t phase_increment_fractional;
+};
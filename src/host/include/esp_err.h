@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+
+void host_error_check_failed(esp_err_t err, const char* file, int line, const char* expression);
+
+#define ESP_ERROR_CHECK(x) do {                                       \
+        esp_err_t err_rc_ = (x);                                      \
+        if (err_rc_ != ESP_OK) {                                      \
+            host_error_check_failed(err_rc_, __FILE__, __LINE__, #x); \
+        }                                                             \
+    } while (0)
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Microseconds of simulated time, see host_get_time_us()
+int64_t esp_timer_get_time(void);
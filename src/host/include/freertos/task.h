@@ -0,0 +1,13 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void*);
+typedef void* TaskHandle_t;
+
+// There is no scheduler: the task function runs to completion on the calling
+// thread, so a renderer drives it from inside its loop (see host/mozzi.cpp)
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stack_depth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* created_task,
+                                   BaseType_t core_id);
+void vTaskDelay(TickType_t ticks);
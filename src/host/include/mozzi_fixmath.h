@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef uint8_t Q8n0;
+typedef int32_t Q15n16;
+typedef uint32_t Q16n16;
+typedef uint32_t Q24n8;
+
+#define Q16n16_FIX1 ((Q16n16)65536)
+
+inline Q16n16 Q8n0_to_Q16n16(Q8n0 a) {
+    return ((Q16n16)a) << 16;
+}
+
+inline float Q16n16_to_float(Q16n16 a) {
+    return ((float)a) / 65536.0f;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "mozzi_fixmath.h"
+
+// Note number (Q16n16) to frequency (Q16n16). Computed exactly on the host,
+// Mozzi interpolates a table; the two agree to well under a cent.
+Q16n16 Q16n16_mtof(Q16n16 midival);
+float mtof(float midival);
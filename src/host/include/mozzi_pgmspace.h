@@ -0,0 +1,10 @@
+#pragma once
+
+// Host build: tables are plain const data
+
+#define CONSTTABLE_STORAGE(X) const X
+
+template <typename T>
+inline T FLASH_OR_RAM_READ(T* address) {
+    return *address;
+}
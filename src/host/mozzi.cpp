@@ -0,0 +1,72 @@
+#include "../signal_processor/signal_processor.h"
+#include <Mozzi.h>
+#include <mozzi_midi.h>
+#include "hal.h"
+
+// Mozzi's scheduling without the timer: one audioHook() call is one output
+// sample, with updateControl() every AUDIO_RATE / CONTROL_RATE samples.
+// On the device a sample is computed a full output buffer before it plays, so
+// the clock here runs MOZZI_OUTPUT_BUFFER_SIZE samples behind the audio: pin
+// writes in the trace line up with the WAV as they do at the jacks.
+
+static HostControlHook control_hook = nullptr;
+static HostAudioSink audio_sink = nullptr;
+static uint64_t audio_ticks = 0;
+static int control_period = MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE;
+static int control_counter = 0;
+static bool running = false;
+
+void host_mozzi_set_hooks(HostControlHook control, HostAudioSink sink) {
+    control_hook = control;
+    audio_sink = sink;
+}
+
+void startMozzi(int control_rate_hz) {
+    control_period = MOZZI_AUDIO_RATE / control_rate_hz;
+    control_counter = 0;
+    audio_ticks = 0;
+    running = true;
+}
+
+void stopMozzi(void) {
+    running = false;
+}
+
+void audioHook(void) {
+    if (!running) return;
+
+    uint64_t played = audio_ticks > MOZZI_OUTPUT_BUFFER_SIZE ? audio_ticks - MOZZI_OUTPUT_BUFFER_SIZE : 0;
+    uint64_t now_us = played * 1000000 / MOZZI_AUDIO_RATE;
+    if (control_counter == 0) {
+        host_set_time_us(now_us);
+        if (control_hook != nullptr) control_hook();
+        host_set_time_us(now_us);
+        updateControl();
+        control_counter = control_period;
+    }
+    control_counter--;
+
+    host_set_time_us(now_us);
+    AudioOutput out = updateAudio();
+    out.clip();
+    if (audio_sink != nullptr) {
+        audio_sink(out.l() + MOZZI_AUDIO_BIAS, out.r() + MOZZI_AUDIO_BIAS);
+    }
+    audio_ticks++;
+}
+
+unsigned long audioTicks(void) {
+    return (unsigned long)audio_ticks;
+}
+
+unsigned long mozziMicros(void) {
+    return (unsigned long)(audio_ticks * 1000000 / MOZZI_AUDIO_RATE);
+}
+
+Q16n16 Q16n16_mtof(Q16n16 midival) {
+    return (Q16n16)(mtof(Q16n16_to_float(midival)) * 65536.0f + 0.5f);
+}
+
+float mtof(float midival) {
+    return 440.0f * powf(2.0f, (midival - 69.0f) / 12.0f);
+}
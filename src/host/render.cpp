@@ -0,0 +1,225 @@
+// Offline renderer: plays a Standard MIDI File through SignalProcessor and the
+// osc voice engine on the host and writes the Mozzi stereo output as a WAV
+// file, plus an optional CSV trace of every PWM/GPIO write.
+//
+//   render [options] song.mid out.wav
+//
+// Outputs A and B are routed to the voice engine (mozzi) unless --out says
+// otherwise; all other settings are the firmware defaults.
+//
+// Left out of `pio test`, where every test brings its own main().
+
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include <nvs_flash.h>
+#include <strings.h>
+#include <chrono>
+#include <vector>
+#include "../signal_processor/signal_processor.h"
+#include <Mozzi.h>
+#include "hal.h"
+#include "smf.h"
+
+void osc_init(SignalProcessor* signal_processor);
+
+// Below the per-source input queue size, so a dense tick spills into the next
+// control period instead of overflowing
+static const size_t EVENTS_PER_TICK = 32;
+static const double DEFAULT_TAIL_S = 2.0;
+
+static SignalProcessor* processor = nullptr;
+static std::vector<SmfEvent> events;
+static size_t next_event = 0;
+static uint64_t end_us = 0;
+static std::vector<int16_t> audio;
+
+// Before every updateControl(): queue the file's messages that are due, each
+// received at its own time so sub-block timing sees the real offsets
+static void control_hook(void) {
+    uint64_t now_us = host_get_time_us();
+    size_t posted = 0;
+    while (next_event < events.size() && events[next_event].time_us <= now_us && posted < EVENTS_PER_TICK) {
+        const SmfEvent& e = events[next_event++];
+        uint8_t channel = (e.status & 0x0f) + 1;
+        host_set_time_us(e.time_us);
+
+        switch (e.status & 0xf0) {
+            case 0x80:
+                processor->post_event(MidiInputSerial, EventNoteOff, channel, e.data1, e.data2);
+                break;
+            case 0x90:
+                // Velocity 0 is a note off, as the MIDI library reports it
+                processor->post_event(MidiInputSerial, e.data2 ? EventNoteOn : EventNoteOff, channel, e.data1, e.data2);
+                break;
+            case 0xb0:
+                processor->post_event(MidiInputSerial, EventCc, channel, e.data1, e.data2);
+                break;
+            case 0xd0:
+                processor->post_event(MidiInputSerial, EventAftertouch, channel, 0, e.data1);
+                break;
+            case 0xe0:
+                processor->post_event(MidiInputSerial, EventPitchBend, channel, 0, 0,
+                                      (int16_t)(((e.data2 << 7) | e.data1) - 8192));
+                break;
+            default:
+                break; // polyphonic aftertouch and program change have no route
+        }
+        posted++;
+    }
+
+    if (next_event >= events.size() && now_us >= end_us) {
+        throw HostStop();
+    }
+}
+
+static void audio_sink(int left, int right) {
+    audio.push_back((int16_t)((left - (int)MOZZI_AUDIO_BIAS) << (16 - MOZZI_AUDIO_BITS)));
+    audio.push_back((int16_t)((right - (int)MOZZI_AUDIO_BIAS) << (16 - MOZZI_AUDIO_BITS)));
+}
+
+static void put_u16(FILE* f, uint16_t v) {
+    fputc(v & 0xff, f);
+    fputc(v >> 8, f);
+}
+
+static void put_u32(FILE* f, uint32_t v) {
+    put_u16(f, v & 0xffff);
+    put_u16(f, v >> 16);
+}
+
+static bool write_wav(const char* path, const std::vector<int16_t>& samples, uint32_t rate) {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) return false;
+
+    const uint16_t channels = 2;
+    const uint16_t bits = 16;
+    uint32_t data_size = samples.size() * sizeof(int16_t);
+    fwrite("RIFF", 1, 4, f);
+    put_u32(f, 36 + data_size);
+    fwrite("WAVEfmt ", 1, 8, f);
+    put_u32(f, 16);
+    put_u16(f, 1); // PCM
+    put_u16(f, channels);
+    put_u32(f, rate);
+    put_u32(f, rate * channels * bits / 8);
+    put_u16(f, channels * bits / 8);
+    put_u16(f, bits);
+    fwrite("data", 1, 4, f);
+    put_u32(f, data_size);
+    for (int16_t s : samples) {
+        put_u16(f, (uint16_t)s);
+    }
+    return fclose(f) == 0;
+}
+
+// TYPE as shown on the settings screen ("mozzi", "pitch", "gate", "cc74", ...)
+static bool set_out_type(MidiSettingsState* state, int out, const char* name) {
+    MidiOutType previous = state->get_midi_out_type(out);
+    for (int t = state->get_min_midi_out_type(out); t <= state->get_max_midi_out_type(out); t++) {
+        state->set_midi_out_type(out, (MidiOutType)t);
+        if (strcasecmp(state->get_midi_out_type_str(out), name) == 0) return true;
+    }
+    state->set_midi_out_type(out, previous);
+    return false;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: render [options] song.mid out.wav\n"
+            "  --trace FILE      CSV of every PWM/GPIO write (time_us,kind,pin,value)\n"
+            "  --samples FILE    image for the samples partition (scripts/pack_samples.py)\n"
+            "  --out N=TYPE      output N (0=A 1=B 2=C 3=clk 4=rst) type, as on the settings screen\n"
+            "  --tail SECONDS    keep rendering after the last event (default %.1f)\n",
+            DEFAULT_TAIL_S);
+}
+
+int main(int argc, char** argv) {
+    const char* trace_path = nullptr;
+    const char* samples_path = nullptr;
+    const char* positional[2] = {nullptr, nullptr};
+    int positional_count = 0;
+    double tail_s = DEFAULT_TAIL_S;
+    std::vector<std::pair<int, const char*>> out_types = {{OutChannelA, "mozzi"}, {OutChannelB, "mozzi"}};
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--trace") == 0 && has_value) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && has_value) {
+            samples_path = argv[++i];
+        } else if (strcmp(argv[i], "--tail") == 0 && has_value) {
+            tail_s = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && has_value) {
+            const char* spec = argv[++i];
+            const char* eq = strchr(spec, '=');
+            int out = atoi(spec);
+            if (eq == nullptr || out < 0 || out >= OutChannelCount) {
+                usage();
+                return 2;
+            }
+            out_types.push_back({out, eq + 1});
+        } else if (argv[i][0] != '-' && positional_count < 2) {
+            positional[positional_count++] = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (positional_count != 2) {
+        usage();
+        return 2;
+    }
+
+    if (!smf_load(positional[0], &events)) return 1;
+    if (samples_path != nullptr && !host_load_partition("samples", samples_path)) {
+        fprintf(stderr, "render: cannot read %s\n", samples_path);
+        return 1;
+    }
+    if (trace_path != nullptr && !host_trace_open(trace_path)) {
+        fprintf(stderr, "render: cannot write %s\n", trace_path);
+        return 1;
+    }
+    end_us = (events.empty() ? 0 : events.back().time_us) + (uint64_t)(tail_s * 1000000);
+
+    ESP_ERROR_CHECK(nvs_flash_init());
+
+    MidiSettingsState state;
+    state.begin();
+    for (const auto& out : out_types) {
+        if (!set_out_type(&state, out.first, out.second)) {
+            fprintf(stderr, "render: output %d cannot be %s\n", out.first, out.second);
+            return 2;
+        }
+    }
+
+    SignalProcessor signal_processor(&state);
+    processor = &signal_processor;
+    osc_init(&signal_processor);
+    host_mozzi_set_hooks(control_hook, audio_sink);
+    audio.reserve((size_t)(end_us * MOZZI_AUDIO_RATE / 1000000 + 1) * 2);
+
+    // begin() runs the audio task in place until control_hook() stops it
+    auto start = std::chrono::steady_clock::now();
+    try {
+        signal_processor.begin();
+    } catch (const HostStop&) {
+    }
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    host_trace_close();
+
+    if (!write_wav(positional[1], audio, MOZZI_AUDIO_RATE)) {
+        fprintf(stderr, "render: cannot write %s\n", positional[1]);
+        return 1;
+    }
+
+    size_t frames = audio.size() / 2;
+    double audio_s = (double)frames / MOZZI_AUDIO_RATE;
+    printf("render: %zu events, %zu samples (%.2f s) in %.3f s: %.0f samples/s, %.1fx real time\n",
+           events.size(), frames, audio_s, wall_s, frames / wall_s, audio_s / wall_s);
+    printf("render: %u pin writes, %u serial queue overflows\n",
+           host_get_trace_count(), signal_processor.get_overflow_count(MidiInputSerial));
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
@@ -0,0 +1,219 @@
+#include "smf.h"
+#include <stdio.h>
+#include <algorithm>
+
+static const uint32_t DEFAULT_TEMPO_US = 500000; // 120 BPM
+
+struct SmfTickEvent {
+    uint64_t tick;
+    uint32_t order; // file order, keeps the sort stable across tracks
+    bool tempo;
+    uint32_t tempo_us; // microseconds per quarter note when tempo is set
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+class SmfReader {
+public:
+    SmfReader(const std::vector<uint8_t>& data, size_t pos, size_t end) : data(data), pos(pos), end(end) {}
+
+    bool at_end(void) const { return pos >= end; }
+    bool has(size_t n) const { return pos + n <= end; }
+
+    uint8_t peek(void) const { return data[pos]; }
+    uint8_t u8(void) { return data[pos++]; }
+
+    uint32_t var_len(bool* ok) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            if (!has(1)) break;
+            uint8_t b = u8();
+            value = (value << 7) | (b & 0x7f);
+            if (!(b & 0x80)) return value;
+        }
+        *ok = false;
+        return 0;
+    }
+
+    bool skip(size_t n) {
+        if (!has(n)) return false;
+        pos += n;
+        return true;
+    }
+
+    size_t get_pos(void) const { return pos; }
+
+private:
+    const std::vector<uint8_t>& data;
+    size_t pos;
+    size_t end;
+};
+
+static uint32_t be32(const std::vector<uint8_t>& d, size_t pos) {
+    return ((uint32_t)d[pos] << 24) | ((uint32_t)d[pos + 1] << 16) | ((uint32_t)d[pos + 2] << 8) | d[pos + 3];
+}
+
+static uint16_t be16(const std::vector<uint8_t>& d, size_t pos) {
+    return (uint16_t)((d[pos] << 8) | d[pos + 1]);
+}
+
+static int data_bytes(uint8_t status) {
+    switch (status & 0xf0) {
+        case 0xc0: // program change
+        case 0xd0: // channel aftertouch
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+static bool read_track(SmfReader* r, int track, std::vector<SmfTickEvent>* out, uint32_t* order) {
+    uint64_t tick = 0;
+    uint8_t running_status = 0;
+
+    while (!r->at_end()) {
+        bool ok = true;
+        tick += r->var_len(&ok);
+        if (!ok || !r->has(1)) break;
+
+        uint8_t status = r->peek();
+        if (status == 0xff) {
+            r->u8();
+            if (!r->has(1)) break;
+            uint8_t type = r->u8();
+            uint32_t len = r->var_len(&ok);
+            if (!ok || !r->has(len)) break;
+            if (type == 0x2f) return true; // end of track
+            if (type == 0x51 && len == 3) {
+                SmfTickEvent e = {};
+                e.tick = tick;
+                e.order = (*order)++;
+                e.tempo = true;
+                e.tempo_us = ((uint32_t)r->u8() << 16);
+                e.tempo_us |= ((uint32_t)r->u8() << 8);
+                e.tempo_us |= r->u8();
+                out->push_back(e);
+            } else {
+                r->skip(len);
+            }
+            running_status = 0;
+            continue;
+        }
+        if (status == 0xf0 || status == 0xf7) {
+            r->u8();
+            uint32_t len = r->var_len(&ok);
+            if (!ok || !r->skip(len)) break;
+            running_status = 0;
+            continue;
+        }
+
+        if (status & 0x80) {
+            r->u8();
+            running_status = status;
+        } else if (running_status == 0) {
+            fprintf(stderr, "smf: track %d: data byte without status at offset %zu\n", track, r->get_pos());
+            return false;
+        } else {
+            status = running_status;
+        }
+
+        int n = data_bytes(status);
+        if (!r->has(n)) break;
+        SmfTickEvent e = {};
+        e.tick = tick;
+        e.order = (*order)++;
+        e.status = status;
+        e.data1 = r->u8() & 0x7f;
+        e.data2 = n > 1 ? (r->u8() & 0x7f) : 0;
+        out->push_back(e);
+    }
+
+    fprintf(stderr, "smf: track %d is truncated\n", track);
+    return false;
+}
+
+bool smf_load(const char* path, std::vector<SmfEvent>* events) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) {
+        fprintf(stderr, "smf: cannot open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    if (data.size() < 14 || be32(data, 0) != 0x4d546864 || be32(data, 4) < 6) { // "MThd"
+        fprintf(stderr, "smf: %s is not a MIDI file\n", path);
+        return false;
+    }
+    uint16_t format = be16(data, 8);
+    uint16_t track_count = be16(data, 10);
+    uint16_t division = be16(data, 12);
+    if (format > 1) {
+        fprintf(stderr, "smf: format %u is not supported\n", format);
+        return false;
+    }
+
+    // Microseconds per tick: tempo / PPQ, or fixed for SMPTE time
+    bool smpte = division & 0x8000;
+    uint32_t ticks_per_quarter = division & 0x7fff;
+    uint32_t ticks_per_second = 0;
+    if (smpte) {
+        int fps = -(int8_t)(division >> 8);
+        ticks_per_second = (uint32_t)fps * (division & 0xff);
+    }
+    if ((!smpte && ticks_per_quarter == 0) || (smpte && ticks_per_second == 0)) {
+        fprintf(stderr, "smf: bad time division 0x%04x\n", division);
+        return false;
+    }
+
+    std::vector<SmfTickEvent> tick_events;
+    uint32_t order = 0;
+    size_t pos = 8 + be32(data, 4);
+    for (int track = 0; track < track_count; track++) {
+        if (pos + 8 > data.size()) {
+            fprintf(stderr, "smf: %d of %u tracks present\n", track, track_count);
+            return false;
+        }
+        uint32_t len = be32(data, pos + 4);
+        if (be32(data, pos) != 0x4d54726b || pos + 8 + len > data.size()) { // "MTrk"
+            fprintf(stderr, "smf: bad track %d header\n", track);
+            return false;
+        }
+        SmfReader reader(data, pos + 8, pos + 8 + len);
+        if (!read_track(&reader, track, &tick_events, &order)) return false;
+        pos += 8 + len;
+    }
+
+    std::sort(tick_events.begin(), tick_events.end(), [](const SmfTickEvent& a, const SmfTickEvent& b) {
+        return a.tick != b.tick ? a.tick < b.tick : a.order < b.order;
+    });
+
+    // Walk the tempo map, time accumulated per tempo segment
+    uint64_t segment_tick = 0;
+    uint64_t segment_us = 0;
+    uint32_t tempo_us = DEFAULT_TEMPO_US;
+    events->clear();
+    for (const SmfTickEvent& e : tick_events) {
+        uint64_t time_us;
+        if (smpte) {
+            time_us = e.tick * 1000000 / ticks_per_second;
+        } else {
+            time_us = segment_us + (e.tick - segment_tick) * tempo_us / ticks_per_quarter;
+        }
+
+        if (e.tempo) {
+            segment_tick = e.tick;
+            segment_us = time_us;
+            tempo_us = e.tempo_us;
+            continue;
+        }
+        events->push_back(SmfEvent{time_us, e.status, e.data1, e.data2});
+    }
+    return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+// Channel message of a Standard MIDI File at its absolute time
+struct SmfEvent {
+    uint64_t time_us;
+    uint8_t status; // 0x80 .. 0xef, channel in the low nibble
+    uint8_t data1;
+    uint8_t data2;
+};
+
+// Read a format 0 or 1 file. Tracks are merged and ticks converted to time
+// through the tempo map; meta and sysex events are dropped. Events keep file
+// order within a tick. Prints the reason to stderr on failure.
+bool smf_load(const char* path, std::vector<SmfEvent>* events);
@@ -10,6 +10,8 @@
 #include "board.h"
 #include "input/input.h"
 #include "oscilloscope/oscilloscope.h"
+#include "oscilloscope/spectrum.h"
+#include "oscilloscope/tuner.h"
 #include "midi/midi.h"
 #include "midi/midi_settings_state.h"
 #include "midi/ble_midi.h"
@@ -17,6 +19,7 @@
 #include "signal_processor/signal_processor.h"
 #include "screen_switcher.h"
 #include "testmode.h"
+#include "calibration/calibration_mode.h"
 
 // Create display object
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
@@ -31,9 +34,11 @@ SignalProcessor signal_processor(&midi_settings_state);
 // Create screen objects
 OscilloscopeRoot oscilloscope_screen(&display);
 MidiRoot midi_screen(&display, &midi_settings_state, &signal_processor);
+SpectrumRoot spectrum_screen(&display, &oscilloscope_screen);
+TunerRoot tuner_screen(&display, &oscilloscope_screen);
 
 // Create screen array and switcher
-ScreenInterface* screens[] = {&oscilloscope_screen, &midi_screen};
+ScreenInterface* screens[] = {&oscilloscope_screen, &midi_screen, &spectrum_screen, &tuner_screen};
 const size_t screen_count = sizeof(screens) / sizeof(screens[0]);
 ScreenSwitcher screen_switcher(screens, screen_count);
 
@@ -111,6 +116,16 @@ void setup() {
         Serial.printf("testmode: failed to open NVS namespace, err=0x%x\n", err);
     }
 
+    // Hold the encoder switch during boot to enter output calibration
+    if (digitalRead(ENCODER_SW) == LOW) {
+        Serial.println("Entering calibration mode");
+        // Wait for release so the boot press does not confirm the first step
+        while (digitalRead(ENCODER_SW) == LOW) {
+            delay(10);
+        }
+        calibration_mode(&display, &input_handler, &signal_processor);
+    }
+
     // Initialize NeoPixel
     pixels.begin();
     pixels.setBrightness(20);
@@ -136,7 +151,7 @@ void loop() {
     // Handle screen switching with a state machine approach
     if (event.button_a == ButtonRelease) {
         screen_switched = false;
-    } else if (event.button_a == ButtonHold && event.button_a_ms > 400 && !screen_switched) {
+    } else if (event.button_a == ButtonHold && event.button_a_ms > ScreenSwitcher::SWITCH_HOLD_MS && !screen_switched) {
         // Switch screen only if the button was released before and hasn't switched screens in this hold session
         screen_switcher.set_screen(screen_switcher.get_next());
         screen_switched = true;
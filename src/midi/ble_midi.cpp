@@ -115,7 +115,7 @@ void BleMidi::onNoteOn(uint8_t channel, uint8_t note, uint8_t velocity, uint16_t
 
     log_ble_channel_event("NoteOn", channel, processor_channel, note, velocity, timestamp, ready);
     if (!ready) return;
-    s_processor->handle_note_on(processor_channel, note, velocity);
+    s_processor->post_event(MidiInputBluetooth, EventNoteOn, processor_channel, note, velocity);
 }
 
 void BleMidi::onNoteOff(uint8_t channel, uint8_t note, uint8_t velocity, uint16_t timestamp) {
@@ -124,7 +124,7 @@ void BleMidi::onNoteOff(uint8_t channel, uint8_t note, uint8_t velocity, uint16_
 
     log_ble_channel_event("NoteOff", channel, processor_channel, note, velocity, timestamp, ready);
     if (!ready) return;
-    s_processor->handle_note_off(processor_channel, note, velocity);
+    s_processor->post_event(MidiInputBluetooth, EventNoteOff, processor_channel, note, velocity);
 }
 
 void BleMidi::onControlChange(uint8_t channel, uint8_t controller, uint8_t value, uint16_t timestamp) {
@@ -133,26 +133,26 @@ void BleMidi::onControlChange(uint8_t channel, uint8_t controller, uint8_t value
 
     log_ble_channel_event("ControlChange", channel, processor_channel, controller, value, timestamp, ready);
     if (!ready) return;
-    s_processor->handle_cc(processor_channel, controller, value);
+    s_processor->post_event(MidiInputBluetooth, EventCc, processor_channel, controller, value);
 }
 
 void BleMidi::onClock() {
     bool ready = s_ble_midi && s_ble_midi->enabled && s_processor;
     log_ble_system_event("Clock", ready);
     if (!ready) return;
-    s_processor->handle_clock();
+    s_processor->post_event(MidiInputBluetooth, EventClock);
 }
 
 void BleMidi::onStart() {
     bool ready = s_ble_midi && s_ble_midi->enabled && s_processor;
     log_ble_system_event("Start", ready);
     if (!ready) return;
-    s_processor->handle_start();
+    s_processor->post_event(MidiInputBluetooth, EventStart);
 }
 
 void BleMidi::onStop() {
     bool ready = s_ble_midi && s_ble_midi->enabled && s_processor;
     log_ble_system_event("Stop", ready);
     if (!ready) return;
-    s_processor->handle_stop();
+    s_processor->post_event(MidiInputBluetooth, EventStop);
 }
@@ -47,11 +47,23 @@ void MidiInfo::render()
         display->drawBitmap(SCREEN_WIDTH - 16, 0, BLUETOOTH_ICON, 16, 16, SSD1306_WHITE);
     }
 
-    sprintf(buffer, "Ch: %s  Clk: %s",
+    bool ext_clock = state->get_midi_clk_type() == MidiClkExt;
+    sprintf(buffer, "Ch: %s  Clk: %s%s",
             state->get_midi_channel_str(),
-            state->get_midi_clk_type_str());
+            state->get_midi_clk_type_str(),
+            ext_clock && !processor->is_clock_locked() ? "?" : "");
     display->println(buffer);
-    display->print("         ");
+
+    // External clock jitter in place of the padding before the CLK/RST indicators
+    if (ext_clock && processor->is_clock_locked()) {
+        unsigned long jitter_us = processor->get_clock_jitter_us();
+        char jitter[12];
+        snprintf(jitter, sizeof(jitter), "j%lu.%lums", jitter_us / 1000, (jitter_us / 100) % 10);
+        sprintf(buffer, "%-9s", jitter);
+        display->print(buffer);
+    } else {
+        display->print("         ");
+    }
     display->print(processor->last_out[OutChannelClk] > 0 ? "[CLK]" : " CLK ");
     display->print(" ");
     display->println(processor->last_out[OutChannelRst] > 0 ? "[RST]" : " RST ");
@@ -73,9 +85,10 @@ void MidiInfo::handle_input(Event *event)
 
     if (event->encoder != 0)
     {
-        state->set_bpm(clampi(state->get_bpm() + event->encoder,
-                              state->get_min_bpm(),
-                              state->get_max_bpm()));
+        // Whole-BPM steps, keeping any fractional part (e.g. measured from external clock)
+        state->set_bpm_x10(clampi(state->get_bpm_x10() + event->encoder * 10,
+                                  state->get_min_bpm_x10(),
+                                  state->get_max_bpm_x10()));
         state->store(); // TODO: delay before storing for saving FLASH
     }
 
@@ -99,6 +99,10 @@ void MidiSettings::render_menu() {
                         display->print(state->get_midi_channel_str());
                     } else if (row.menu_index == MENU_CLOCK) {
                         display->print(state->get_midi_clk_type_str());
+                    } else if (row.menu_index == MENU_POLY) {
+                        display->print(state->get_poly_mode_str());
+                    } else if (row.menu_index == MENU_SETTLE) {
+                        display->print(state->get_gate_settle_str());
                     }
                 } else {
                     display->setTextColor(SSD1306_WHITE, SSD1306_BLACK);
@@ -112,7 +116,11 @@ void MidiSettings::render_menu() {
                         display->setTextColor(SSD1306_WHITE, SSD1306_BLACK);
                     }
                     display->setCursor(COL2_X, y + 1);
-                    display->print(state->get_midi_out_type_str(item.data.output_idx));
+                    if (is_priority_item(row.menu_index)) {
+                        display->print(state->get_note_priority_str(item.data.output_idx));
+                    } else {
+                        display->print(state->get_midi_out_type_str(item.data.output_idx));
+                    }
 
                     if (channel_selected && is_editing) {
                         display->setTextColor(SSD1306_BLACK, SSD1306_WHITE);
@@ -120,7 +128,11 @@ void MidiSettings::render_menu() {
                         display->setTextColor(SSD1306_WHITE, SSD1306_BLACK);
                     }
                     display->setCursor(COL3_X, y + 1);
-                    display->print(state->get_midi_out_channel_str(item.data.output_idx));
+                    if (is_priority_item(row.menu_index)) {
+                        display->print(state->get_gate_mode_str(item.data.output_idx));
+                    } else {
+                        display->print(state->get_midi_out_channel_str(item.data.output_idx));
+                    }
                 }
                 break;
             }
@@ -218,9 +230,30 @@ void MidiSettings::handle_menu_input(Event* event) {
                                                                        state->get_min_midi_clk_type(),
                                                                        state->get_max_midi_clk_type()));
                             break;
+                        case MENU_POLY:
+                            state->set_poly_mode((PolyMode)clampi(state->get_poly_mode() + event->encoder,
+                                                                 state->get_min_poly_mode(),
+                                                                 state->get_max_poly_mode()));
+                            break;
+                        case MENU_SETTLE:
+                            state->set_gate_settle_us(clampi(state->get_gate_settle_us() + event->encoder * MidiSettingsState::GATE_SETTLE_STEP_US,
+                                                             state->get_min_gate_settle_us(),
+                                                             state->get_max_gate_settle_us()));
+                            break;
                         default:
                             break;
                     }
+                } else if (is_priority_item(current_item)) {
+                    int idx = item.data.output_idx;
+                    if (row_number == 1) {
+                        state->set_gate_mode(idx, (GateMode)clampi(state->get_gate_mode(idx) + event->encoder,
+                                                                 state->get_min_gate_mode(),
+                                                                 state->get_max_gate_mode()));
+                    } else {
+                        state->set_note_priority(idx, (NotePriority)clampi(state->get_note_priority(idx) + event->encoder,
+                                                                         state->get_min_note_priority(),
+                                                                         state->get_max_note_priority()));
+                    }
                 } else {
                     int idx = item.data.output_idx;
                     if (row_number == 1) {
@@ -304,7 +337,8 @@ void MidiSettings::handle_menu_input(Event* event) {
         current_item = (MenuItems)rows[selected_row].menu_index;
     }
 
-    if(is_editing && rows[selected_row].type == RowMenu &&
+    // CC / pitchbend learn only applies to output type rows
+    if(is_editing && rows[selected_row].type == RowMenu && is_output_item(current_item) &&
        (processor->last_cc[current_item] != 0 || processor->pitchbend[current_item] != 0)) {
         const MenuItemInfo& item = items[current_item];
         int idx = item.data.output_idx;
@@ -27,7 +27,14 @@ private:
         MENU_OUT_C,
         MENU_CLOCK_OUT,
         MENU_RESET_OUT,
+        MENU_PRIO_A,
+        MENU_PRIO_B,
+        MENU_PRIO_C,
+        MENU_PRIO_CLOCK_OUT,
+        MENU_PRIO_RESET_OUT,
         MENU_CLOCK,
+        MENU_POLY,
+        MENU_SETTLE,
         MENU_COUNT
     };
 
@@ -57,7 +64,15 @@ private:
         {" C", ChannelItem, {.output_idx = 2}},
         {"CLK", ChannelItem, {.output_idx = 3}},
         {"RST", ChannelItem, {.output_idx = 4}},
-        {"Clock", SingleItem, {.unused = nullptr}}
+        // Note priority and gate mode per output
+        {"pA", ChannelItem, {.output_idx = 0}},
+        {"pB", ChannelItem, {.output_idx = 1}},
+        {"pC", ChannelItem, {.output_idx = 2}},
+        {"pCLK", ChannelItem, {.output_idx = 3}},
+        {"pRST", ChannelItem, {.output_idx = 4}},
+        {"Clock", SingleItem, {.unused = nullptr}},
+        {"Poly", SingleItem, {.unused = nullptr}},
+        {"Settle", SingleItem, {.unused = nullptr}}
     };
 
     static constexpr int ROW_COUNT = MENU_COUNT + 2; // add bluetooth toggle + status rows
@@ -68,7 +83,14 @@ private:
         {RowMenu, MENU_OUT_C},
         {RowMenu, MENU_CLOCK_OUT},
         {RowMenu, MENU_RESET_OUT},
+        {RowMenu, MENU_PRIO_A},
+        {RowMenu, MENU_PRIO_B},
+        {RowMenu, MENU_PRIO_C},
+        {RowMenu, MENU_PRIO_CLOCK_OUT},
+        {RowMenu, MENU_PRIO_RESET_OUT},
         {RowMenu, MENU_CLOCK},
+        {RowMenu, MENU_POLY},
+        {RowMenu, MENU_SETTLE},
         {RowBluetoothToggle, -1},
         {RowBluetoothStatus, -1}
     };
@@ -98,4 +120,7 @@ private:
     void render_menu(void);
     void handle_input(Event* event);
     void handle_menu_input(Event* event);
+
+    static bool is_output_item(int menu_index) { return menu_index >= MENU_OUT_A && menu_index <= MENU_RESET_OUT; }
+    static bool is_priority_item(int menu_index) { return menu_index >= MENU_PRIO_A && menu_index <= MENU_PRIO_RESET_OUT; }
 };
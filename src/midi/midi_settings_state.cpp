@@ -8,6 +8,7 @@
 MidiSettingsState::MidiSettingsState(void) {
     // Initialize mutex to nullptr
     state_mutex = nullptr;
+    revision = 0;
 }
 
 MidiSettingsState::~MidiSettingsState(void) {
@@ -37,9 +38,9 @@ esp_err_t MidiSettingsState::store_nvs(void) {
         return err;
     }
 
-    err = nvs_set_u32(nvs_handle, "bpm", (uint32_t)bpm);
+    err = nvs_set_u32(nvs_handle, "bpm_x10", (uint32_t)bpm_x10);
     if (err != ESP_OK) {
-        Serial.printf("store_nvs: failed to set bpm, err=0x%x\n", err);
+        Serial.printf("store_nvs: failed to set bpm_x10, err=0x%x\n", err);
         nvs_close(nvs_handle);
         return err;
     }
@@ -53,7 +54,7 @@ esp_err_t MidiSettingsState::store_nvs(void) {
 
     for (size_t i = 0; i < OutChannelCount; i++) {
         char key[10];
-        snprintf(key, sizeof(key), "out_t%zu", i);
+        snprintf(key, sizeof(key), "out_type%zu", i);
         err = nvs_set_u32(nvs_handle, key, (uint32_t)midi_out_type[i]);
         if (err != ESP_OK) {
             Serial.printf("store_nvs: failed to set %s, err=0x%x\n", key, err);
@@ -73,6 +74,28 @@ esp_err_t MidiSettingsState::store_nvs(void) {
         }
     }
 
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        char key[10];
+        snprintf(key, sizeof(key), "out_p%zu", i);
+        err = nvs_set_u32(nvs_handle, key, (uint32_t)note_priority[i]);
+        if (err != ESP_OK) {
+            Serial.printf("store_nvs: failed to set %s, err=0x%x\n", key, err);
+            nvs_close(nvs_handle);
+            return err;
+        }
+    }
+
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        char key[10];
+        snprintf(key, sizeof(key), "out_g%zu", i);
+        err = nvs_set_u32(nvs_handle, key, (uint32_t)gate_mode[i]);
+        if (err != ESP_OK) {
+            Serial.printf("store_nvs: failed to set %s, err=0x%x\n", key, err);
+            nvs_close(nvs_handle);
+            return err;
+        }
+    }
+
     err = nvs_set_u32(nvs_handle, "midi_clk_type", (uint32_t)midi_clk_type);
     if (err != ESP_OK) {
         Serial.printf("store_nvs: failed to set midi_clk_type, err=0x%x\n", err);
@@ -80,6 +103,20 @@ esp_err_t MidiSettingsState::store_nvs(void) {
         return err;
     }
 
+    err = nvs_set_u32(nvs_handle, "poly_mode", (uint32_t)poly_mode);
+    if (err != ESP_OK) {
+        Serial.printf("store_nvs: failed to set poly_mode, err=0x%x\n", err);
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    err = nvs_set_u32(nvs_handle, "settle_us", (uint32_t)gate_settle_us);
+    if (err != ESP_OK) {
+        Serial.printf("store_nvs: failed to set settle_us, err=0x%x\n", err);
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     err = nvs_set_u8(nvs_handle, "bt_enabled", (uint8_t)bluetooth_enabled);
     if (err != ESP_OK) {
         Serial.printf("store_nvs: failed to set bt_enabled, err=0x%x\n", err);
@@ -101,10 +138,14 @@ esp_err_t MidiSettingsState::store_nvs(void) {
 void MidiSettingsState::recall(void) {
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
         esp_err_t err = recall_nvs();
-        if (err != ESP_OK) {
+        if (err == ESP_ERR_NVS_NOT_FOUND) {
+            // Some keys are missing (e.g. added by a firmware update), keep the values read so far
+            store_nvs();
+        } else if (err != ESP_OK) {
             set_default();
             store_nvs();
         }
+        revision++;
         xSemaphoreGive(state_mutex);
     }
 }
@@ -123,13 +164,17 @@ esp_err_t MidiSettingsState::recall_nvs(void) {
     bool needs_save = false;
 
     uint32_t bpm_val;
-    err = nvs_get_u32(nvs_handle, "bpm", &bpm_val);
+    err = nvs_get_u32(nvs_handle, "bpm_x10", &bpm_val);
     if (err == ESP_OK) {
-        bpm = (int)bpm_val;
+        bpm_x10 = (int)bpm_val;
     } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        // Fall back to whole BPM stored by older firmware
+        if (nvs_get_u32(nvs_handle, "bpm", &bpm_val) == ESP_OK) {
+            bpm_x10 = (int)bpm_val * 10;
+        }
         needs_save = true;
     } else {
-        Serial.printf("recall_nvs: failed to get bpm, err=0x%x\n", err);
+        Serial.printf("recall_nvs: failed to get bpm_x10, err=0x%x\n", err);
         nvs_close(nvs_handle);
         return err;
     }
@@ -148,12 +193,21 @@ esp_err_t MidiSettingsState::recall_nvs(void) {
 
     for (size_t i = 0; i < OutChannelCount; i++) {
         char key[10];
-        snprintf(key, sizeof(key), "out_t%zu", i);
+        snprintf(key, sizeof(key), "out_type%zu", i);
         uint32_t type_val;
         err = nvs_get_u32(nvs_handle, key, &type_val);
         if (err == ESP_OK) {
             midi_out_type[i] = (MidiOutType)type_val;
         } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+            // Fall back to the numbering stored by older firmware, before the 48/96 ppq clocks
+            char old_key[10];
+            snprintf(old_key, sizeof(old_key), "out_t%zu", i);
+            if (nvs_get_u32(nvs_handle, old_key, &type_val) == ESP_OK) {
+                if (type_val > MidiOutClock1_16T) {
+                    type_val += MidiOutRun - (MidiOutClock1_16T + 1);
+                }
+                midi_out_type[i] = (MidiOutType)type_val;
+            }
             needs_save = true;
         } else {
             Serial.printf("recall_nvs: failed to get %s, err=0x%x\n", key, err);
@@ -178,6 +232,38 @@ esp_err_t MidiSettingsState::recall_nvs(void) {
         }
     }
 
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        char key[10];
+        snprintf(key, sizeof(key), "out_p%zu", i);
+        uint32_t priority_val;
+        err = nvs_get_u32(nvs_handle, key, &priority_val);
+        if (err == ESP_OK) {
+            note_priority[i] = (NotePriority)priority_val;
+        } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+            needs_save = true;
+        } else {
+            Serial.printf("recall_nvs: failed to get %s, err=0x%x\n", key, err);
+            nvs_close(nvs_handle);
+            return err;
+        }
+    }
+
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        char key[10];
+        snprintf(key, sizeof(key), "out_g%zu", i);
+        uint32_t gate_val;
+        err = nvs_get_u32(nvs_handle, key, &gate_val);
+        if (err == ESP_OK) {
+            gate_mode[i] = (GateMode)gate_val;
+        } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+            needs_save = true;
+        } else {
+            Serial.printf("recall_nvs: failed to get %s, err=0x%x\n", key, err);
+            nvs_close(nvs_handle);
+            return err;
+        }
+    }
+
     uint32_t clk_val;
     err = nvs_get_u32(nvs_handle, "midi_clk_type", &clk_val);
     if (err == ESP_OK) {
@@ -190,6 +276,30 @@ esp_err_t MidiSettingsState::recall_nvs(void) {
         return err;
     }
 
+    uint32_t poly_val;
+    err = nvs_get_u32(nvs_handle, "poly_mode", &poly_val);
+    if (err == ESP_OK) {
+        poly_mode = (PolyMode)poly_val;
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        needs_save = true;
+    } else {
+        Serial.printf("recall_nvs: failed to get poly_mode, err=0x%x\n", err);
+        nvs_close(nvs_handle);
+        return err;
+    }
+
+    uint32_t settle_val;
+    err = nvs_get_u32(nvs_handle, "settle_us", &settle_val);
+    if (err == ESP_OK) {
+        gate_settle_us = (int)settle_val;
+    } else if (err == ESP_ERR_NVS_NOT_FOUND) {
+        needs_save = true;
+    } else {
+        Serial.printf("recall_nvs: failed to get settle_us, err=0x%x\n", err);
+        nvs_close(nvs_handle);
+        return err;
+    }
+
     uint8_t bt_val;
     err = nvs_get_u8(nvs_handle, "bt_enabled", &bt_val);
     if (err == ESP_OK) {
@@ -213,8 +323,12 @@ esp_err_t MidiSettingsState::recall_nvs(void) {
 }
 
 void MidiSettingsState::set_bpm(int bpm) {
+    set_bpm_x10(bpm * 10);
+}
+
+void MidiSettingsState::set_bpm_x10(int bpm_x10) {
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
-        this->bpm = bpm;
+        this->bpm_x10 = bpm_x10;
         xSemaphoreGive(state_mutex);
     }
 }
@@ -222,6 +336,7 @@ void MidiSettingsState::set_bpm(int bpm) {
 void MidiSettingsState::set_midi_channel(MidiChannel ch) {
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
         this->midi_channel = ch;
+        revision++;
         xSemaphoreGive(state_mutex);
     }
 }
@@ -230,6 +345,7 @@ void MidiSettingsState::set_midi_out_type(size_t idx, MidiOutType type) {
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
         if (idx < OutChannelCount) {
             this->midi_out_type[idx] = type;
+            revision++;
         }
         xSemaphoreGive(state_mutex);
     }
@@ -239,6 +355,27 @@ void MidiSettingsState::set_midi_out_channel(size_t idx, MidiChannel ch) {
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
         if (idx < OutChannelCount) {
             this->midi_out_channel[idx] = ch;
+            revision++;
+        }
+        xSemaphoreGive(state_mutex);
+    }
+}
+
+void MidiSettingsState::set_note_priority(size_t idx, NotePriority priority) {
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        if (idx < OutChannelCount) {
+            this->note_priority[idx] = priority;
+            revision++;
+        }
+        xSemaphoreGive(state_mutex);
+    }
+}
+
+void MidiSettingsState::set_gate_mode(size_t idx, GateMode mode) {
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        if (idx < OutChannelCount) {
+            this->gate_mode[idx] = mode;
+            revision++;
         }
         xSemaphoreGive(state_mutex);
     }
@@ -251,10 +388,32 @@ void MidiSettingsState::set_midi_clk_type(MidiClkType type) {
     }
 }
 
+void MidiSettingsState::set_poly_mode(PolyMode mode) {
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        this->poly_mode = mode;
+        revision++;
+        xSemaphoreGive(state_mutex);
+    }
+}
+
+void MidiSettingsState::set_gate_settle_us(int us) {
+    if (us < MIN_GATE_SETTLE_US) us = MIN_GATE_SETTLE_US;
+    if (us > MAX_GATE_SETTLE_US) us = MAX_GATE_SETTLE_US;
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        this->gate_settle_us = us;
+        revision++;
+        xSemaphoreGive(state_mutex);
+    }
+}
+
 int MidiSettingsState::get_bpm(void) {
+    return (get_bpm_x10() + 5) / 10;
+}
+
+int MidiSettingsState::get_bpm_x10(void) {
     int result = 0;
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
-        result = this->bpm;
+        result = this->bpm_x10;
         xSemaphoreGive(state_mutex);
     }
     return result;
@@ -291,6 +450,28 @@ MidiChannel MidiSettingsState::get_midi_out_channel(size_t idx) {
     return result;
 }
 
+NotePriority MidiSettingsState::get_note_priority(size_t idx) {
+    NotePriority result = NotePriorityLast;
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        if (idx < OutChannelCount) {
+            result = this->note_priority[idx];
+        }
+        xSemaphoreGive(state_mutex);
+    }
+    return result;
+}
+
+GateMode MidiSettingsState::get_gate_mode(size_t idx) {
+    GateMode result = GateLegato;
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        if (idx < OutChannelCount) {
+            result = this->gate_mode[idx];
+        }
+        xSemaphoreGive(state_mutex);
+    }
+    return result;
+}
+
 MidiClkType MidiSettingsState::get_midi_clk_type(void) {
     MidiClkType result = MidiClkInt;
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
@@ -300,10 +481,48 @@ MidiClkType MidiSettingsState::get_midi_clk_type(void) {
     return result;
 }
 
+PolyMode MidiSettingsState::get_poly_mode(void) {
+    PolyMode result = PolyOff;
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        result = this->poly_mode;
+        xSemaphoreGive(state_mutex);
+    }
+    return result;
+}
+
+int MidiSettingsState::get_gate_settle_us(void) {
+    int result = 0;
+    if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
+        result = this->gate_settle_us;
+        xSemaphoreGive(state_mutex);
+    }
+    return result;
+}
+
+const char* MidiSettingsState::get_gate_settle_str(void) {
+    static char settle_str[16];
+    int us = get_gate_settle_us();
+    if (us == 0) {
+        snprintf(settle_str, sizeof(settle_str), "off");
+    } else {
+        snprintf(settle_str, sizeof(settle_str), "%d.%dms", us / 1000, (us % 1000) / 100);
+    }
+    return settle_str;
+}
+
+const char* MidiSettingsState::get_poly_mode_str(void) {
+    PolyMode mode = get_poly_mode();
+    return poly_mode_to_string(mode);
+}
+
 const char* MidiSettingsState::get_bpm_str(void) {
-    static char bpm_str[10];
+    static char bpm_str[16];
     if (xSemaphoreTake(state_mutex, portMAX_DELAY) == pdTRUE) {
-        snprintf(bpm_str, sizeof(bpm_str), "%d", bpm);
+        if (bpm_x10 % 10 == 0) {
+            snprintf(bpm_str, sizeof(bpm_str), "%d", bpm_x10 / 10);
+        } else {
+            snprintf(bpm_str, sizeof(bpm_str), "%d.%d", bpm_x10 / 10, bpm_x10 % 10);
+        }
         xSemaphoreGive(state_mutex);
     }
     return bpm_str;
@@ -324,6 +543,16 @@ const char* MidiSettingsState::get_midi_clk_type_str(void) {
     return midi_clk_type_to_string(type);
 }
 
+const char* MidiSettingsState::get_note_priority_str(size_t idx) {
+    NotePriority priority = get_note_priority(idx);
+    return note_priority_to_string(priority);
+}
+
+const char* MidiSettingsState::get_gate_mode_str(size_t idx) {
+    GateMode mode = get_gate_mode(idx);
+    return gate_mode_to_string(mode);
+}
+
 const char* MidiSettingsState::get_midi_out_channel_str(size_t idx) {
     MidiChannel ch = get_midi_out_channel(idx);
     return midi_channel_to_string(ch);
@@ -358,6 +587,8 @@ const char* MidiSettingsState::midi_out_type_to_string(MidiOutType type) {
         case MidiOutClock1_32:   return "clock1/32";
         case MidiOutClock1_8T:   return "clock1/8T";
         case MidiOutClock1_16T:  return "clock1/16T";
+        case MidiOutClock48:     return "clock48ppq";
+        case MidiOutClock96:     return "clock96ppq";
         case MidiOutRun:         return "run";
         case MidiOutStop:        return "stop";
         default:
@@ -379,23 +610,56 @@ const char* MidiSettingsState::midi_clk_type_to_string(MidiClkType type) {
     }
 }
 
+const char* MidiSettingsState::poly_mode_to_string(PolyMode mode) {
+    switch (mode) {
+        case PolyOff:        return "off";
+        case PolyRoundRobin: return "rotate";
+        case PolyReuse:      return "reuse";
+        case PolySteal:      return "steal";
+        default: return "unknown";
+    }
+}
+
+const char* MidiSettingsState::note_priority_to_string(NotePriority priority) {
+    switch (priority) {
+        case NotePriorityHigh: return "high";
+        case NotePriorityLow:  return "low";
+        case NotePriorityLast: return "last";
+        default: return "unknown";
+    }
+}
+
+const char* MidiSettingsState::gate_mode_to_string(GateMode mode) {
+    switch (mode) {
+        case GateRetrigger: return "trg";
+        case GateLegato:    return "leg";
+        default: return "unknown";
+    }
+}
+
 bool MidiSettingsState::is_clock_type(MidiOutType type) {
     return type == MidiOutType::MidiOutClock1_4 ||
            type == MidiOutType::MidiOutClock1_8 ||
            type == MidiOutType::MidiOutClock1_16 ||
            type == MidiOutType::MidiOutClock1_32 ||
            type == MidiOutType::MidiOutClock1_8T ||
-           type == MidiOutType::MidiOutClock1_16T;
+           type == MidiOutType::MidiOutClock1_16T ||
+           type == MidiOutType::MidiOutClock48 ||
+           type == MidiOutType::MidiOutClock96;
 }
 
-int MidiSettingsState::get_clock_division_ticks(MidiOutType type) {
+// Pulse period in 1/256 MIDI clock ticks, so rates above the clock itself can be
+// derived from the interpolated tick position
+int MidiSettingsState::get_clock_period_q8(MidiOutType type) {
     switch (type) {
-        case MidiOutType::MidiOutClock1_4:  return 24;  // Every beat (quarter note)
-        case MidiOutType::MidiOutClock1_8:  return 12;  // Every 8th note
-        case MidiOutType::MidiOutClock1_16: return 6;   // Every 16th note
-        case MidiOutType::MidiOutClock1_32: return 3;  // Every 32nd note
-        case MidiOutType::MidiOutClock1_8T: return 8;  // Every 8th note triplet (12 * 2/3)
-        case MidiOutType::MidiOutClock1_16T: return 4; // Every 16th note triplet (6 * 2/3)
+        case MidiOutType::MidiOutClock1_4:  return 24 << 8;  // Every beat (quarter note)
+        case MidiOutType::MidiOutClock1_8:  return 12 << 8;  // Every 8th note
+        case MidiOutType::MidiOutClock1_16: return 6 << 8;   // Every 16th note
+        case MidiOutType::MidiOutClock1_32: return 3 << 8;  // Every 32nd note
+        case MidiOutType::MidiOutClock1_8T: return 8 << 8;  // Every 8th note triplet (12 * 2/3)
+        case MidiOutType::MidiOutClock1_16T: return 4 << 8; // Every 16th note triplet (6 * 2/3)
+        case MidiOutType::MidiOutClock48:   return 1 << 7;   // Half a tick
+        case MidiOutType::MidiOutClock96:   return 1 << 6;   // Quarter of a tick
         default: return 0;
     }
 }
@@ -423,13 +687,19 @@ int MidiSettingsState::get_min_midi_out_type(size_t idx) {
 }
 
 void MidiSettingsState::set_default(void) {
-    bpm = 120;
+    bpm_x10 = 1200;
     midi_channel = MidiChannelAll;
     for (size_t i = 0; i < OutChannelCount; i++) {
         midi_out_type[i] = MidiOutPitch;
         midi_out_channel[i] = MidiChannelAll;
+        // Pitch follows every note on, as before priorities existed; a release
+        // now falls back to the latest held note where it used to take the highest
+        note_priority[i] = NotePriorityLast;
+        gate_mode[i] = GateLegato;
     }
     midi_clk_type = MidiClkInt;
+    poly_mode = PolyOff;
+    gate_settle_us = 0;
     bluetooth_enabled = false;
 }
 
@@ -14,6 +14,7 @@ enum MidiInputSource {
     MidiInputSerial,    // Hardware serial MIDI (default)
     MidiInputBluetooth, // BLE MIDI
     MidiInputUsb,       // USB MIDI
+    MidiInputSourceCount,
 };
 
 enum MidiChannel {
@@ -39,6 +40,27 @@ enum MidiChannel {
 
 const int MIDI_CHANNEL_COUNT = 16 + 1; // start from 1 to 16
 
+// Which held note drives a mono output
+enum NotePriority {
+    NotePriorityHigh,
+    NotePriorityLow,
+    NotePriorityLast,
+};
+
+// Gate behavior when the driving note changes while a gate is already high
+enum GateMode {
+    GateRetrigger, // short low pulse, then high again
+    GateLegato,    // stays high
+};
+
+// How notes of a channel are spread over its pitch/gate output pairs
+enum PolyMode {
+    PolyOff,        // every output follows the channel (mono)
+    PolyRoundRobin, // rotate through voices, the next one in turn is stolen when all are busy
+    PolyReuse,      // prefer the voice that last played the same note, then free, then oldest
+    PolySteal,      // lowest free voice, the oldest note is stolen when all are busy
+};
+
 enum MidiOutType {
     MidiOutClock1_4,
     MidiOutClock1_8,
@@ -46,6 +68,8 @@ enum MidiOutType {
     MidiOutClock1_32,
     MidiOutClock1_8T,
     MidiOutClock1_16T,
+    MidiOutClock48,    // two pulses per MIDI clock tick
+    MidiOutClock96,    // four pulses per MIDI clock tick
     MidiOutRun,
     MidiOutStop,
     MidiOutGate,
@@ -192,6 +216,15 @@ public:
     const static int MIN_MIDI_OUT_TYPE = MidiOutClock1_4;
     const static int MAX_MIDI_CLK_TYPE = MidiClkExt;
     const static int MIN_MIDI_CLK_TYPE = MidiClkInt;
+    const static int MAX_NOTE_PRIORITY = NotePriorityLast;
+    const static int MIN_NOTE_PRIORITY = NotePriorityHigh;
+    const static int MAX_GATE_MODE = GateLegato;
+    const static int MIN_GATE_MODE = GateRetrigger;
+    const static int MAX_POLY_MODE = PolySteal;
+    const static int MIN_POLY_MODE = PolyOff;
+    const static int MAX_GATE_SETTLE_US = 2000;
+    const static int MIN_GATE_SETTLE_US = 0;
+    const static int GATE_SETTLE_STEP_US = 100;
 
     MidiSettingsState(void);
     ~MidiSettingsState(void);
@@ -205,18 +238,32 @@ public:
     const char* get_midi_out_type_str(size_t idx);
     const char* get_midi_out_channel_str(size_t idx);
     const char* get_midi_clk_type_str(void);
+    const char* get_note_priority_str(size_t idx);
+    const char* get_gate_mode_str(size_t idx);
+    const char* get_poly_mode_str(void);
+    const char* get_gate_settle_str(void);
 
     void set_bpm(int bpm);
+    void set_bpm_x10(int bpm_x10); // tempo in tenths of BPM
     void set_midi_channel(MidiChannel ch);
     void set_midi_out_type(size_t idx, MidiOutType type);
     void set_midi_out_channel(size_t idx, MidiChannel ch);
     void set_midi_clk_type(MidiClkType type);
+    void set_note_priority(size_t idx, NotePriority priority);
+    void set_gate_mode(size_t idx, GateMode mode);
+    void set_poly_mode(PolyMode mode);
+    void set_gate_settle_us(int us); // delay from pitch CV change to gate edge
 
     int get_bpm(void);
+    int get_bpm_x10(void);
     MidiChannel get_midi_channel(void);
     MidiOutType get_midi_out_type(size_t idx);
     MidiChannel get_midi_out_channel(size_t idx);
     MidiClkType get_midi_clk_type(void);
+    NotePriority get_note_priority(size_t idx);
+    GateMode get_gate_mode(size_t idx);
+    PolyMode get_poly_mode(void);
+    int get_gate_settle_us(void);
 
     // Bluetooth MIDI settings
     void set_bluetooth_enabled(bool enabled);
@@ -225,6 +272,8 @@ public:
 
     int get_max_bpm(void) { return MAX_BPM; }
     int get_min_bpm(void) { return MIN_BPM; }
+    int get_max_bpm_x10(void) { return MAX_BPM * 10; }
+    int get_min_bpm_x10(void) { return MIN_BPM * 10; }
     int get_max_midi_channel(void) { return MidiChannelAll; }
     int get_min_midi_channel(void) { return MidiChannel1; }
     int get_max_midi_out_channel(void) { return MidiChannelAll; }
@@ -233,22 +282,41 @@ public:
     int get_min_midi_out_type(size_t idx);
     int get_max_midi_clk_type(void) { return MAX_MIDI_CLK_TYPE; }
     int get_min_midi_clk_type(void) { return MIN_MIDI_CLK_TYPE; }
+    int get_max_note_priority(void) { return MAX_NOTE_PRIORITY; }
+    int get_min_note_priority(void) { return MIN_NOTE_PRIORITY; }
+    int get_max_gate_mode(void) { return MAX_GATE_MODE; }
+    int get_min_gate_mode(void) { return MIN_GATE_MODE; }
+    int get_max_poly_mode(void) { return MAX_POLY_MODE; }
+    int get_min_poly_mode(void) { return MIN_POLY_MODE; }
+    int get_max_gate_settle_us(void) { return MAX_GATE_SETTLE_US; }
+    int get_min_gate_settle_us(void) { return MIN_GATE_SETTLE_US; }
 
     bool is_clock_type(MidiOutType type);
-    int get_clock_division_ticks(MidiOutType type);
+    int get_clock_period_q8(MidiOutType type);
+
+    // Incremented whenever routing-related settings change (read without locking)
+    uint32_t get_revision(void) const { return revision; }
     
 private:
-    int bpm;
+    int bpm_x10;
     MidiChannel midi_channel;
     MidiOutType midi_out_type[OutChannelCount];
     MidiChannel midi_out_channel[OutChannelCount];
+    NotePriority note_priority[OutChannelCount];
+    GateMode gate_mode[OutChannelCount];
     MidiClkType midi_clk_type;
+    PolyMode poly_mode;
+    int gate_settle_us;
     bool bluetooth_enabled;
+    volatile uint32_t revision;
     SemaphoreHandle_t state_mutex;
 
     const char* midi_channel_to_string(MidiChannel ch);
     const char* midi_out_type_to_string(MidiOutType type);
     const char* midi_clk_type_to_string(MidiClkType type);
+    const char* note_priority_to_string(NotePriority priority);
+    const char* gate_mode_to_string(GateMode mode);
+    const char* poly_mode_to_string(PolyMode mode);
     void set_default(void);
     esp_err_t recall_nvs(void);
     esp_err_t store_nvs(void);
@@ -1,52 +1,50 @@
 #include "note_history.h"
 #include <Arduino.h>
-#include <algorithm>
 #include "../board.h"
 
 void NoteHistory::Note::reset(void)
 {
     prev = NO_NOTE;
     next = NO_NOTE;
-    in_use = false;
     id = 0;
 }
 
+static inline void mask_set(uint32_t* mask, uint8_t bit) {
+    mask[bit >> 5] |= (1u << (bit & 31));
+}
+
+static inline void mask_clear(uint32_t* mask, uint8_t bit) {
+    mask[bit >> 5] &= ~(1u << (bit & 31));
+}
+
+static inline bool mask_test(const uint32_t* mask, uint8_t bit) {
+    return (mask[bit >> 5] >> (bit & 31)) & 1;
+}
+
 bool NoteHistory::push(uint8_t note, uint8_t* out_id) {
     if(DEBUG_MIDI_PROCESSOR) Serial.printf("  pushing note: %d\n", note);
     
-    if (history[note].in_use) {
+    if (note >= MIDI_NOTES_COUNT) {
+        return false;
+    }
+
+    if (mask_test(held_mask, note)) {
         Serial.println("  push FAILED: note already in use");
         return false;
     }
 
     // Find the minimum available id
     uint8_t new_id = 0;
-    if (last != NO_NOTE) {
-        // Collect all used ids from the linked list
-        uint8_t used_ids[MIDI_NOTES_COUNT];
-        uint8_t ids_count = 0;
-        uint8_t current = last;
-        
-        // Traverse the linked list and collect all ids
-        do {
-            used_ids[ids_count++] = history[current].id;
-            current = history[current].prev;
-        } while (current != NO_NOTE);
-        
-        // Sort
-        std::sort(used_ids, used_ids + ids_count);
-        
-        // Find the first gap in one pass
-        for (uint8_t i = 0; i < ids_count; i++) {
-            if (used_ids[i] != i) {
-                new_id = i;
-                break;
-            }
-            new_id = i + 1;
+    for (size_t w = 0; w < MASK_WORDS; w++) {
+        uint32_t free_ids = ~id_mask[w];
+        if (free_ids != 0) {
+            new_id = w * 32 + __builtin_ctz(free_ids);
+            break;
         }
     }
 
-    history[note].in_use = true;
+    mask_set(held_mask, note);
+    mask_set(id_mask, new_id);
     history[note].id = new_id;
     history[note].prev = last;
     if (last != NO_NOTE) {
@@ -65,7 +63,7 @@ bool NoteHistory::push(uint8_t note, uint8_t* out_id) {
 bool NoteHistory::pop(uint8_t note, uint8_t* out_id) {
     if(DEBUG_MIDI_PROCESSOR) Serial.printf("  popping note: %d\n", note);
     
-    if (!history[note].in_use) {
+    if (note >= MIDI_NOTES_COUNT || !mask_test(held_mask, note)) {
         Serial.println("  pop FAILED: note not in use");
         return false;
     }
@@ -75,7 +73,9 @@ bool NoteHistory::pop(uint8_t note, uint8_t* out_id) {
     uint8_t next = history[note].next;
 
     if (note != last) {
-        history[prev].next = next;
+        if (prev != NO_NOTE) {
+            history[prev].next = next;
+        }
         history[next].prev = prev;
     } else {
         last = prev;
@@ -84,6 +84,8 @@ bool NoteHistory::pop(uint8_t note, uint8_t* out_id) {
         }
     }
 
+    mask_clear(held_mask, note);
+    mask_clear(id_mask, note_id);
     history[note].reset();
     count--;
 
@@ -95,7 +97,7 @@ bool NoteHistory::pop(uint8_t note, uint8_t* out_id) {
 }
 
 bool NoteHistory::is_in_use(uint8_t note) {
-    return history[note].in_use;
+    return note < MIDI_NOTES_COUNT && mask_test(held_mask, note);
 }
 
 uint8_t NoteHistory::get_prev(uint8_t note) {
@@ -107,9 +109,13 @@ uint8_t NoteHistory::get_next(uint8_t note) {
 }
 
 void NoteHistory::reset(void) {
-    for (int i = 0; i < MIDI_NOTES_COUNT; i++) {
+    for (size_t i = 0; i < MIDI_NOTES_COUNT; i++) {
         history[i].reset();
     }
+    for (size_t w = 0; w < MASK_WORDS; w++) {
+        held_mask[w] = 0;
+        id_mask[w] = 0;
+    }
     last = NO_NOTE;
     count = 0;
 }
@@ -126,20 +132,24 @@ uint8_t NoteHistory::get_last(void) {
     return last;
 }
 
-uint8_t NoteHistory::get_current(void) {
-    if (last == NO_NOTE) {
-        return NO_NOTE;
+uint8_t NoteHistory::get_highest(void) {
+    for (int w = MASK_WORDS - 1; w >= 0; w--) {
+        if (held_mask[w] != 0) {
+            return w * 32 + 31 - __builtin_clz(held_mask[w]);
+        }
     }
-    
-    uint8_t max_note = last;
-    uint8_t current = history[last].prev;
-    
-    while (current != NO_NOTE) {
-        if (current > max_note) {
-            max_note = current;
+    return NO_NOTE;
+}
+
+uint8_t NoteHistory::get_lowest(void) {
+    for (size_t w = 0; w < MASK_WORDS; w++) {
+        if (held_mask[w] != 0) {
+            return w * 32 + __builtin_ctz(held_mask[w]);
         }
-        current = history[current].prev;
     }
-    
-    return max_note;
+    return NO_NOTE;
+}
+
+uint8_t NoteHistory::get_current(void) {
+    return get_highest();
 }
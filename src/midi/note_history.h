@@ -5,14 +5,14 @@
 
 struct NoteHistory
 {
-    static const size_t  MIDI_NOTES_COUNT = 127;
+    static const size_t  MIDI_NOTES_COUNT = 128;
     static const uint8_t NO_NOTE = (1 << 7);
+    static const size_t  MASK_WORDS = MIDI_NOTES_COUNT / 32;
 
     struct Note
     {
         uint8_t prev;
         uint8_t next;
-        bool in_use;
         uint8_t id;
 
         void reset(void);
@@ -20,10 +20,16 @@ struct NoteHistory
         Note() { reset(); }
     };
 
+    // Held notes in press order (doubly linked list, last = most recent)
     Note history[MIDI_NOTES_COUNT];
     int last;
     int count;
 
+    // Bit per held note and per used id, so priority queries and id allocation
+    // are a few count-leading/trailing-zeros operations instead of list walks
+    uint32_t held_mask[MASK_WORDS];
+    uint32_t id_mask[MASK_WORDS];
+
     bool push(uint8_t note, uint8_t* out_id);
     bool pop(uint8_t note, uint8_t* out_id);
     bool is_in_use(uint8_t note);
@@ -33,6 +39,8 @@ struct NoteHistory
     int get_count(void);
     bool is_empty(void);
     uint8_t get_last(void);
+    uint8_t get_highest(void);
+    uint8_t get_lowest(void);
     uint8_t get_current(void);
 
     NoteHistory() { reset(); }
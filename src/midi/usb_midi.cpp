@@ -91,38 +91,38 @@ void UsbMidi::update() {
         switch (type) {
             case 0x09: // Note On
                 if (packet.byte3 > 0) {
-                    processor->handle_note_on(channel + 1, packet.byte2, packet.byte3);
+                    processor->post_event(MidiInputUsb, EventNoteOn, channel + 1, packet.byte2, packet.byte3);
                 } else {
-                    processor->handle_note_off(channel + 1, packet.byte2, 0);
+                    processor->post_event(MidiInputUsb, EventNoteOff, channel + 1, packet.byte2, 0);
                 }
                 break;
                 
             case 0x08: // Note Off
-                processor->handle_note_off(channel + 1, packet.byte2, packet.byte3);
+                processor->post_event(MidiInputUsb, EventNoteOff, channel + 1, packet.byte2, packet.byte3);
                 break;
                 
             case 0x0B: // Control Change
-                processor->handle_cc(channel + 1, packet.byte2, packet.byte3);
+                processor->post_event(MidiInputUsb, EventCc, channel + 1, packet.byte2, packet.byte3);
                 break;
                 
             case 0x0E: // Pitch Bend
                 {
                     int value = ((int)packet.byte3 << 7) | packet.byte2;
                     value -= 8192; // Center at 0
-                    processor->handle_pitchbend(channel + 1, value);
+                    processor->post_event(MidiInputUsb, EventPitchBend, channel + 1, 0, 0, value);
                 }
                 break;
                 
             case 0x0F: // System messages
                 switch (packet.byte1) {
                     case 0xF8: // Clock
-                        processor->handle_clock();
+                        processor->post_event(MidiInputUsb, EventClock);
                         break;
                     case 0xFA: // Start
-                        processor->handle_start();
+                        processor->post_event(MidiInputUsb, EventStart);
                         break;
                     case 0xFC: // Stop
-                        processor->handle_stop();
+                        processor->post_event(MidiInputUsb, EventStop);
                         break;
                 }
                 break;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// Pitchbend: frequency ratio 2^(bend * range / 12) in Q16, from a table indexed by
+// the top bits of the 14 bit bend and linearly interpolated on the rest
+const int BEND_TABLE_BITS = 8;
+const int BEND_TABLE_SIZE = 1 << BEND_TABLE_BITS;
+const int BEND_FRAC_BITS = 14 - BEND_TABLE_BITS;
+static uint32_t bend_ratio_table[BEND_TABLE_SIZE + 1];
+
+static void bend_ratio_init(float range_semitones) {
+    for (int i = 0; i <= BEND_TABLE_SIZE; i++) {
+        // -1 .. +1 of the bend range, the last entry is the +8192 end for interpolation
+        float bend = (float)(i - BEND_TABLE_SIZE / 2) / (BEND_TABLE_SIZE / 2);
+        bend_ratio_table[i] = (uint32_t)(pow(2.0f, bend * range_semitones / 12.0f) * 65536.0f + 0.5f);
+    }
+}
+
+static inline uint32_t bend_ratio_q16(int value) {
+    // value: -8192 .. +8191, 0 = center
+    uint32_t pos = (uint32_t)(value + 8192) & 0x3fff;
+    uint32_t idx = pos >> BEND_FRAC_BITS;
+    uint32_t frac = pos & ((1 << BEND_FRAC_BITS) - 1);
+    uint32_t a = bend_ratio_table[idx];
+    uint32_t b = bend_ratio_table[idx + 1];
+    return a + (((b - a) * frac) >> BEND_FRAC_BITS);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+// CC numbers the Mozzi voices respond to on their output's channel. Values that
+// pick from a list (voice steal, waveform, voice type, filter mode) split 0..127
+// evenly over it; osc.h has what the others map to.
+const uint8_t CC_VOICE_STEAL = 20;
+const uint8_t CC_FILTER_MODE = 21;
+const uint8_t CC_VOICE_TYPE = 22;
+const uint8_t CC_FM_RATIO = 23;
+const uint8_t CC_FM_INDEX = 24;
+const uint8_t CC_WAVEFORM = 70;
+const uint8_t CC_FILTER_RESONANCE = 71;
+const uint8_t CC_ENV_RELEASE = 72;
+const uint8_t CC_ENV_ATTACK = 73;
+const uint8_t CC_FILTER_CUTOFF = 74;
+const uint8_t CC_ENV_DECAY = 75;
+const uint8_t CC_ENV_SUSTAIN = 79;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdint.h>
+
+// Time and level settings shared by the voices of a channel
+struct EnvelopeParams {
+    uint32_t attack_ticks;  // control ticks from the start level to peak, >= 1
+    uint32_t decay_ticks;   // control ticks from peak to sustain, >= 1
+    uint32_t release_ticks; // control ticks from the release level to silence, >= 1
+    int32_t sustain_q15;    // sustain as a fraction of peak, 0..32767
+};
+
+// Linear integer ADSR. Levels are Q23 (Q15 gain << LEVEL_SHIFT) so slow
+// segments still move every tick. step() runs once per control tick; the audio
+// path interpolates between the returned levels.
+struct Envelope {
+    enum Stage : uint8_t {
+        Idle,
+        Attack,
+        Decay,
+        Sustain,
+        Release,
+    };
+
+    static const int LEVEL_SHIFT = 8;
+
+    Stage stage;
+    int32_t level;   // Q23 after the last step()
+    int32_t peak;    // Q23, from velocity
+    int32_t sustain; // Q23
+    int32_t rate;    // Q23 per tick in the current stage
+
+    Envelope() : stage(Idle), level(0), peak(0), sustain(0), rate(0) {}
+
+    // Starts from the current level, so a stolen voice does not jump
+    void note_on(int32_t peak_q15, const EnvelopeParams& params) {
+        peak = peak_q15 << LEVEL_SHIFT;
+        sustain = (int32_t)(((int64_t)peak * params.sustain_q15) >> 15);
+        stage = Attack;
+        rate = slope(peak - level, params.attack_ticks);
+    }
+
+    void note_off(const EnvelopeParams& params) {
+        if (stage == Idle) return;
+        stage = Release;
+        rate = slope(level, params.release_ticks);
+    }
+
+    // Advance one control tick. Returns the new level.
+    int32_t step(const EnvelopeParams& params) {
+        switch (stage) {
+            case Attack:
+                level += rate;
+                if (level >= peak) {
+                    level = peak;
+                    stage = Decay;
+                    rate = slope(peak - sustain, params.decay_ticks);
+                }
+                break;
+            case Decay:
+                level -= rate;
+                if (level <= sustain) {
+                    level = sustain;
+                    stage = Sustain;
+                }
+                break;
+            case Sustain:
+                level = sustain;
+                break;
+            case Release:
+                level -= rate;
+                if (level <= 0) {
+                    level = 0;
+                    stage = Idle;
+                }
+                break;
+            case Idle:
+            default:
+                level = 0;
+                break;
+        }
+        return level;
+    }
+
+    bool is_idle(void) const { return stage == Idle; }
+    bool is_released(void) const { return stage == Release || stage == Idle; }
+
+private:
+    static int32_t slope(int32_t distance, uint32_t ticks) {
+        if (distance <= 0) return 1;
+        int32_t r = distance / (int32_t)ticks;
+        return r > 0 ? r : 1;
+    }
+};
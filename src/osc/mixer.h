@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+const int MAX_OSCS = 32; // oscillator pool per channel, measure_voice_cost() decides how many play
+
+// Mixer: int8 samples times the Q15 envelope level, summed in 32 bits (MAX_OSCS
+// voices stay below 2^28). One voice at full velocity is +-2^22, >> MIX_SHIFT
+// brings it to 16 bits, then MIX_GAIN_Q15 scales so MIX_VOICES voices reach full
+// scale. The gain is applied in 64 bits, so larger chords clip instead of wrapping.
+const int MIX_VOICES = 5;
+const int MIX_SHIFT = 7;
+const int32_t MIX_GAIN_Q15 = 32768 / MIX_VOICES;
+
+static inline int32_t clamp16(int32_t v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return v;
+}
+
+// A channel's voice sum to a 16 bit sample
+static inline int32_t mix_to_16(int32_t sum) {
+    int64_t scaled = ((int64_t)(sum >> MIX_SHIFT) * MIX_GAIN_Q15) >> 15;
+    if (scaled > 32767) return 32767;
+    if (scaled < -32768) return -32768;
+    return (int32_t)scaled;
+}
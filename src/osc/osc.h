@@ -1,66 +1,617 @@
 #include <Oscil.h>
-#include <tables/waveshape_chebyshev_5th_256_int8.h>
 #include <mozzi_midi.h>
+#include "envelope.h"
+#include "wavetables.h"
+#include "svf.h"
+#include "sample_bank.h"
+#include "bend.h"
+#include "mixer.h"
+#include "cc_map.h"
 
-const bool DEBUG_OSC = true;
-const int NUM_OSCS = 5;
+const int AUDIO_LOAD_PERCENT = 60; // share of the sample period the voices may use
 
-float pitchBend[MOZZI_AUDIO_CHANNELS];
+// Which voice a note takes when the channel budget is used up (CC_VOICE_STEAL)
+enum VoiceSteal {
+    StealOldest,   // longest sounding note
+    StealQuietest, // lowest envelope level, oldest on a tie
+    StealSameNote, // a voice already playing this note, else the oldest
+    StealCount
+};
+
+// Waveform per channel (CC_WAVEFORM). Tables are band-limited per octave (see
+// scripts/gen_wavetables.py); the mip is picked when the frequency changes,
+// never per sample.
+static Waveform waveform[MOZZI_AUDIO_CHANNELS];
+
+// Voice engine per channel (CC_VOICE_TYPE). Both play through
+// the MidiOutMozzi route; channel_budget() sizes polyphony by the engine's cost.
+enum VoiceType {
+    VoiceTable, // one wavetable oscillator, see CC_WAVEFORM
+    VoiceFm,    // 2-op FM: sine modulator on the phase of a sine carrier
+    VoiceSample, // PCM from the sample bank, notes without a sample are ignored
+    VoiceTypeCount
+};
+static VoiceType voice_type[MOZZI_AUDIO_CHANNELS];
+
+// FM: modulator at carrier * ratio (CC_FM_RATIO picks from FM_RATIOS_Q16), CC_FM_INDEX
+// 0..127 maps linearly to a peak deviation of 0 .. FM_MAX_INDEX radians and glides
+// there at control rate
+const float FM_MAX_INDEX = 8.0f;
+static const uint32_t FM_RATIOS_Q16[] = {
+    0x08000, 0x10000, 0x18000, 0x20000, 0x28000, 0x30000,
+    0x38000, 0x40000, 0x50000, 0x60000, 0x70000, 0x80000,
+};
+const int FM_RATIO_COUNT = sizeof(FM_RATIOS_Q16) / sizeof(FM_RATIOS_Q16[0]);
+static const int8_t* const FM_SINE = WAVETABLES[WaveSine][0];
+static uint32_t fm_index_table[128]; // carrier phase offset per unit of modulator sample
+static uint32_t fm_ratio[MOZZI_AUDIO_CHANNELS];     // Q16
+static uint32_t fm_index[MOZZI_AUDIO_CHANNELS];     // target, from fm_index_table
+static uint32_t fm_index_cur[MOZZI_AUDIO_CHANNELS]; // used per sample
+
+// Sample player: each note plays its sample from the mapped "samples" partition at the
+// recorded rate. One-shots ignore note off and end with the sample; looped samples
+// loop until their release has faded. Every stream adds flash cache misses, so
+// sample polyphony is capped on top of the cycle budget.
+const int SAMPLE_MAX_VOICES = 8; // per channel
+const int FLASH_CACHE_LINE = 32; // bytes, a sample voice misses at most once per line
+static SampleBank sample_bank;
+static uint32_t flash_miss_cycles = 0; // measured, see measure_flash_miss()
+
+// Filter on the voice mix, per channel. Cutoff maps 0..127 to 30 Hz .. 5 kHz and
+// resonance to Q 0.7 .. 14 (both exponential); the coefficients glide there at control rate.
+static int32_t svf_cutoff_table[128];  // Q15 f
+static int32_t svf_damping_table[128]; // Q15 1/Q
+static Svf filters[MOZZI_AUDIO_CHANNELS];
+static SvfMode filter_mode[MOZZI_AUDIO_CHANNELS];
+static int32_t filter_f[MOZZI_AUDIO_CHANNELS];       // target of filters[].f
+static int32_t filter_damping[MOZZI_AUDIO_CHANNELS]; // target of filters[].damping
+
+// Amplitude envelope, per channel. Times map 0..127 to 1 ms .. 10 s (exponential).
+const int SAMPLES_PER_CONTROL = MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE;
+static uint32_t env_time_ticks[128];
+static EnvelopeParams env_params[MOZZI_AUDIO_CHANNELS];
+
+uint32_t pitchBend[MOZZI_AUDIO_CHANNELS]; // current ratio per channel Q16, see bend.h
+
+// Velocity 0..127 to Q15 gain, linear
+static int16_t velocity_gain[128];
 
 struct Osc {
-    Oscil <CHEBYSHEV_5TH_256_NUM_CELLS, AUDIO_RATE> oscil;
+    Oscil <WAVE_CELLS, AUDIO_RATE> oscil;
+    Waveform waveform;
     uint8_t note;
-    uint8_t velocity;
+    uint8_t velocity; // 0 once released
+    bool held;
+    Q16n16 base_freq; // unbent note frequency
+    uint32_t started; // note on order, for stealing
+    Envelope env;
+    int32_t env_cur;  // per-sample envelope level, Q23
+    int32_t env_step; // per-sample increment towards env.level
+    uint8_t start_delay; // samples of the next block to skip, see SignalProcessor::get_event_offset()
+    // FM operators, full cycle = 2^32
+    uint32_t fm_ratio; // Q16
+    uint32_t car_phase;
+    uint32_t car_inc;
+    uint32_t mod_phase;
+    uint32_t mod_inc;
+    // Sample playback, read in place from the mapped partition
+    const int8_t* smp_data;
+    uint32_t smp_pos;
+    uint32_t smp_length;
+    uint32_t smp_loop_start;
+    uint32_t smp_loop_end; // UINT32_MAX without a loop
+    bool smp_one_shot;
+
+    Osc() : oscil(WAVETABLES[WaveChebyshev][0]), waveform(WaveChebyshev), note(0), velocity(0), held(false), base_freq(0), started(0),
+            env_cur(0), env_step(0), start_delay(0), fm_ratio(0x10000), car_phase(0), car_inc(0), mod_phase(0), mod_inc(0),
+            smp_data(nullptr), smp_pos(0), smp_length(0), smp_loop_start(0), smp_loop_end(UINT32_MAX), smp_one_shot(false) {}
+
+    void setNote(uint8_t note) {
+        this->note = note;
+        base_freq = Q16n16_mtof(Q8n0_to_Q16n16(note));
+    }
 
-    Osc() : oscil(CHEBYSHEV_5TH_256_DATA), note(0), velocity(0) {}
+    // ratio_q16: bend ratio from bend_ratio_q16()
+    void setFreq(uint32_t ratio_q16) {
+        Q16n16 freq = (Q16n16)(((uint64_t)base_freq * ratio_q16) >> 16);
+        oscil.setTable(WAVETABLES[waveform][mip_for(freq)]);
+        oscil.setFreq_Q16n16(freq);
+        car_inc = (uint32_t)(((uint64_t)freq << 16) / MOZZI_AUDIO_RATE);
+        mod_inc = (uint32_t)(((uint64_t)car_inc * fm_ratio) >> 16);
+    }
+
+    // First mip whose harmonics (128 >> mip) all stay below Nyquist at freq
+    static int mip_for(Q16n16 freq) {
+        uint32_t hz = ((uint32_t)freq + 0xffff) >> 16;
+        int mip = 0;
+        while (mip < WAVE_MIPS - 1 && (128u >> mip) * hz > WAVE_NYQUIST) {
+            mip++;
+        }
+        return mip;
+    }
 
-    void setFreq(float pitchBend) {
-        oscil.setFreq(
-            Q16n16_to_float(Q16n16_mtof(Q8n0_to_Q16n16(note))) * pow(2.0f, pitchBend * SignalProcessor::PITCHBEND_RANGE_SEMITONES / 12.0f)
-        );
+    // Control tick: advance the envelope and spread the change over the next samples
+    void control(const EnvelopeParams& params) {
+        int32_t target = env.step(params);
+        env_step = (target - env_cur) / SAMPLES_PER_CONTROL;
+    }
+
+    // One output sample, scaled by the envelope (+-2^22)
+    inline int32_t next(void) {
+        env_cur += env_step;
+        return (int32_t)oscil.next() * (env_cur >> Envelope::LEVEL_SHIFT);
+    }
+
+    // FM sample, scaled like next(). index: from fm_index_table. Wrapping
+    // unsigned math keeps negative modulator values correct.
+    inline int32_t next_fm(uint32_t index) {
+        env_cur += env_step;
+        mod_phase += mod_inc;
+        int32_t mod = FLASH_OR_RAM_READ<const int8_t>(FM_SINE + (mod_phase >> 24));
+        car_phase += car_inc;
+        uint32_t phase = car_phase + (uint32_t)mod * index;
+        return (int32_t)FLASH_OR_RAM_READ<const int8_t>(FM_SINE + (phase >> 24)) * (env_cur >> Envelope::LEVEL_SHIFT);
+    }
+
+    // Sample voice sample, scaled like next(). Silent past the end of the sample.
+    inline int32_t next_sample(void) {
+        env_cur += env_step;
+        int32_t pcm = smp_pos < smp_length ? smp_data[smp_pos] : 0;
+        if (++smp_pos == smp_loop_end) smp_pos = smp_loop_start;
+        return pcm * (env_cur >> Envelope::LEVEL_SHIFT);
+    }
+
+    // entry: nullptr for the other voice types, which then stay silent in sample mode
+    void set_sample(const SampleEntry* entry, const int8_t* data) {
+        smp_pos = 0;
+        if (entry == nullptr) {
+            smp_data = nullptr;
+            smp_length = 0;
+            smp_loop_start = 0;
+            smp_loop_end = UINT32_MAX;
+            smp_one_shot = false;
+            return;
+        }
+        bool loop = entry->flags & SampleLoop;
+        smp_data = data;
+        smp_length = entry->length;
+        smp_loop_start = loop ? entry->loop_start : 0;
+        smp_loop_end = loop ? entry->loop_end : UINT32_MAX;
+        smp_one_shot = !loop;
+    }
+
+    bool sample_done(void) const { return smp_pos >= smp_length; }
+
+    template <VoiceType TYPE>
+    inline int32_t sample(uint32_t fm_index) {
+        if (TYPE == VoiceFm) return next_fm(fm_index);
+        if (TYPE == VoiceSample) return next_sample();
+        return next();
+    }
+
+    // Add count samples to acc, starting at start_delay for a note that began mid-block
+    template <VoiceType TYPE>
+    void render(int32_t* acc, int count, uint32_t fm_index) {
+        int n = start_delay < count ? start_delay : count;
+        start_delay = 0;
+        for (; n < count; n++) {
+            acc[n] += sample<TYPE>(fm_index);
+        }
     }
 };
 
-static Osc oscs[MOZZI_AUDIO_CHANNELS][NUM_OSCS];
+static Osc oscs[MOZZI_AUDIO_CHANNELS][MAX_OSCS];
+
+// Sounding oscillators per channel, so silent ones cost nothing per sample
+struct ActiveList {
+    uint8_t count;
+    uint8_t osc[MAX_OSCS];  // indices into oscs[channel]
+    uint8_t slot[MAX_OSCS]; // position of an osc in osc[], valid while active
+
+    bool contains(uint8_t idx) const {
+        return slot[idx] < count && osc[slot[idx]] == idx;
+    }
+
+    void add(uint8_t idx) {
+        if (contains(idx)) return;
+        slot[idx] = count;
+        osc[count++] = idx;
+    }
+
+    void remove(uint8_t idx) {
+        if (!contains(idx)) return;
+        uint8_t pos = slot[idx];
+        uint8_t last = osc[--count];
+        osc[pos] = last;
+        slot[last] = pos;
+    }
+};
+
+static ActiveList active[MOZZI_AUDIO_CHANNELS];
+static VoiceSteal steal_policy[MOZZI_AUDIO_CHANNELS];
+static uint32_t note_counter = 0;
+// Cycles per sample the voices may use (AUDIO_LOAD_PERCENT) and what one voice of
+// each type costs, see measure_voice_cost(). Until measured: MIX_VOICES voices.
+static uint32_t voice_budget_cycles = MIX_VOICES;
+static uint32_t voice_cycles[VoiceTypeCount] = {1, 1, 1};
+static SignalProcessor* osc_processor = nullptr;
+
+// Sum the sounding voices of a channel into out, scaled to 16 bits. Voices that
+// play the whole block are summed sample by sample with the total in a register;
+// the few starting mid-block are added afterwards from their offset.
+template <VoiceType TYPE>
+static void mix_voices(int ch, int32_t* out, int count) {
+    const ActiveList& list = active[ch];
+    uint32_t index = fm_index_cur[ch];
+    Osc* whole[MAX_OSCS];
+    int whole_count = 0;
+    for (uint8_t v = 0; v < list.count; v++) {
+        Osc* osc = &oscs[ch][list.osc[v]];
+        if (osc->start_delay == 0) whole[whole_count++] = osc;
+    }
+
+    for (int n = 0; n < count; n++) {
+        int32_t acc = 0;
+        for (int v = 0; v < whole_count; v++) {
+            acc += whole[v]->sample<TYPE>(index);
+        }
+        out[n] = acc;
+    }
+
+    if (whole_count < list.count) {
+        for (uint8_t v = 0; v < list.count; v++) {
+            Osc& osc = oscs[ch][list.osc[v]];
+            if (osc.start_delay > 0) osc.render<TYPE>(out, count, index);
+        }
+    }
+}
+
+static void mix_channel(int ch, int32_t* out, int count) {
+    switch (voice_type[ch]) {
+        case VoiceFm:     mix_voices<VoiceFm>(ch, out, count); break;
+        case VoiceSample: mix_voices<VoiceSample>(ch, out, count); break;
+        default:          mix_voices<VoiceTable>(ch, out, count); break;
+    }
+
+    for (int n = 0; n < count; n++) {
+        out[n] = mix_to_16(out[n]);
+    }
+}
+
+// Block render callback: count is at most SignalProcessor::AUDIO_BLOCK_SIZE.
+// Channels not playing voices are left silent rather than mixed.
+void render_audio(int32_t* left, int32_t* right, int count) {
+    int32_t* out[MOZZI_AUDIO_CHANNELS] = {left, right};
+    uint32_t filter_cycles = 0;
+
+    for (int ch = 0; ch < MOZZI_AUDIO_CHANNELS; ch++) {
+        if (!osc_processor->osc_enabled[ch]) {
+            for (int n = 0; n < count; n++) {
+                out[ch][n] = 0;
+            }
+            continue;
+        }
+        mix_channel(ch, out[ch], count);
+
+        uint32_t start_cycles = PROFILE_AUDIO ? ESP.getCycleCount() : 0;
+        if (filter_mode[ch] != SvfOff) {
+            Svf& filter = filters[ch];
+            SvfMode mode = filter_mode[ch];
+            for (int n = 0; n < count; n++) {
+                out[ch][n] = clamp16(filter.process(out[ch][n], mode));
+            }
+        }
+        if (PROFILE_AUDIO) filter_cycles += ESP.getCycleCount() - start_cycles;
+    }
+
+    for (int n = 0; n < count; n++) {
+        AudioOutput sample = StereoOutput::from16Bit(left[n], right[n]);
+        left[n] = sample.l();
+        right[n] = sample.r();
+    }
+
+    if (PROFILE_AUDIO) {
+        osc_processor->profile_filter(filter_cycles / count);
+    }
+}
+
+// Voices a channel may use: its share of the cycle budget, divided by what one
+// voice of its type costs
+static int channel_budget(int ch) {
+    int enabled = 0;
+    for (int c = 0; c < MOZZI_AUDIO_CHANNELS; c++) {
+        if (osc_processor != nullptr && osc_processor->osc_enabled[c]) enabled++;
+    }
+    if (enabled == 0) enabled = 1;
+
+    int budget = voice_budget_cycles / enabled / voice_cycles[voice_type[ch]];
+    if (voice_type[ch] == VoiceSample && budget > SAMPLE_MAX_VOICES) budget = SAMPLE_MAX_VOICES;
+    if (budget < 1) budget = 1;
+    if (budget > MAX_OSCS) budget = MAX_OSCS;
+    return budget;
+}
+
+// Sounding voice playing the note; held_only skips voices in their release
+static int osc_find(int ch, uint8_t note, bool held_only) {
+    const ActiveList& list = active[ch];
+    for (uint8_t n = 0; n < list.count; n++) {
+        const Osc& osc = oscs[ch][list.osc[n]];
+        if (osc.note == note && (osc.held || !held_only)) return list.osc[n];
+    }
+    return -1;
+}
+
+// Pick the oscillator for a new note: a free one within budget, else steal by policy
+static int osc_allocate(int ch, uint8_t note) {
+    const ActiveList& list = active[ch];
+
+    if (list.count < channel_budget(ch)) {
+        for (int i = 0; i < MAX_OSCS; i++) {
+            if (!list.contains(i)) return i;
+        }
+    }
+
+    if (steal_policy[ch] == StealSameNote) {
+        int same = osc_find(ch, note, false);
+        if (same >= 0) return same;
+    }
+
+    // Voices fading out go first, then the policy decides
+    int victim = list.osc[0];
+    for (uint8_t n = 1; n < list.count; n++) {
+        const Osc& candidate = oscs[ch][list.osc[n]];
+        const Osc& current = oscs[ch][victim];
+        bool take;
+        if (candidate.held != current.held) {
+            take = !candidate.held;
+        } else {
+            bool older = (int32_t)(candidate.started - current.started) < 0;
+            if (steal_policy[ch] == StealQuietest) {
+                take = candidate.env.level < current.env.level ||
+                       (candidate.env.level == current.env.level && older);
+            } else {
+                take = older;
+            }
+        }
+        if (take) victim = list.osc[n];
+    }
+    return victim;
+}
 
-AudioOutput update_audio(void) {
-    float l = 0;
-    float r = 0;
-    for(int i = 0; i < NUM_OSCS; i++) {
-        l += oscs[0][i].oscil.next() * (float)oscs[0][i].velocity / 127.0f;
-        r += oscs[1][i].oscil.next() * (float)oscs[1][i].velocity / 127.0f;
+static void osc_start(int ch, int idx, uint8_t note, uint8_t velocity) {
+    Osc& osc = oscs[ch][idx];
+    osc.setNote(note);
+    osc.velocity = velocity;
+    osc.held = true;
+    osc.started = note_counter++;
+    // A silent voice starts where the note fell in the block; a stolen one
+    // carries on at once so its fade does not get a gap
+    osc.start_delay = osc.env_cur == 0 ? osc_processor->get_event_offset() : 0;
+    osc.waveform = waveform[ch];
+    osc.fm_ratio = fm_ratio[ch];
+    if (osc.env_cur == 0) {
+        // FM timbre depends on the operator phases, start them the same every note
+        osc.car_phase = 0;
+        osc.mod_phase = 0;
     }
-    return StereoOutput::from8Bit((int)(l / NUM_OSCS), (int)(r / NUM_OSCS));
+    osc.setFreq(pitchBend[ch]);
+    const SampleEntry* entry = voice_type[ch] == VoiceSample ? sample_bank.get(note) : nullptr;
+    osc.set_sample(entry, entry != nullptr ? sample_bank.get_data(entry) : nullptr);
+    osc.env.note_on(velocity_gain[velocity & 0x7f], env_params[ch]);
+    active[ch].add(idx);
+}
+
+// The voice stays allocated until its release has faded out, see osc_control()
+static void osc_release(int ch, int idx) {
+    Osc& osc = oscs[ch][idx];
+    osc.velocity = 0;
+    osc.held = false;
+    // One-shots play to the end of the sample, see osc_control()
+    if (osc.smp_one_shot) return;
+    osc.env.note_off(env_params[ch]);
+}
+
+// Envelopes run at control rate. Cost per tick is one step per sounding voice;
+// the per-sample part is a single add inside Osc::next(), so it is part of the
+// cost measure_voice_cost() sizes polyphony with.
+static void osc_control(void) {
+    for (int ch = 0; ch < MOZZI_AUDIO_CHANNELS; ch++) {
+        filters[ch].smooth(filter_f[ch], filter_damping[ch]);
+        fm_index_cur[ch] += (int32_t)(fm_index[ch] - fm_index_cur[ch]) / 8;
+
+        ActiveList& list = active[ch];
+        // Backwards, remove() moves the last entry into the freed slot
+        for (int n = list.count - 1; n >= 0; n--) {
+            uint8_t idx = list.osc[n];
+            Osc& osc = oscs[ch][idx];
+            if (osc.env.is_idle() || (voice_type[ch] == VoiceSample && osc.sample_done())) {
+                osc.env = Envelope();
+                osc.env_cur = 0;
+                osc.env_step = 0;
+                list.remove(idx);
+                continue;
+            }
+            osc.control(env_params[ch]);
+        }
+    }
+}
+
+// Cycles one voice of TYPE takes per sample on this core, timed on the same loop as mix_voices()
+template <VoiceType TYPE>
+static uint32_t time_voice(void) {
+    const int PROBE_VOICES = 4;
+    const int PROBE_BLOCKS = 8;
+    const int PROBE_SAMPLES = PROBE_BLOCKS * SignalProcessor::AUDIO_BLOCK_SIZE;
+    static Osc probe[PROBE_VOICES];
+    static int32_t out[SignalProcessor::AUDIO_BLOCK_SIZE];
+    static int8_t pcm[PROBE_SAMPLES]; // in RAM, flash misses are measured separately
+    volatile int32_t sink = 0;
+    uint32_t index = fm_index_table[64];
+    SampleEntry entry = {};
+    entry.length = PROBE_SAMPLES;
+
+    for (int v = 0; v < PROBE_VOICES; v++) {
+        probe[v].setNote(48 + v * 7);
+        probe[v].env_cur = velocity_gain[100] << Envelope::LEVEL_SHIFT;
+        probe[v].env_step = 0;
+        probe[v].setFreq(bend_ratio_q16(0));
+    }
+
+    // Best of a few runs, so an interrupt does not inflate the estimate
+    uint32_t best = UINT32_MAX;
+    for (int run = 0; run < 4; run++) {
+        for (int v = 0; v < PROBE_VOICES; v++) {
+            probe[v].set_sample(&entry, pcm);
+        }
+        uint32_t start = ESP.getCycleCount();
+        for (int b = 0; b < PROBE_BLOCKS; b++) {
+            for (int n = 0; n < SignalProcessor::AUDIO_BLOCK_SIZE; n++) {
+                int32_t acc = 0;
+                for (int v = 0; v < PROBE_VOICES; v++) {
+                    acc += probe[v].sample<TYPE>(index);
+                }
+                out[n] = acc;
+            }
+        }
+        uint32_t cycles = ESP.getCycleCount() - start;
+        sink = out[0];
+        if (cycles < best) best = cycles;
+    }
+    (void)sink;
+
+    return best / (PROBE_VOICES * PROBE_SAMPLES) + 1;
+}
+
+// Extra cycles a read costs when it misses the flash cache: one byte per cache
+// line over a span larger than the cache, against a span already cached
+static uint32_t measure_flash_miss(void) {
+    if (!sample_bank.is_ready()) return 0;
+
+    const uint32_t COLD_SPAN = 256 * 1024;
+    const uint32_t WARM_LINES = 64;
+    const volatile uint8_t* data = sample_bank.get_base();
+    uint32_t span = sample_bank.get_size() < COLD_SPAN ? sample_bank.get_size() : COLD_SPAN;
+    uint32_t lines = span / FLASH_CACHE_LINE;
+    uint32_t sum = 0;
+
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t l = 0; l < lines; l++) {
+        sum += data[l * FLASH_CACHE_LINE];
+    }
+    uint32_t cold = (ESP.getCycleCount() - start) / lines;
+
+    for (uint32_t l = 0; l < WARM_LINES; l++) {
+        sum += data[l * FLASH_CACHE_LINE];
+    }
+    start = ESP.getCycleCount();
+    for (uint32_t l = 0; l < WARM_LINES; l++) {
+        sum += data[l * FLASH_CACHE_LINE];
+    }
+    uint32_t warm = (ESP.getCycleCount() - start) / WARM_LINES;
+    (void)sum;
+
+    return cold > warm ? cold - warm : 0;
+}
+
+// Size the polyphony of each voice type from the sample period
+static void measure_voice_cost(void) {
+    voice_cycles[VoiceTable] = time_voice<VoiceTable>();
+    voice_cycles[VoiceFm] = time_voice<VoiceFm>();
+    // A sample stream misses once per cache line of PCM
+    flash_miss_cycles = measure_flash_miss();
+    voice_cycles[VoiceSample] = time_voice<VoiceSample>() + flash_miss_cycles / FLASH_CACHE_LINE + 1;
+
+    uint32_t budget = ESP.getCpuFreqMHz() * 1000000 / MOZZI_AUDIO_RATE;
+    voice_budget_cycles = budget * AUDIO_LOAD_PERCENT / 100;
+
+    if(DEBUG_OSC) Serial.printf("osc: %u cycles per table voice, %u per fm voice, %u per sample voice (flash miss %u), %u of %u per sample for voices\n",
+                                voice_cycles[VoiceTable], voice_cycles[VoiceFm], voice_cycles[VoiceSample], flash_miss_cycles,
+                                voice_budget_cycles, budget);
 }
 
 void event_callback(ProcessorEventType event_type, ProcessorEvent event) {
+    if (event_type == EventControl) {
+        osc_control();
+        return;
+    }
+
     // print note on event
     if (event_type == EventNoteOn) {
         if(DEBUG_OSC) Serial.printf("note on: %d, %d, %d id: %d\n", event.note.channel, event.note.note, event.note.velocity, event.note.id);
 
-        if(event.note.id < NUM_OSCS) {
-            oscs[event.note.channel][event.note.id].note = event.note.note;
-            oscs[event.note.channel][event.note.id].velocity = event.note.velocity;
-            oscs[event.note.channel][event.note.id].setFreq(pitchBend[event.note.channel]);
+        int ch = event.note.channel;
+        if (voice_type[ch] != VoiceSample || sample_bank.get(event.note.note) != nullptr) {
+            osc_start(ch, osc_allocate(ch, event.note.note), event.note.note, event.note.velocity);
         }
     }
     // print note off event
     if (event_type == EventNoteOff) {
         if(DEBUG_OSC) Serial.printf("note off: %d, %d, %d id: %d\n", event.note.channel, event.note.note, event.note.velocity, event.note.id);
-        if(event.note.id < NUM_OSCS) {
-            oscs[event.note.channel][event.note.id].velocity = 0;
+        // Stolen notes are no longer sounding and have nothing to release
+        int idx = osc_find(event.note.channel, event.note.note, true);
+        if (idx >= 0) {
+            osc_release(event.note.channel, idx);
         }
     }
 
     // print cc event
     if (event_type == EventCc) {
         if(DEBUG_OSC) Serial.printf("cc: %d, %d, %d\n", event.cc.channel, event.cc.cc, event.cc.value);
+
+        EnvelopeParams& params = env_params[event.cc.channel];
+        switch (event.cc.cc) {
+            case CC_VOICE_STEAL:
+                steal_policy[event.cc.channel] = (VoiceSteal)(event.cc.value * StealCount / 128);
+                break;
+            case CC_FILTER_MODE: {
+                SvfMode mode = (SvfMode)((event.cc.value & 0x7f) * SvfModeCount / 128);
+                // Do not carry state from the bypassed or another response
+                if (mode != filter_mode[event.cc.channel]) filters[event.cc.channel].reset();
+                filter_mode[event.cc.channel] = mode;
+                break;
+            }
+            case CC_FILTER_CUTOFF:    filter_f[event.cc.channel] = svf_cutoff_table[event.cc.value & 0x7f]; break;
+            case CC_FILTER_RESONANCE: filter_damping[event.cc.channel] = svf_damping_table[event.cc.value & 0x7f]; break;
+            case CC_VOICE_TYPE:
+                voice_type[event.cc.channel] = (VoiceType)((event.cc.value & 0x7f) * VoiceTypeCount / 128);
+                break;
+            case CC_FM_INDEX: fm_index[event.cc.channel] = fm_index_table[event.cc.value & 0x7f]; break;
+            case CC_FM_RATIO: {
+                int ch = event.cc.channel;
+                fm_ratio[ch] = FM_RATIOS_Q16[(event.cc.value & 0x7f) * FM_RATIO_COUNT / 128];
+                for (uint8_t n = 0; n < active[ch].count; n++) {
+                    Osc& osc = oscs[ch][active[ch].osc[n]];
+                    osc.fm_ratio = fm_ratio[ch];
+                    osc.setFreq(pitchBend[ch]);
+                }
+                break;
+            }
+            case CC_WAVEFORM: {
+                int ch = event.cc.channel;
+                waveform[ch] = (Waveform)((event.cc.value & 0x7f) * WaveCount / 128);
+                // Sounding voices switch too, silent ones on their next note on
+                for (uint8_t n = 0; n < active[ch].count; n++) {
+                    Osc& osc = oscs[ch][active[ch].osc[n]];
+                    osc.waveform = waveform[ch];
+                    osc.setFreq(pitchBend[ch]);
+                }
+                break;
+            }
+            case CC_ENV_ATTACK:  params.attack_ticks = env_time_ticks[event.cc.value & 0x7f]; break;
+            case CC_ENV_DECAY:   params.decay_ticks = env_time_ticks[event.cc.value & 0x7f]; break;
+            case CC_ENV_RELEASE: params.release_ticks = env_time_ticks[event.cc.value & 0x7f]; break;
+            case CC_ENV_SUSTAIN: params.sustain_q15 = velocity_gain[event.cc.value & 0x7f]; break;
+            default: break;
+        }
     }
 
     if (event_type == EventPitchBend) {
-        pitchBend[event.pitchbend.channel] = ((float)event.pitchbend.value - 8192.0f) / 8192.0f;  // -1.0 .. +1.0
-        for(int i = 0; i < NUM_OSCS; i++) {
-            oscs[event.pitchbend.channel][i].setFreq(pitchBend[event.pitchbend.channel]);
+        // value is already centered: -8192 .. +8191
+        int ch = event.pitchbend.channel;
+        pitchBend[ch] = bend_ratio_q16(event.pitchbend.value);
+        // Silent oscillators pick the ratio up on their next note on
+        for(uint8_t n = 0; n < active[ch].count; n++) {
+            oscs[ch][active[ch].osc[n]].setFreq(pitchBend[ch]);
         }
     }
 
@@ -68,7 +619,7 @@ void event_callback(ProcessorEventType event_type, ProcessorEvent event) {
         if(event_type == EventNoteOff || event_type == EventNoteOn) {
             // print list of enabled oscs
             Serial.print("enabled L oscs: ");
-            for(int i = 0; i < NUM_OSCS; i++) {
+            for(int i = 0; i < MAX_OSCS; i++) {
                 if(oscs[0][i].velocity > 0) {
                     Serial.print(i);
                     Serial.print(":");
@@ -80,7 +631,7 @@ void event_callback(ProcessorEventType event_type, ProcessorEvent event) {
             }
             Serial.println();
             Serial.print("enabled R oscs: ");
-            for(int i = 0; i < NUM_OSCS; i++) {
+            for(int i = 0; i < MAX_OSCS; i++) {
                 if(oscs[1][i].velocity > 0) {
                     Serial.print(i);
                     Serial.print(":");
@@ -96,6 +647,56 @@ void event_callback(ProcessorEventType event_type, ProcessorEvent event) {
 }
 
 void osc_init(SignalProcessor* signal_processor) {
-    signal_processor->set_update_audio_callback(update_audio);
+    osc_processor = signal_processor;
+
+    for (int v = 0; v < 128; v++) {
+        velocity_gain[v] = (v * 32767 + 63) / 127;
+    }
+    for (int v = 0; v < 128; v++) {
+        float ms = pow(10000.0f, v / 127.0f);
+        uint32_t ticks = (uint32_t)(ms * MOZZI_CONTROL_RATE / 1000.0f + 0.5f);
+        env_time_ticks[v] = ticks > 0 ? ticks : 1;
+    }
+    bend_ratio_init(SignalProcessor::PITCHBEND_RANGE_SEMITONES);
+    for (int v = 0; v < 128; v++) {
+        float cutoff = 30.0f * pow(5000.0f / 30.0f, v / 127.0f);
+        svf_cutoff_table[v] = (int32_t)(2.0f * sin(PI * cutoff / MOZZI_AUDIO_RATE) * 32768.0f + 0.5f);
+        float damping = 1.414f * pow(0.05f, v / 127.0f);
+        svf_damping_table[v] = (int32_t)(damping * 32768.0f + 0.5f);
+    }
+    for (int v = 0; v < 128; v++) {
+        // Peak deviation in radians to a phase offset (2^32 per cycle) per modulator step (peak 127)
+        float index = FM_MAX_INDEX * v / 127.0f;
+        fm_index_table[v] = (uint32_t)(index / (2.0f * PI) * 4294967296.0f / 127.0f);
+    }
+    for (int ch = 0; ch < MOZZI_AUDIO_CHANNELS; ch++) {
+        active[ch].count = 0;
+        pitchBend[ch] = bend_ratio_q16(0);
+        steal_policy[ch] = StealOldest;
+        waveform[ch] = WaveChebyshev;
+        voice_type[ch] = VoiceTable;
+        fm_ratio[ch] = FM_RATIOS_Q16[1];
+        fm_index[ch] = fm_index_table[32];
+        fm_index_cur[ch] = fm_index[ch];
+
+        // Filter bypassed; open, unresonant settings once it is switched on
+        filter_mode[ch] = SvfOff;
+        filter_f[ch] = svf_cutoff_table[127];
+        filter_damping[ch] = svf_damping_table[0];
+        filters[ch].f = filter_f[ch];
+        filters[ch].damping = filter_damping[ch];
+        filters[ch].reset();
+
+        // Short attack and release, full sustain: close to the old gate-like sound without clicks
+        env_params[ch].attack_ticks = env_time_ticks[10];
+        env_params[ch].decay_ticks = env_time_ticks[64];
+        env_params[ch].release_ticks = env_time_ticks[30];
+        env_params[ch].sustain_q15 = velocity_gain[127];
+    }
+
+    sample_bank.begin();
+    measure_voice_cost();
+
+    signal_processor->set_render_audio_callback(render_audio);
     signal_processor->set_event_callback(event_callback);
 }
@@ -0,0 +1,79 @@
+#include "sample_bank.h"
+#include <Arduino.h>
+#include <esp_partition.h>
+#include "../board.h"
+
+const char* SampleBank::PARTITION_LABEL = "samples";
+
+SampleBank::SampleBank()
+    : base(nullptr), size(0), entries(nullptr), count(0), mmap_handle(0), ready(false) {
+    for (int i = 0; i < 128; i++) {
+        note_index[i] = NO_SAMPLE;
+    }
+}
+
+bool SampleBank::begin(void) {
+    const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                                ESP_PARTITION_SUBTYPE_ANY, PARTITION_LABEL);
+    if (partition == nullptr) {
+        Serial.printf("sample bank: no \"%s\" partition\n", PARTITION_LABEL);
+        return false;
+    }
+
+    const void* ptr = nullptr;
+    esp_partition_mmap_handle_t handle;
+    esp_err_t err = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &ptr, &handle);
+    if (err != ESP_OK) {
+        Serial.printf("sample bank: failed to map partition, err=0x%x\n", err);
+        return false;
+    }
+
+    base = (const uint8_t*)ptr;
+    size = partition->size;
+    mmap_handle = handle;
+
+    const Header* header = (const Header*)base;
+    if (!validate(header)) {
+        // Erased or foreign data: keep the mapping, play nothing
+        return false;
+    }
+
+    entries = (const SampleEntry*)(base + sizeof(Header));
+    count = header->count;
+    for (uint16_t i = 0; i < count; i++) {
+        note_index[entries[i].note & 0x7f] = i;
+    }
+
+    ready = true;
+    Serial.printf("sample bank: %u samples, %u bytes mapped\n", count, size);
+    return true;
+}
+
+bool SampleBank::validate(const Header* header) const {
+    if (header->magic != MAGIC) {
+        Serial.printf("sample bank: partition not flashed\n");
+        return false;
+    }
+    if (header->version != VERSION || header->rate != PWM_FREQ || header->count > MAX_SAMPLES) {
+        Serial.printf("sample bank: unsupported image, version %u rate %u count %u\n",
+                      header->version, header->rate, header->count);
+        return false;
+    }
+    uint32_t index_end = sizeof(Header) + header->count * sizeof(SampleEntry);
+    if (index_end > size) {
+        Serial.printf("sample bank: index exceeds partition\n");
+        return false;
+    }
+
+    const SampleEntry* list = (const SampleEntry*)(base + sizeof(Header));
+    for (uint16_t i = 0; i < header->count; i++) {
+        const SampleEntry& e = list[i];
+        bool in_bounds = e.offset >= index_end && e.offset <= size && e.length <= size - e.offset;
+        bool loop_ok = !(e.flags & SampleLoop) || (e.loop_start < e.loop_end && e.loop_end <= e.length);
+        if (!in_bounds || !loop_ok || e.note >= 128) {
+            Serial.printf("sample bank: bad entry %u (note %u)\n", i, e.note);
+            return false;
+        }
+    }
+    return true;
+}
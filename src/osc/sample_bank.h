@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// One sample in the bank index. Layout is shared with scripts/pack_samples.py.
+struct SampleEntry {
+    uint8_t note;        // MIDI note that triggers the sample
+    uint8_t flags;       // SampleFlags
+    uint16_t reserved;
+    uint32_t offset;     // bytes from the start of the partition
+    uint32_t length;     // frames (signed 8 bit mono at PWM_FREQ)
+    uint32_t loop_start; // frames, valid with SampleLoop
+    uint32_t loop_end;   // frames, exclusive, valid with SampleLoop
+};
+
+static_assert(sizeof(SampleEntry) == 20, "SampleEntry layout is shared with pack_samples.py");
+
+enum SampleFlags : uint8_t {
+    SampleLoop = 1 << 0, // loop between loop_start and loop_end while sounding
+};
+
+// Samples packed by scripts/pack_samples.py into the "samples" data partition.
+// The partition is memory-mapped once, so voices read PCM straight from flash
+// through the cache and nothing is copied to RAM.
+//
+// Image: Header, count SampleEntry, then the PCM at the entry offsets.
+class SampleBank {
+public:
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t count;
+        uint32_t rate; // frames per second, must match the audio rate
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 16, "Header layout is shared with pack_samples.py");
+
+    static const uint32_t MAGIC = 0x31504d53; // "SMP1"
+    static const uint16_t VERSION = 1;
+    static const char* PARTITION_LABEL;
+    static const uint8_t NO_SAMPLE = 0xff;
+    static const int MAX_SAMPLES = 128;
+
+    SampleBank();
+
+    // Find, map and validate the partition. Returns false (bank stays empty) if
+    // the partition is missing, not flashed or inconsistent.
+    bool begin(void);
+
+    bool is_ready(void) const { return ready; }
+
+    // Sample for a note, nullptr if the note has none
+    inline const SampleEntry* get(uint8_t note) const {
+        if (note >= 128 || note_index[note] == NO_SAMPLE) return nullptr;
+        return &entries[note_index[note]];
+    }
+
+    inline const int8_t* get_data(const SampleEntry* entry) const {
+        return (const int8_t*)(base + entry->offset);
+    }
+
+    const uint8_t* get_base(void) const { return base; }
+    uint32_t get_size(void) const { return size; }
+    uint16_t get_count(void) const { return count; }
+
+private:
+    const uint8_t* base;
+    uint32_t size;
+    const SampleEntry* entries;
+    uint16_t count;
+    uint8_t note_index[128];
+    uint32_t mmap_handle;
+    bool ready;
+
+    bool validate(const Header* header) const;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stdint.h>
+
+enum SvfMode : uint8_t {
+    SvfOff, // bypass, costs nothing per sample
+    SvfLowPass,
+    SvfBandPass,
+    SvfHighPass,
+    SvfModeCount
+};
+
+// Chamberlin state-variable filter on 16 bit samples. Coefficients are Q15:
+// f = 2 sin(pi * cutoff / rate), damping = 1 / Q. Both come from tables built
+// at init, so the audio path is three multiplies and no trig. Stable while
+// f stays below about 1, i.e. cutoff up to rate / 6.
+struct Svf {
+    static const int32_t STATE_LIMIT = 1 << 20; // keeps products within 64 bit math and resonance bounded
+
+    int32_t low;
+    int32_t band;
+    int32_t f;       // Q15, used per sample
+    int32_t damping; // Q15, used per sample
+
+    Svf() : low(0), band(0), f(0), damping(0) {}
+
+    void reset(void) {
+        low = 0;
+        band = 0;
+    }
+
+    // Control tick: move the coefficients a step towards their targets so
+    // CC changes do not click
+    void smooth(int32_t target_f, int32_t target_damping) {
+        const int SMOOTH_SHIFT = 3;
+        f += (target_f - f) >> SMOOTH_SHIFT;
+        damping += (target_damping - damping) >> SMOOTH_SHIFT;
+    }
+
+    inline int32_t process(int32_t in, SvfMode mode) {
+        low += mul_q15(f, band);
+        int32_t high = in - low - mul_q15(damping, band);
+        band += mul_q15(f, high);
+        low = clamp(low);
+        band = clamp(band);
+
+        switch (mode) {
+            case SvfLowPass:  return low;
+            case SvfBandPass: return band;
+            case SvfHighPass: return high;
+            default:          return in;
+        }
+    }
+
+    static inline int32_t mul_q15(int32_t a, int32_t b) {
+        return (int32_t)(((int64_t)a * b) >> 15);
+    }
+
+    static inline int32_t clamp(int32_t v) {
+        if (v > STATE_LIMIT) return STATE_LIMIT;
+        if (v < -STATE_LIMIT) return -STATE_LIMIT;
+        return v;
+    }
+};
@@ -0,0 +1,754 @@
+#pragma once
+
+// Generated by scripts/gen_wavetables.py, do not edit.
+// Band-limited 256 cell tables, one mip per octave. Mip m holds at most
+// 128 >> m harmonics and is used for fundamentals up to 16384 / (128 >> m) Hz.
+
+#include <stdint.h>
+#include <mozzi_pgmspace.h>
+
+enum Waveform {
+    WaveSine,
+    WaveTriangle,
+    WaveSaw,
+    WaveSquare,
+    WaveChebyshev,
+    WaveCount
+};
+
+const int WAVE_CELLS = 256;
+const int WAVE_MIPS = 8;
+const uint32_t WAVE_NYQUIST = 16384;
+
+CONSTTABLE_STORAGE(int8_t) WAVETABLES[WaveCount][WAVE_MIPS][WAVE_CELLS] = {
+    { // Sine
+        { // mip 0, 127 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 1, 64 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 2, 32 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 3, 16 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 4, 8 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 5, 4 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 6, 2 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+        { // mip 7, 1 harmonics
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+        },
+    },
+    { // Triangle
+        { // mip 0, 127 harmonics
+            -127, -125, -123, -121, -119, -117, -115, -113, -111, -109, -107, -105, -103, -101, -99, -97,
+            -95, -93, -91, -89, -87, -85, -83, -81, -79, -77, -75, -73, -71, -69, -67, -65,
+            -64, -62, -60, -58, -56, -54, -52, -50, -48, -46, -44, -42, -40, -38, -36, -34,
+            -32, -30, -28, -26, -24, -22, -20, -18, -16, -14, -12, -10, -8, -6, -4, -2,
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+            32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62,
+            63, 65, 67, 69, 71, 73, 75, 77, 79, 81, 83, 85, 87, 89, 91, 93,
+            95, 97, 99, 101, 103, 105, 107, 109, 111, 113, 115, 117, 119, 121, 123, 125,
+            127, 125, 123, 121, 119, 117, 115, 113, 111, 109, 107, 105, 103, 101, 99, 97,
+            95, 93, 91, 89, 87, 85, 83, 81, 79, 77, 75, 73, 71, 69, 67, 65,
+            63, 62, 60, 58, 56, 54, 52, 50, 48, 46, 44, 42, 40, 38, 36, 34,
+            32, 30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2,
+            0, -2, -4, -6, -8, -10, -12, -14, -16, -18, -20, -22, -24, -26, -28, -30,
+            -32, -34, -36, -38, -40, -42, -44, -46, -48, -50, -52, -54, -56, -58, -60, -62,
+            -63, -65, -67, -69, -71, -73, -75, -77, -79, -81, -83, -85, -87, -89, -91, -93,
+            -95, -97, -99, -101, -103, -105, -107, -109, -111, -113, -115, -117, -119, -121, -123, -125,
+        },
+        { // mip 1, 64 harmonics
+            -127, -126, -124, -121, -120, -118, -116, -114, -112, -110, -108, -106, -104, -102, -100, -98,
+            -96, -94, -92, -90, -88, -86, -84, -82, -80, -78, -76, -74, -72, -70, -68, -66,
+            -64, -62, -60, -58, -56, -54, -52, -50, -48, -46, -44, -42, -40, -38, -36, -34,
+            -32, -30, -28, -26, -24, -22, -20, -18, -16, -14, -12, -10, -8, -6, -4, -2,
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+            32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62,
+            64, 66, 68, 70, 72, 74, 76, 78, 80, 82, 84, 86, 88, 90, 92, 94,
+            96, 98, 100, 102, 104, 106, 108, 110, 112, 114, 116, 118, 120, 121, 124, 126,
+            127, 126, 124, 121, 120, 118, 116, 114, 112, 110, 108, 106, 104, 102, 100, 98,
+            96, 94, 92, 90, 88, 86, 84, 82, 80, 78, 76, 74, 72, 70, 68, 66,
+            64, 62, 60, 58, 56, 54, 52, 50, 48, 46, 44, 42, 40, 38, 36, 34,
+            32, 30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2,
+            0, -2, -4, -6, -8, -10, -12, -14, -16, -18, -20, -22, -24, -26, -28, -30,
+            -32, -34, -36, -38, -40, -42, -44, -46, -48, -50, -52, -54, -56, -58, -60, -62,
+            -64, -66, -68, -70, -72, -74, -76, -78, -80, -82, -84, -86, -88, -90, -92, -94,
+            -96, -98, -100, -102, -104, -106, -108, -110, -112, -114, -116, -118, -120, -121, -124, -126,
+        },
+        { // mip 2, 32 harmonics
+            -127, -126, -125, -123, -121, -118, -116, -114, -112, -111, -109, -107, -104, -102, -100, -98,
+            -96, -94, -93, -90, -88, -86, -84, -82, -80, -78, -76, -74, -72, -70, -68, -66,
+            -64, -62, -60, -58, -56, -54, -52, -50, -48, -46, -44, -42, -40, -38, -36, -34,
+            -32, -30, -28, -26, -24, -22, -20, -18, -16, -14, -12, -10, -8, -6, -4, -2,
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30,
+            32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62,
+            64, 66, 68, 70, 72, 74, 76, 78, 80, 82, 84, 86, 88, 90, 93, 94,
+            96, 98, 100, 102, 104, 107, 109, 111, 112, 114, 116, 118, 121, 123, 125, 126,
+            127, 126, 125, 123, 121, 118, 116, 114, 112, 111, 109, 107, 104, 102, 100, 98,
+            96, 94, 93, 90, 88, 86, 84, 82, 80, 78, 76, 74, 72, 70, 68, 66,
+            64, 62, 60, 58, 56, 54, 52, 50, 48, 46, 44, 42, 40, 38, 36, 34,
+            32, 30, 28, 26, 24, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2,
+            0, -2, -4, -6, -8, -10, -12, -14, -16, -18, -20, -22, -24, -26, -28, -30,
+            -32, -34, -36, -38, -40, -42, -44, -46, -48, -50, -52, -54, -56, -58, -60, -62,
+            -64, -66, -68, -70, -72, -74, -76, -78, -80, -82, -84, -86, -88, -90, -93, -94,
+            -96, -98, -100, -102, -104, -107, -109, -111, -112, -114, -116, -118, -121, -123, -125, -126,
+        },
+        { // mip 3, 16 harmonics
+            -127, -127, -126, -125, -123, -121, -119, -117, -114, -112, -110, -107, -105, -103, -101, -99,
+            -98, -96, -94, -92, -90, -88, -86, -84, -81, -79, -77, -75, -73, -71, -69, -67,
+            -65, -63, -61, -59, -57, -55, -53, -51, -49, -47, -45, -43, -40, -38, -36, -35,
+            -33, -31, -29, -27, -25, -23, -21, -18, -16, -14, -12, -10, -8, -6, -4, -2,
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 21, 23, 25, 27, 29, 31,
+            33, 35, 36, 38, 40, 43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63,
+            65, 67, 69, 71, 73, 75, 77, 79, 81, 84, 86, 88, 90, 92, 94, 96,
+            98, 99, 101, 103, 105, 107, 110, 112, 114, 117, 119, 121, 123, 125, 126, 127,
+            127, 127, 126, 125, 123, 121, 119, 117, 114, 112, 110, 107, 105, 103, 101, 99,
+            98, 96, 94, 92, 90, 88, 86, 84, 81, 79, 77, 75, 73, 71, 69, 67,
+            65, 63, 61, 59, 57, 55, 53, 51, 49, 47, 45, 43, 40, 38, 36, 35,
+            33, 31, 29, 27, 25, 23, 21, 18, 16, 14, 12, 10, 8, 6, 4, 2,
+            0, -2, -4, -6, -8, -10, -12, -14, -16, -18, -21, -23, -25, -27, -29, -31,
+            -33, -35, -36, -38, -40, -43, -45, -47, -49, -51, -53, -55, -57, -59, -61, -63,
+            -65, -67, -69, -71, -73, -75, -77, -79, -81, -84, -86, -88, -90, -92, -94, -96,
+            -98, -99, -101, -103, -105, -107, -110, -112, -114, -117, -119, -121, -123, -125, -126, -127,
+        },
+        { // mip 4, 8 harmonics
+            -127, -127, -126, -126, -125, -124, -122, -121, -119, -117, -115, -113, -111, -108, -106, -104,
+            -101, -99, -96, -94, -91, -89, -87, -84, -82, -80, -78, -76, -74, -72, -70, -68,
+            -67, -65, -63, -61, -59, -57, -55, -53, -51, -49, -47, -45, -43, -40, -38, -36,
+            -34, -31, -29, -27, -25, -22, -20, -18, -16, -14, -12, -10, -8, -6, -4, -2,
+            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 25, 27, 29, 31,
+            34, 36, 38, 40, 43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63, 65,
+            67, 68, 70, 72, 74, 76, 78, 80, 82, 84, 87, 89, 91, 94, 96, 99,
+            101, 104, 106, 108, 111, 113, 115, 117, 119, 121, 122, 124, 125, 126, 126, 127,
+            127, 127, 126, 126, 125, 124, 122, 121, 119, 117, 115, 113, 111, 108, 106, 104,
+            101, 99, 96, 94, 91, 89, 87, 84, 82, 80, 78, 76, 74, 72, 70, 68,
+            67, 65, 63, 61, 59, 57, 55, 53, 51, 49, 47, 45, 43, 40, 38, 36,
+            34, 31, 29, 27, 25, 22, 20, 18, 16, 14, 12, 10, 8, 6, 4, 2,
+            0, -2, -4, -6, -8, -10, -12, -14, -16, -18, -20, -22, -25, -27, -29, -31,
+            -34, -36, -38, -40, -43, -45, -47, -49, -51, -53, -55, -57, -59, -61, -63, -65,
+            -67, -68, -70, -72, -74, -76, -78, -80, -82, -84, -87, -89, -91, -94, -96, -99,
+            -101, -104, -106, -108, -111, -113, -115, -117, -119, -121, -122, -124, -125, -126, -126, -127,
+        },
+        { // mip 5, 4 harmonics
+            -127, -127, -127, -126, -126, -125, -125, -124, -123, -122, -120, -119, -117, -116, -114, -112,
+            -110, -108, -106, -104, -102, -100, -97, -95, -93, -90, -88, -85, -82, -80, -77, -74,
+            -72, -69, -67, -64, -61, -59, -56, -54, -51, -49, -46, -44, -41, -39, -37, -34,
+            -32, -30, -28, -25, -23, -21, -19, -17, -15, -13, -11, -9, -8, -6, -4, -2,
+            0, 2, 4, 6, 8, 9, 11, 13, 15, 17, 19, 21, 23, 25, 28, 30,
+            32, 34, 37, 39, 41, 44, 46, 49, 51, 54, 56, 59, 61, 64, 67, 69,
+            72, 74, 77, 80, 82, 85, 88, 90, 93, 95, 97, 100, 102, 104, 106, 108,
+            110, 112, 114, 116, 117, 119, 120, 122, 123, 124, 125, 125, 126, 126, 127, 127,
+            127, 127, 127, 126, 126, 125, 125, 124, 123, 122, 120, 119, 117, 116, 114, 112,
+            110, 108, 106, 104, 102, 100, 97, 95, 93, 90, 88, 85, 82, 80, 77, 74,
+            72, 69, 67, 64, 61, 59, 56, 54, 51, 49, 46, 44, 41, 39, 37, 34,
+            32, 30, 28, 25, 23, 21, 19, 17, 15, 13, 11, 9, 8, 6, 4, 2,
+            0, -2, -4, -6, -8, -9, -11, -13, -15, -17, -19, -21, -23, -25, -28, -30,
+            -32, -34, -37, -39, -41, -44, -46, -49, -51, -54, -56, -59, -61, -64, -67, -69,
+            -72, -74, -77, -80, -82, -85, -88, -90, -93, -95, -97, -100, -102, -104, -106, -108,
+            -110, -112, -114, -116, -117, -119, -120, -122, -123, -124, -125, -125, -126, -126, -127, -127,
+        },
+        { // mip 6, 2 harmonics
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+        },
+        { // mip 7, 1 harmonics
+            -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+            -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+            -90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+            -49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3,
+            0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+            49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+            90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+            117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+            117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+            90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+            49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+            0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+            -49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+            -90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+            -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+        },
+    },
+    { // Saw
+        { // mip 0, 127 harmonics
+            -127, -127, -125, -125, -123, -123, -121, -121, -119, -119, -117, -117, -115, -115, -113, -113,
+            -111, -111, -109, -109, -107, -107, -105, -105, -103, -103, -101, -101, -99, -99, -97, -97,
+            -95, -95, -93, -93, -91, -91, -89, -89, -87, -87, -85, -85, -83, -83, -81, -81,
+            -79, -79, -77, -77, -75, -75, -73, -73, -71, -71, -69, -69, -67, -67, -65, -65,
+            -63, -63, -61, -61, -59, -59, -57, -57, -55, -55, -53, -53, -51, -51, -49, -49,
+            -47, -47, -45, -45, -43, -43, -41, -41, -39, -39, -37, -37, -35, -35, -33, -33,
+            -31, -31, -29, -29, -27, -27, -25, -25, -23, -23, -21, -21, -19, -19, -17, -17,
+            -15, -15, -13, -13, -11, -11, -9, -9, -7, -7, -5, -5, -3, -3, -1, -1,
+            1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15,
+            17, 17, 19, 19, 21, 21, 23, 23, 25, 25, 27, 27, 29, 29, 31, 31,
+            33, 33, 35, 35, 37, 37, 39, 39, 41, 41, 43, 43, 45, 45, 47, 47,
+            49, 49, 51, 51, 53, 53, 55, 55, 57, 57, 59, 59, 61, 61, 63, 63,
+            65, 65, 67, 67, 69, 69, 71, 71, 73, 73, 75, 75, 77, 77, 79, 79,
+            81, 81, 83, 83, 85, 85, 87, 87, 89, 89, 91, 91, 93, 93, 95, 95,
+            97, 97, 99, 99, 101, 101, 103, 103, 105, 105, 107, 107, 109, 109, 111, 111,
+            113, 113, 115, 115, 117, 117, 119, 119, 121, 121, 123, 123, 125, 125, 127, 127,
+        },
+        { // mip 1, 64 harmonics
+            -56, -127, -125, -100, -100, -114, -112, -101, -101, -108, -106, -99, -99, -104, -102, -96,
+            -96, -100, -98, -93, -93, -96, -94, -90, -90, -92, -90, -87, -87, -88, -86, -83,
+            -83, -84, -83, -80, -80, -81, -79, -77, -77, -77, -75, -73, -73, -74, -72, -70,
+            -70, -70, -68, -66, -66, -66, -65, -63, -63, -63, -61, -59, -59, -59, -58, -56,
+            -56, -56, -54, -52, -52, -52, -50, -49, -49, -49, -47, -45, -45, -45, -43, -42,
+            -42, -42, -40, -38, -38, -38, -36, -35, -35, -35, -33, -31, -31, -31, -29, -28,
+            -28, -27, -26, -24, -24, -24, -22, -21, -21, -20, -19, -17, -17, -17, -15, -14,
+            -14, -13, -12, -10, -10, -10, -8, -7, -7, -6, -4, -3, -3, -3, -1, 0,
+            0, 1, 3, 3, 3, 4, 6, 7, 7, 8, 10, 10, 10, 12, 13, 14,
+            14, 15, 17, 17, 17, 19, 20, 21, 21, 22, 24, 24, 24, 26, 27, 28,
+            28, 29, 31, 31, 31, 33, 35, 35, 35, 36, 38, 38, 38, 40, 42, 42,
+            42, 43, 45, 45, 45, 47, 49, 49, 49, 50, 52, 52, 52, 54, 56, 56,
+            56, 58, 59, 59, 59, 61, 63, 63, 63, 65, 66, 66, 66, 68, 70, 70,
+            70, 72, 74, 73, 73, 75, 77, 77, 77, 79, 81, 80, 80, 83, 84, 83,
+            83, 86, 88, 87, 87, 90, 92, 90, 90, 94, 96, 93, 93, 98, 100, 96,
+            96, 102, 104, 99, 99, 106, 108, 101, 101, 112, 114, 100, 100, 125, 127, 56,
+        },
+        { // mip 2, 32 harmonics
+            -28, -77, -112, -127, -125, -114, -101, -94, -94, -99, -105, -108, -107, -101, -95, -92,
+            -92, -95, -97, -99, -97, -93, -89, -87, -87, -88, -90, -90, -89, -86, -82, -81,
+            -81, -82, -83, -83, -81, -78, -76, -74, -74, -75, -76, -75, -74, -71, -69, -68,
+            -68, -68, -69, -68, -66, -64, -62, -61, -61, -62, -62, -61, -59, -57, -55, -54,
+            -54, -55, -55, -54, -52, -50, -48, -48, -48, -48, -48, -47, -45, -43, -42, -41,
+            -41, -41, -41, -40, -38, -36, -35, -34, -34, -34, -34, -33, -31, -29, -28, -27,
+            -27, -27, -27, -26, -24, -22, -21, -20, -20, -20, -20, -18, -17, -15, -14, -14,
+            -14, -14, -13, -11, -10, -8, -7, -7, -7, -7, -6, -4, -3, -1, 0, 0,
+            0, 0, 1, 3, 4, 6, 7, 7, 7, 7, 8, 10, 11, 13, 14, 14,
+            14, 14, 15, 17, 18, 20, 20, 20, 20, 21, 22, 24, 26, 27, 27, 27,
+            27, 28, 29, 31, 33, 34, 34, 34, 34, 35, 36, 38, 40, 41, 41, 41,
+            41, 42, 43, 45, 47, 48, 48, 48, 48, 48, 50, 52, 54, 55, 55, 54,
+            54, 55, 57, 59, 61, 62, 62, 61, 61, 62, 64, 66, 68, 69, 68, 68,
+            68, 69, 71, 74, 75, 76, 75, 74, 74, 76, 78, 81, 83, 83, 82, 81,
+            81, 82, 86, 89, 90, 90, 88, 87, 87, 89, 93, 97, 99, 97, 95, 92,
+            92, 95, 101, 107, 108, 105, 99, 94, 94, 101, 114, 125, 127, 112, 77, 28,
+        },
+        { // mip 3, 16 harmonics
+            -14, -42, -67, -89, -106, -118, -125, -127, -125, -120, -114, -107, -100, -94, -90, -88,
+            -88, -90, -92, -95, -98, -100, -101, -100, -98, -96, -92, -89, -85, -82, -81, -80,
+            -80, -80, -82, -83, -84, -84, -84, -83, -81, -79, -76, -74, -71, -69, -68, -67,
+            -67, -68, -69, -69, -69, -69, -69, -67, -66, -63, -61, -59, -57, -56, -55, -54,
+            -54, -55, -55, -55, -55, -55, -54, -52, -50, -49, -47, -45, -43, -42, -41, -41,
+            -41, -41, -41, -41, -41, -40, -39, -37, -36, -34, -32, -30, -29, -28, -28, -27,
+            -27, -27, -27, -27, -27, -26, -24, -23, -21, -19, -18, -16, -15, -14, -14, -14,
+            -14, -14, -14, -13, -12, -11, -10, -8, -6, -5, -3, -2, -1, 0, 0, 0,
+            0, 0, 0, 1, 2, 3, 5, 6, 8, 10, 11, 12, 13, 14, 14, 14,
+            14, 14, 14, 15, 16, 18, 19, 21, 23, 24, 26, 27, 27, 27, 27, 27,
+            27, 28, 28, 29, 30, 32, 34, 36, 37, 39, 40, 41, 41, 41, 41, 41,
+            41, 41, 42, 43, 45, 47, 49, 50, 52, 54, 55, 55, 55, 55, 55, 54,
+            54, 55, 56, 57, 59, 61, 63, 66, 67, 69, 69, 69, 69, 69, 68, 67,
+            67, 68, 69, 71, 74, 76, 79, 81, 83, 84, 84, 84, 83, 82, 80, 80,
+            80, 81, 82, 85, 89, 92, 96, 98, 100, 101, 100, 98, 95, 92, 90, 88,
+            88, 90, 94, 100, 107, 114, 120, 125, 127, 125, 118, 106, 89, 67, 42, 14,
+        },
+        { // mip 4, 8 harmonics
+            -7, -22, -37, -51, -64, -76, -87, -97, -105, -112, -118, -122, -125, -127, -127, -126,
+            -124, -122, -118, -114, -110, -106, -101, -97, -93, -89, -86, -84, -81, -80, -79, -78,
+            -78, -79, -80, -81, -82, -83, -84, -85, -86, -86, -87, -86, -86, -85, -84, -82,
+            -80, -78, -76, -74, -71, -69, -66, -64, -62, -60, -59, -57, -56, -56, -55, -55,
+            -55, -55, -55, -56, -56, -56, -56, -56, -56, -56, -55, -54, -53, -52, -50, -49,
+            -47, -45, -43, -41, -39, -37, -35, -34, -32, -31, -30, -29, -29, -28, -28, -28,
+            -28, -28, -28, -28, -28, -28, -28, -27, -26, -26, -25, -23, -22, -20, -19, -17,
+            -15, -13, -11, -9, -8, -6, -5, -4, -3, -2, -1, -1, 0, 0, 0, 0,
+            0, 0, 0, 0, 1, 1, 2, 3, 4, 5, 6, 8, 9, 11, 13, 15,
+            17, 19, 20, 22, 23, 25, 26, 26, 27, 28, 28, 28, 28, 28, 28, 28,
+            28, 28, 28, 29, 29, 30, 31, 32, 34, 35, 37, 39, 41, 43, 45, 47,
+            49, 50, 52, 53, 54, 55, 56, 56, 56, 56, 56, 56, 56, 55, 55, 55,
+            55, 55, 56, 56, 57, 59, 60, 62, 64, 66, 69, 71, 74, 76, 78, 80,
+            82, 84, 85, 86, 86, 87, 86, 86, 85, 84, 83, 82, 81, 80, 79, 78,
+            78, 79, 80, 81, 84, 86, 89, 93, 97, 101, 106, 110, 114, 118, 122, 124,
+            126, 127, 127, 125, 122, 118, 112, 105, 97, 87, 76, 64, 51, 37, 22, 7,
+        },
+        { // mip 5, 4 harmonics
+            -4, -12, -20, -28, -36, -44, -51, -59, -66, -72, -79, -85, -91, -96, -101, -106,
+            -110, -113, -117, -119, -122, -124, -125, -126, -127, -127, -127, -126, -125, -124, -123, -121,
+            -119, -117, -114, -112, -109, -106, -103, -100, -97, -94, -91, -87, -84, -82, -79, -76,
+            -74, -71, -69, -67, -65, -63, -62, -60, -59, -58, -57, -57, -56, -56, -56, -55,
+            -55, -56, -56, -56, -56, -57, -57, -57, -57, -58, -58, -58, -58, -58, -58, -58,
+            -57, -57, -56, -56, -55, -54, -53, -51, -50, -49, -47, -45, -44, -42, -40, -38,
+            -36, -34, -32, -30, -27, -25, -23, -21, -19, -17, -16, -14, -12, -11, -9, -8,
+            -7, -6, -5, -4, -3, -2, -2, -1, -1, -1, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 4, 5, 6, 7,
+            8, 9, 11, 12, 14, 16, 17, 19, 21, 23, 25, 27, 30, 32, 34, 36,
+            38, 40, 42, 44, 45, 47, 49, 50, 51, 53, 54, 55, 56, 56, 57, 57,
+            58, 58, 58, 58, 58, 58, 58, 57, 57, 57, 57, 56, 56, 56, 56, 55,
+            55, 56, 56, 56, 57, 57, 58, 59, 60, 62, 63, 65, 67, 69, 71, 74,
+            76, 79, 82, 84, 87, 91, 94, 97, 100, 103, 106, 109, 112, 114, 117, 119,
+            121, 123, 124, 125, 126, 127, 127, 127, 126, 125, 124, 122, 119, 117, 113, 110,
+            106, 101, 96, 91, 85, 79, 72, 66, 59, 51, 44, 36, 28, 20, 12, 4,
+        },
+        { // mip 6, 2 harmonics
+            -2, -7, -12, -17, -21, -26, -31, -35, -40, -45, -49, -53, -58, -62, -66, -70,
+            -74, -78, -81, -85, -88, -92, -95, -98, -101, -104, -106, -109, -111, -113, -115, -117,
+            -119, -120, -122, -123, -124, -125, -126, -126, -127, -127, -127, -127, -127, -126, -126, -125,
+            -124, -124, -123, -121, -120, -119, -117, -115, -114, -112, -110, -108, -106, -104, -101, -99,
+            -97, -94, -92, -89, -86, -84, -81, -79, -76, -73, -70, -68, -65, -62, -60, -57,
+            -54, -52, -49, -47, -44, -42, -40, -37, -35, -33, -31, -29, -27, -25, -23, -21,
+            -19, -18, -16, -15, -13, -12, -11, -10, -9, -8, -7, -6, -5, -4, -4, -3,
+            -3, -2, -2, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3,
+            3, 4, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 16, 18, 19,
+            21, 23, 25, 27, 29, 31, 33, 35, 37, 40, 42, 44, 47, 49, 52, 54,
+            57, 60, 62, 65, 68, 70, 73, 76, 79, 81, 84, 86, 89, 92, 94, 97,
+            99, 101, 104, 106, 108, 110, 112, 114, 115, 117, 119, 120, 121, 123, 124, 124,
+            125, 126, 126, 127, 127, 127, 127, 127, 126, 126, 125, 124, 123, 122, 120, 119,
+            117, 115, 113, 111, 109, 106, 104, 101, 98, 95, 92, 88, 85, 81, 78, 74,
+            70, 66, 62, 58, 53, 49, 45, 40, 35, 31, 26, 21, 17, 12, 7, 2,
+        },
+        { // mip 7, 1 harmonics
+            -2, -5, -8, -11, -14, -17, -20, -23, -26, -29, -32, -35, -38, -41, -44, -47,
+            -50, -53, -56, -58, -61, -64, -67, -69, -72, -74, -77, -79, -82, -84, -86, -89,
+            -91, -93, -95, -97, -99, -101, -103, -105, -106, -108, -110, -111, -113, -114, -115, -117,
+            -118, -119, -120, -121, -122, -123, -124, -124, -125, -125, -126, -126, -127, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -125, -125, -124, -124, -123, -122, -121, -120, -119, -118,
+            -117, -115, -114, -113, -111, -110, -108, -106, -105, -103, -101, -99, -97, -95, -93, -91,
+            -89, -86, -84, -82, -79, -77, -74, -72, -69, -67, -64, -61, -58, -56, -53, -50,
+            -47, -44, -41, -38, -35, -32, -29, -26, -23, -20, -17, -14, -11, -8, -5, -2,
+            2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+            50, 53, 56, 58, 61, 64, 67, 69, 72, 74, 77, 79, 82, 84, 86, 89,
+            91, 93, 95, 97, 99, 101, 103, 105, 106, 108, 110, 111, 113, 114, 115, 117,
+            118, 119, 120, 121, 122, 123, 124, 124, 125, 125, 126, 126, 127, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 125, 125, 124, 124, 123, 122, 121, 120, 119, 118,
+            117, 115, 114, 113, 111, 110, 108, 106, 105, 103, 101, 99, 97, 95, 93, 91,
+            89, 86, 84, 82, 79, 77, 74, 72, 69, 67, 64, 61, 58, 56, 53, 50,
+            47, 44, 41, 38, 35, 32, 29, 26, 23, 20, 17, 14, 11, 8, 5, 2,
+        },
+    },
+    { // Square
+        { // mip 0, 127 harmonics
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+            -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127,
+        },
+        { // mip 1, 64 harmonics
+            56, 127, 127, 103, 103, 118, 118, 107, 107, 115, 115, 109, 109, 114, 114, 109,
+            109, 114, 114, 110, 110, 113, 113, 110, 110, 113, 113, 110, 110, 113, 113, 110,
+            110, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111,
+            111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111,
+            111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111,
+            111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 111, 111, 113, 113, 110,
+            110, 113, 113, 110, 110, 113, 113, 110, 110, 113, 113, 110, 110, 114, 114, 109,
+            109, 114, 114, 109, 109, 115, 115, 107, 107, 118, 118, 103, 103, 127, 127, 56,
+            -56, -127, -127, -103, -103, -118, -118, -107, -107, -115, -115, -109, -109, -114, -114, -109,
+            -109, -114, -114, -110, -110, -113, -113, -110, -110, -113, -113, -110, -110, -113, -113, -110,
+            -110, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111,
+            -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111,
+            -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111,
+            -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -111, -111, -113, -113, -110,
+            -110, -113, -113, -110, -110, -113, -113, -110, -110, -113, -113, -110, -110, -114, -114, -109,
+            -109, -114, -114, -109, -109, -115, -115, -107, -107, -118, -118, -103, -103, -127, -127, -56,
+        },
+        { // mip 2, 32 harmonics
+            27, 76, 111, 127, 127, 117, 106, 99, 99, 104, 111, 116, 116, 112, 107, 103,
+            103, 106, 110, 113, 113, 111, 107, 105, 105, 107, 110, 112, 112, 110, 108, 106,
+            106, 107, 110, 111, 111, 110, 108, 106, 106, 108, 110, 111, 111, 110, 108, 106,
+            106, 108, 110, 111, 111, 110, 108, 107, 107, 108, 110, 111, 111, 110, 108, 107,
+            107, 108, 110, 111, 111, 110, 108, 107, 107, 108, 110, 111, 111, 110, 108, 106,
+            106, 108, 110, 111, 111, 110, 108, 106, 106, 108, 110, 111, 111, 110, 107, 106,
+            106, 108, 110, 112, 112, 110, 107, 105, 105, 107, 111, 113, 113, 110, 106, 103,
+            103, 107, 112, 116, 116, 111, 104, 99, 99, 106, 117, 127, 127, 111, 76, 27,
+            -27, -76, -111, -127, -127, -117, -106, -99, -99, -104, -111, -116, -116, -112, -107, -103,
+            -103, -106, -110, -113, -113, -111, -107, -105, -105, -107, -110, -112, -112, -110, -108, -106,
+            -106, -107, -110, -111, -111, -110, -108, -106, -106, -108, -110, -111, -111, -110, -108, -106,
+            -106, -108, -110, -111, -111, -110, -108, -107, -107, -108, -110, -111, -111, -110, -108, -107,
+            -107, -108, -110, -111, -111, -110, -108, -107, -107, -108, -110, -111, -111, -110, -108, -106,
+            -106, -108, -110, -111, -111, -110, -108, -106, -106, -108, -110, -111, -111, -110, -107, -106,
+            -106, -108, -110, -112, -112, -110, -107, -105, -105, -107, -111, -113, -113, -110, -106, -103,
+            -103, -107, -112, -116, -116, -111, -104, -99, -99, -106, -117, -127, -127, -111, -76, -27,
+        },
+        { // mip 3, 16 harmonics
+            13, 40, 64, 85, 102, 115, 123, 127, 127, 124, 119, 113, 108, 103, 99, 97,
+            97, 99, 102, 105, 109, 112, 114, 115, 115, 114, 112, 110, 107, 105, 103, 102,
+            102, 103, 104, 106, 109, 111, 112, 113, 113, 112, 111, 109, 107, 105, 104, 103,
+            103, 104, 105, 107, 109, 110, 111, 112, 112, 111, 110, 109, 107, 105, 104, 104,
+            104, 104, 105, 107, 109, 110, 111, 112, 112, 111, 110, 109, 107, 105, 104, 103,
+            103, 104, 105, 107, 109, 111, 112, 113, 113, 112, 111, 109, 106, 104, 103, 102,
+            102, 103, 105, 107, 110, 112, 114, 115, 115, 114, 112, 109, 105, 102, 99, 97,
+            97, 99, 103, 108, 113, 119, 124, 127, 127, 123, 115, 102, 85, 64, 40, 13,
+            -13, -40, -64, -85, -102, -115, -123, -127, -127, -124, -119, -113, -108, -103, -99, -97,
+            -97, -99, -102, -105, -109, -112, -114, -115, -115, -114, -112, -110, -107, -105, -103, -102,
+            -102, -103, -104, -106, -109, -111, -112, -113, -113, -112, -111, -109, -107, -105, -104, -103,
+            -103, -104, -105, -107, -109, -110, -111, -112, -112, -111, -110, -109, -107, -105, -104, -104,
+            -104, -104, -105, -107, -109, -110, -111, -112, -112, -111, -110, -109, -107, -105, -104, -103,
+            -103, -104, -105, -107, -109, -111, -112, -113, -113, -112, -111, -109, -106, -104, -103, -102,
+            -102, -103, -105, -107, -110, -112, -114, -115, -115, -114, -112, -109, -105, -102, -99, -97,
+            -97, -99, -103, -108, -113, -119, -124, -127, -127, -123, -115, -102, -85, -64, -40, -13,
+        },
+        { // mip 4, 8 harmonics
+            7, 20, 33, 46, 58, 69, 80, 89, 98, 106, 112, 117, 121, 124, 126, 127,
+            127, 126, 125, 123, 120, 117, 114, 111, 108, 105, 103, 100, 99, 97, 96, 96,
+            96, 96, 97, 98, 100, 102, 104, 106, 108, 109, 111, 113, 114, 115, 116, 116,
+            116, 116, 115, 114, 113, 112, 110, 108, 107, 105, 103, 102, 101, 100, 99, 99,
+            99, 99, 100, 101, 102, 103, 105, 107, 108, 110, 112, 113, 114, 115, 116, 116,
+            116, 116, 115, 114, 113, 111, 109, 108, 106, 104, 102, 100, 98, 97, 96, 96,
+            96, 96, 97, 99, 100, 103, 105, 108, 111, 114, 117, 120, 123, 125, 126, 127,
+            127, 126, 124, 121, 117, 112, 106, 98, 89, 80, 69, 58, 46, 33, 20, 7,
+            -7, -20, -33, -46, -58, -69, -80, -89, -98, -106, -112, -117, -121, -124, -126, -127,
+            -127, -126, -125, -123, -120, -117, -114, -111, -108, -105, -103, -100, -99, -97, -96, -96,
+            -96, -96, -97, -98, -100, -102, -104, -106, -108, -109, -111, -113, -114, -115, -116, -116,
+            -116, -116, -115, -114, -113, -112, -110, -108, -107, -105, -103, -102, -101, -100, -99, -99,
+            -99, -99, -100, -101, -102, -103, -105, -107, -108, -110, -112, -113, -114, -115, -116, -116,
+            -116, -116, -115, -114, -113, -111, -109, -108, -106, -104, -102, -100, -98, -97, -96, -96,
+            -96, -96, -97, -99, -100, -103, -105, -108, -111, -114, -117, -120, -123, -125, -126, -127,
+            -127, -126, -124, -121, -117, -112, -106, -98, -89, -80, -69, -58, -46, -33, -20, -7,
+        },
+        { // mip 5, 4 harmonics
+            3, 10, 16, 23, 29, 36, 42, 48, 54, 60, 66, 71, 76, 81, 86, 91,
+            95, 99, 103, 107, 110, 113, 115, 118, 120, 122, 123, 125, 126, 126, 127, 127,
+            127, 127, 126, 126, 125, 124, 123, 121, 120, 119, 117, 115, 114, 112, 110, 108,
+            106, 105, 103, 101, 100, 98, 97, 95, 94, 93, 92, 91, 91, 90, 90, 90,
+            90, 90, 90, 91, 91, 92, 93, 94, 95, 97, 98, 100, 101, 103, 105, 106,
+            108, 110, 112, 114, 115, 117, 119, 120, 121, 123, 124, 125, 126, 126, 127, 127,
+            127, 127, 126, 126, 125, 123, 122, 120, 118, 115, 113, 110, 107, 103, 99, 95,
+            91, 86, 81, 76, 71, 66, 60, 54, 48, 42, 36, 29, 23, 16, 10, 3,
+            -3, -10, -16, -23, -29, -36, -42, -48, -54, -60, -66, -71, -76, -81, -86, -91,
+            -95, -99, -103, -107, -110, -113, -115, -118, -120, -122, -123, -125, -126, -126, -127, -127,
+            -127, -127, -126, -126, -125, -124, -123, -121, -120, -119, -117, -115, -114, -112, -110, -108,
+            -106, -105, -103, -101, -100, -98, -97, -95, -94, -93, -92, -91, -91, -90, -90, -90,
+            -90, -90, -90, -91, -91, -92, -93, -94, -95, -97, -98, -100, -101, -103, -105, -106,
+            -108, -110, -112, -114, -115, -117, -119, -120, -121, -123, -124, -125, -126, -126, -127, -127,
+            -127, -127, -126, -126, -125, -123, -122, -120, -118, -115, -113, -110, -107, -103, -99, -95,
+            -91, -86, -81, -76, -71, -66, -60, -54, -48, -42, -36, -29, -23, -16, -10, -3,
+        },
+        { // mip 6, 2 harmonics
+            2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+            50, 53, 56, 58, 61, 64, 67, 69, 72, 74, 77, 79, 82, 84, 86, 89,
+            91, 93, 95, 97, 99, 101, 103, 105, 106, 108, 110, 111, 113, 114, 115, 117,
+            118, 119, 120, 121, 122, 123, 124, 124, 125, 125, 126, 126, 127, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 125, 125, 124, 124, 123, 122, 121, 120, 119, 118,
+            117, 115, 114, 113, 111, 110, 108, 106, 105, 103, 101, 99, 97, 95, 93, 91,
+            89, 86, 84, 82, 79, 77, 74, 72, 69, 67, 64, 61, 58, 56, 53, 50,
+            47, 44, 41, 38, 35, 32, 29, 26, 23, 20, 17, 14, 11, 8, 5, 2,
+            -2, -5, -8, -11, -14, -17, -20, -23, -26, -29, -32, -35, -38, -41, -44, -47,
+            -50, -53, -56, -58, -61, -64, -67, -69, -72, -74, -77, -79, -82, -84, -86, -89,
+            -91, -93, -95, -97, -99, -101, -103, -105, -106, -108, -110, -111, -113, -114, -115, -117,
+            -118, -119, -120, -121, -122, -123, -124, -124, -125, -125, -126, -126, -127, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -125, -125, -124, -124, -123, -122, -121, -120, -119, -118,
+            -117, -115, -114, -113, -111, -110, -108, -106, -105, -103, -101, -99, -97, -95, -93, -91,
+            -89, -86, -84, -82, -79, -77, -74, -72, -69, -67, -64, -61, -58, -56, -53, -50,
+            -47, -44, -41, -38, -35, -32, -29, -26, -23, -20, -17, -14, -11, -8, -5, -2,
+        },
+        { // mip 7, 1 harmonics
+            2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 32, 35, 38, 41, 44, 47,
+            50, 53, 56, 58, 61, 64, 67, 69, 72, 74, 77, 79, 82, 84, 86, 89,
+            91, 93, 95, 97, 99, 101, 103, 105, 106, 108, 110, 111, 113, 114, 115, 117,
+            118, 119, 120, 121, 122, 123, 124, 124, 125, 125, 126, 126, 127, 127, 127, 127,
+            127, 127, 127, 127, 126, 126, 125, 125, 124, 124, 123, 122, 121, 120, 119, 118,
+            117, 115, 114, 113, 111, 110, 108, 106, 105, 103, 101, 99, 97, 95, 93, 91,
+            89, 86, 84, 82, 79, 77, 74, 72, 69, 67, 64, 61, 58, 56, 53, 50,
+            47, 44, 41, 38, 35, 32, 29, 26, 23, 20, 17, 14, 11, 8, 5, 2,
+            -2, -5, -8, -11, -14, -17, -20, -23, -26, -29, -32, -35, -38, -41, -44, -47,
+            -50, -53, -56, -58, -61, -64, -67, -69, -72, -74, -77, -79, -82, -84, -86, -89,
+            -91, -93, -95, -97, -99, -101, -103, -105, -106, -108, -110, -111, -113, -114, -115, -117,
+            -118, -119, -120, -121, -122, -123, -124, -124, -125, -125, -126, -126, -127, -127, -127, -127,
+            -127, -127, -127, -127, -126, -126, -125, -125, -124, -124, -123, -122, -121, -120, -119, -118,
+            -117, -115, -114, -113, -111, -110, -108, -106, -105, -103, -101, -99, -97, -95, -93, -91,
+            -89, -86, -84, -82, -79, -77, -74, -72, -69, -67, -64, -61, -58, -56, -53, -50,
+            -47, -44, -41, -38, -35, -32, -29, -26, -23, -20, -17, -14, -11, -8, -5, -2,
+        },
+    },
+    { // Chebyshev
+        { // mip 0, 127 harmonics
+            -125, -102, -79, -59, -38, -21, -3, 11, 27, 39, 52, 62, 73, 81, 90, 97,
+            104, 108, 114, 117, 121, 123, 125, 125, 127, 126, 126, 124, 124, 121, 119, 115,
+            113, 109, 106, 101, 97, 92, 88, 81, 77, 71, 66, 59, 54, 47, 42, 35,
+            30, 23, 18, 11, 6, -1, -7, -13, -18, -25, -30, -37, -41, -48, -52, -58,
+            -62, -68, -72, -77, -80, -86, -89, -93, -96, -100, -103, -107, -108, -112, -113, -116,
+            -117, -120, -121, -123, -123, -125, -124, -126, -125, -126, -125, -125, -124, -124, -122, -122,
+            -119, -118, -116, -115, -111, -110, -107, -105, -101, -99, -95, -92, -88, -85, -81, -78,
+            -73, -70, -65, -61, -56, -53, -47, -43, -38, -34, -28, -24, -19, -15, -9, -5,
+            1, 5, 11, 15, 21, 24, 30, 34, 40, 43, 49, 53, 58, 61, 67, 70,
+            75, 78, 83, 85, 90, 92, 97, 99, 103, 105, 109, 110, 113, 115, 118, 118,
+            121, 122, 124, 124, 126, 125, 127, 126, 127, 126, 126, 125, 125, 123, 123, 120,
+            119, 116, 115, 112, 110, 107, 105, 100, 98, 93, 91, 86, 82, 77, 74, 68,
+            64, 58, 54, 48, 43, 37, 32, 25, 20, 13, 8, 1, -4, -11, -16, -23,
+            -28, -35, -40, -47, -52, -59, -64, -71, -75, -81, -86, -92, -95, -101, -104, -109,
+            -111, -115, -117, -121, -122, -124, -124, -126, -125, -125, -123, -123, -119, -117, -112, -108,
+            -102, -97, -89, -81, -71, -62, -50, -39, -25, -11, 5, 21, 40, 59, 81, 102,
+        },
+        { // mip 1, 64 harmonics
+            -63, -119, -95, -48, -30, -27, -10, 17, 30, 35, 48, 66, 75, 78, 87, 99,
+            105, 105, 111, 119, 121, 120, 123, 127, 127, 123, 124, 126, 123, 118, 117, 117,
+            113, 107, 104, 102, 96, 90, 86, 83, 76, 69, 65, 61, 54, 46, 41, 37,
+            30, 22, 17, 12, 5, -2, -7, -12, -19, -26, -30, -35, -41, -48, -52, -56,
+            -62, -68, -71, -75, -80, -85, -88, -91, -96, -100, -102, -104, -108, -111, -113, -114,
+            -117, -119, -120, -121, -123, -124, -124, -124, -125, -125, -124, -123, -123, -123, -121, -119,
+            -119, -118, -115, -113, -111, -109, -106, -103, -101, -98, -94, -91, -88, -85, -80, -76,
+            -73, -69, -64, -60, -56, -52, -47, -42, -38, -34, -28, -23, -19, -15, -9, -4,
+            0, 5, 11, 16, 19, 24, 30, 35, 38, 43, 49, 53, 56, 61, 66, 70,
+            73, 77, 82, 86, 88, 92, 96, 99, 101, 104, 108, 110, 111, 114, 117, 118,
+            119, 121, 123, 124, 123, 125, 126, 126, 125, 125, 126, 124, 123, 122, 122, 120,
+            117, 116, 115, 112, 108, 106, 104, 100, 96, 93, 90, 85, 80, 77, 73, 68,
+            62, 58, 54, 48, 41, 37, 32, 25, 19, 14, 9, 2, -5, -10, -15, -23,
+            -30, -34, -39, -47, -54, -58, -63, -70, -76, -80, -84, -91, -96, -99, -102, -108,
+            -113, -113, -115, -120, -123, -122, -122, -126, -127, -123, -121, -122, -121, -114, -109, -109,
+            -105, -93, -85, -83, -75, -58, -46, -43, -30, -5, 12, 13, 30, 75, 97, 40,
+        },
+        { // mip 2, 32 harmonics
+            -31, -64, -81, -78, -58, -28, 1, 23, 36, 42, 47, 53, 64, 78, 91, 101,
+            106, 107, 108, 109, 114, 119, 124, 127, 127, 124, 120, 118, 117, 118, 118, 116,
+            112, 106, 101, 96, 92, 90, 87, 82, 76, 69, 62, 56, 51, 47, 43, 37,
+            30, 23, 15, 9, 4, 0, -5, -11, -18, -25, -31, -37, -41, -45, -49, -54,
+            -60, -66, -72, -76, -79, -82, -85, -89, -94, -98, -102, -105, -106, -108, -109, -112,
+            -115, -117, -119, -120, -121, -120, -120, -121, -122, -123, -124, -123, -121, -119, -118, -117,
+            -117, -116, -115, -112, -109, -106, -103, -101, -99, -97, -94, -90, -86, -82, -78, -75,
+            -72, -69, -65, -60, -55, -50, -45, -41, -38, -34, -29, -24, -18, -13, -8, -4,
+            0, 4, 9, 14, 20, 25, 30, 34, 38, 42, 46, 51, 57, 62, 66, 69,
+            72, 75, 79, 84, 88, 92, 95, 97, 99, 101, 104, 108, 111, 114, 115, 116,
+            117, 118, 119, 121, 123, 124, 124, 123, 122, 122, 122, 122, 122, 122, 120, 117,
+            115, 113, 111, 110, 108, 106, 102, 98, 94, 90, 87, 84, 81, 77, 72, 66,
+            60, 55, 51, 48, 43, 38, 31, 24, 18, 12, 7, 3, -2, -8, -16, -23,
+            -30, -36, -40, -44, -49, -55, -63, -70, -76, -81, -84, -87, -90, -96, -102, -108,
+            -112, -114, -115, -115, -116, -118, -122, -126, -127, -124, -120, -115, -112, -111, -111, -110,
+            -106, -97, -85, -72, -62, -57, -53, -48, -36, -15, 13, 41, 60, 61, 43, 9,
+        },
+        { // mip 3, 16 harmonics
+            -16, -25, -32, -36, -36, -31, -22, -10, 6, 23, 41, 59, 75, 89, 100, 107,
+            113, 115, 116, 116, 116, 115, 116, 116, 118, 120, 122, 124, 125, 125, 123, 120,
+            116, 111, 105, 99, 93, 87, 81, 76, 72, 68, 64, 60, 56, 51, 46, 39,
+            32, 25, 17, 10, 2, -4, -11, -16, -21, -25, -30, -34, -38, -43, -49, -54,
+            -60, -66, -72, -77, -82, -87, -91, -94, -97, -99, -101, -103, -105, -107, -110, -112,
+            -115, -118, -121, -123, -124, -125, -126, -125, -125, -124, -122, -121, -120, -119, -119, -118,
+            -118, -117, -116, -115, -113, -110, -108, -104, -100, -96, -93, -89, -85, -82, -79, -76,
+            -73, -69, -66, -62, -58, -53, -48, -43, -38, -32, -27, -21, -17, -12, -8, -4,
+            0, 4, 8, 13, 18, 23, 28, 34, 39, 45, 50, 55, 59, 63, 66, 69,
+            73, 76, 79, 83, 86, 90, 94, 98, 102, 106, 109, 112, 114, 115, 116, 117,
+            118, 118, 119, 120, 122, 123, 124, 126, 127, 127, 127, 126, 125, 123, 120, 118,
+            115, 113, 111, 108, 107, 105, 103, 101, 99, 95, 92, 87, 83, 77, 71, 66,
+            60, 55, 50, 45, 41, 36, 32, 28, 23, 17, 11, 5, -3, -10, -18, -25,
+            -32, -39, -44, -49, -53, -57, -61, -65, -70, -75, -81, -87, -94, -100, -106, -112,
+            -116, -119, -121, -122, -121, -120, -118, -117, -116, -116, -116, -118, -119, -119, -119, -117,
+            -113, -105, -95, -82, -67, -51, -34, -18, -4, 7, 15, 18, 17, 12, 4, -5,
+        },
+        { // mip 4, 8 harmonics
+            -7, -4, -1, 3, 7, 11, 16, 21, 26, 32, 39, 46, 53, 60, 67, 75,
+            82, 89, 96, 102, 108, 113, 118, 121, 124, 126, 127, 127, 126, 124, 122, 119,
+            115, 110, 105, 100, 94, 88, 81, 75, 69, 63, 57, 51, 45, 39, 34, 29,
+            24, 19, 14, 9, 5, 0, -5, -9, -14, -19, -24, -29, -35, -40, -46, -51,
+            -57, -62, -67, -73, -78, -82, -87, -91, -95, -99, -102, -105, -107, -109, -111, -113,
+            -114, -115, -115, -116, -116, -116, -116, -116, -116, -116, -115, -115, -115, -114, -114, -113,
+            -113, -112, -111, -110, -108, -107, -105, -102, -100, -97, -94, -90, -87, -83, -79, -74,
+            -70, -65, -61, -56, -51, -47, -42, -38, -33, -29, -24, -20, -16, -12, -8, -4,
+            0, 4, 8, 12, 16, 21, 25, 30, 34, 39, 44, 48, 53, 58, 63, 67,
+            72, 76, 80, 84, 88, 92, 95, 98, 100, 103, 105, 107, 108, 110, 111, 112,
+            113, 114, 114, 115, 115, 116, 116, 117, 117, 118, 118, 118, 118, 118, 117, 117,
+            116, 114, 113, 111, 108, 106, 103, 99, 95, 91, 87, 82, 77, 72, 67, 62,
+            57, 51, 46, 41, 36, 31, 26, 21, 16, 12, 7, 2, -2, -7, -12, -17,
+            -22, -27, -33, -38, -44, -51, -57, -63, -70, -76, -83, -89, -95, -101, -106, -111,
+            -115, -118, -121, -123, -124, -124, -124, -122, -120, -117, -113, -109, -104, -98, -92, -86,
+            -80, -74, -68, -61, -55, -50, -44, -39, -35, -31, -27, -23, -20, -17, -13, -11,
+        },
+        { // mip 5, 4 harmonics
+            -4, 3, 10, 17, 24, 31, 38, 44, 51, 57, 63, 69, 74, 79, 84, 89,
+            93, 97, 101, 104, 106, 109, 111, 112, 114, 114, 115, 115, 114, 113, 112, 110,
+            108, 106, 103, 100, 96, 92, 88, 84, 79, 74, 69, 64, 58, 52, 46, 40,
+            34, 28, 22, 15, 9, 3, -4, -10, -16, -22, -28, -34, -40, -46, -52, -57,
+            -63, -68, -73, -77, -82, -86, -90, -94, -98, -102, -105, -108, -111, -113, -115, -118,
+            -119, -121, -122, -123, -124, -125, -125, -126, -126, -125, -125, -124, -124, -123, -121, -120,
+            -118, -117, -115, -113, -110, -108, -105, -103, -100, -97, -94, -90, -87, -83, -80, -76,
+            -72, -68, -64, -60, -56, -51, -47, -42, -38, -33, -29, -24, -19, -14, -10, -5,
+            0, 5, 10, 14, 19, 24, 29, 34, 38, 43, 47, 52, 56, 61, 65, 69,
+            73, 77, 81, 85, 89, 92, 95, 99, 102, 105, 107, 110, 112, 115, 117, 119,
+            120, 122, 123, 124, 125, 126, 127, 127, 127, 127, 127, 126, 125, 124, 123, 121,
+            120, 118, 116, 113, 111, 108, 105, 101, 98, 94, 90, 86, 82, 77, 72, 68,
+            63, 57, 52, 46, 41, 35, 29, 23, 17, 11, 5, -1, -7, -13, -20, -26,
+            -32, -38, -44, -49, -55, -61, -66, -71, -76, -81, -85, -89, -93, -97, -100, -103,
+            -106, -108, -110, -112, -113, -114, -114, -114, -114, -113, -112, -111, -109, -106, -104, -101,
+            -97, -93, -89, -84, -80, -74, -69, -63, -57, -51, -45, -38, -32, -25, -18, -11,
+        },
+        { // mip 6, 2 harmonics
+            -2, 2, 7, 11, 15, 19, 23, 27, 31, 35, 39, 43, 46, 50, 53, 56,
+            59, 62, 64, 67, 69, 71, 73, 74, 76, 77, 78, 79, 79, 80, 80, 80,
+            79, 79, 78, 77, 75, 74, 72, 70, 68, 65, 63, 60, 57, 54, 50, 47,
+            43, 39, 35, 31, 27, 22, 18, 13, 8, 3, -1, -6, -11, -16, -21, -26,
+            -31, -37, -41, -46, -51, -56, -61, -66, -70, -75, -79, -83, -87, -91, -95, -98,
+            -102, -105, -108, -111, -113, -115, -118, -119, -121, -122, -124, -124, -125, -126, -126, -125,
+            -125, -124, -123, -122, -121, -119, -117, -115, -113, -110, -107, -104, -100, -97, -93, -89,
+            -85, -81, -76, -71, -66, -61, -56, -51, -46, -40, -35, -29, -23, -17, -12, -6,
+            0, 6, 12, 17, 23, 29, 35, 40, 46, 51, 56, 62, 67, 72, 76, 81,
+            85, 90, 94, 97, 101, 104, 108, 111, 113, 116, 118, 120, 122, 123, 125, 126,
+            126, 127, 127, 127, 127, 126, 125, 124, 123, 121, 119, 117, 115, 112, 110, 107,
+            104, 100, 97, 93, 89, 85, 81, 77, 72, 68, 63, 58, 53, 48, 43, 38,
+            33, 28, 23, 18, 13, 8, 3, -2, -7, -12, -16, -21, -26, -30, -34, -38,
+            -42, -46, -50, -54, -57, -60, -63, -66, -68, -71, -73, -75, -76, -78, -79, -80,
+            -81, -81, -81, -81, -81, -81, -80, -79, -78, -77, -75, -73, -71, -69, -67, -64,
+            -62, -59, -56, -53, -49, -46, -42, -39, -35, -31, -27, -23, -19, -14, -10, -6,
+        },
+        { // mip 7, 1 harmonics
+            -3, -7, -10, -13, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46, -49,
+            -52, -55, -57, -60, -63, -66, -68, -71, -73, -76, -78, -81, -83, -86, -88, -90,
+            -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -114, -115, -116, -117,
+            -119, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127, -127,
+            -127, -127, -127, -126, -126, -126, -125, -124, -124, -123, -122, -121, -120, -119, -118, -117,
+            -116, -115, -113, -112, -110, -109, -107, -105, -104, -102, -100, -98, -96, -94, -92, -90,
+            -87, -85, -83, -80, -78, -75, -73, -70, -68, -65, -62, -60, -57, -54, -51, -48,
+            -45, -42, -39, -37, -34, -30, -27, -24, -21, -18, -15, -12, -9, -6, -3, 0,
+            3, 7, 10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46, 49,
+            52, 55, 57, 60, 63, 66, 68, 71, 73, 76, 78, 81, 83, 86, 88, 90,
+            92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 114, 115, 116, 117,
+            119, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127, 127,
+            127, 127, 127, 126, 126, 126, 125, 124, 124, 123, 122, 121, 120, 119, 118, 117,
+            116, 115, 113, 112, 110, 109, 107, 105, 104, 102, 100, 98, 96, 94, 92, 90,
+            87, 85, 83, 80, 78, 75, 73, 70, 68, 65, 62, 60, 57, 54, 51, 48,
+            45, 42, 39, 37, 34, 30, 27, 24, 21, 18, 15, 12, 9, 6, 3, 0,
+        },
+    },
+};
@@ -0,0 +1,116 @@
+#include "fixed_fft.h"
+#include <math.h>
+
+FixedFft::FixedFft() {
+    for (int i = 0; i <= SIZE / 4; i++) {
+        sine[i] = (int16_t)lrintf(32767.0f * sinf(2.0f * (float)M_PI * i / SIZE));
+    }
+}
+
+int16_t FixedFft::sin_q15(int i) const {
+    if (i < SIZE / 4) return sine[i];
+    if (i < SIZE / 2) return sine[SIZE / 2 - i];
+    if (i < 3 * SIZE / 4) return -sine[i - SIZE / 2];
+    return -sine[SIZE - i];
+}
+
+int16_t FixedFft::cos_q15(int i) const {
+    return sin_q15((i + SIZE / 4) & (SIZE - 1));
+}
+
+void FixedFft::window(int16_t* samples) const {
+    // 0.5 - 0.5 cos(2 pi i / SIZE)
+    for (int i = 0; i < SIZE; i++) {
+        int32_t w = (32767 - cos_q15(i)) >> 1;
+        samples[i] = (int16_t)(((int32_t)samples[i] * w) >> 15);
+    }
+}
+
+void FixedFft::transform(int16_t* data) const {
+    const int N = SIZE / 2; // complex points
+
+    // Bit reversed order
+    for (int i = 1, j = 0; i < N; i++) {
+        int bit = N >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            int16_t re = data[2 * i];
+            int16_t im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    for (int len = 2; len <= N; len <<= 1) {
+        int half = len >> 1;
+        int step = SIZE / len; // twiddle e^(-2 pi i j / len) is table entry j * step
+        for (int start = 0; start < N; start += len) {
+            for (int j = 0; j < half; j++) {
+                int32_t wr = cos_q15(j * step);
+                int32_t wi = -sin_q15(j * step);
+                int16_t* a = &data[2 * (start + j)];
+                int16_t* b = &data[2 * (start + j + half)];
+
+                int32_t tr = (b[0] * wr - b[1] * wi) >> 15;
+                int32_t ti = (b[0] * wi + b[1] * wr) >> 15;
+                int32_t ar = a[0];
+                int32_t ai = a[1];
+                a[0] = (ar + tr) >> 1;
+                a[1] = (ai + ti) >> 1;
+                b[0] = (ar - tr) >> 1;
+                b[1] = (ai - ti) >> 1;
+            }
+        }
+    }
+
+    // Split: with Z the transform of the packed points and m = N - k,
+    // Fe = (Z[k] + conj Z[m]) / 2, Fo = (Z[k] - conj Z[m]) / 2, G = W^k Fo,
+    // X[k] = Fe - i G and X[m] = conj Fe - i conj G
+    int32_t z0r = data[0];
+    int32_t z0i = data[1];
+    data[0] = (z0r + z0i) >> 1;
+    data[1] = (z0r - z0i) >> 1;
+
+    for (int k = 1; k <= N / 2; k++) {
+        int m = N - k;
+        int32_t kr = data[2 * k];
+        int32_t ki = data[2 * k + 1];
+        int32_t mr = data[2 * m];
+        int32_t mi = data[2 * m + 1];
+
+        int32_t fer = (kr + mr) >> 1;
+        int32_t fei = (ki - mi) >> 1;
+        int32_t for_ = (kr - mr) >> 1;
+        int32_t foi = (ki + mi) >> 1;
+
+        int32_t c = cos_q15(k);
+        int32_t s = sin_q15(k);
+        int32_t gr = (for_ * c + foi * s) >> 15;
+        int32_t gi = (foi * c - for_ * s) >> 15;
+
+        data[2 * k] = (fer + gi) >> 1;
+        data[2 * k + 1] = (fei - gr) >> 1;
+        if (m != k) {
+            data[2 * m] = (fer - gi) >> 1;
+            data[2 * m + 1] = (-fei - gr) >> 1;
+        }
+    }
+}
+
+int32_t FixedFft::power_db_q4(int32_t re, int32_t im) {
+    uint32_t power = (uint32_t)(re * re) + (uint32_t)(im * im);
+    if (power == 0) return 0;
+
+    // log2 from the leading bit, the mantissa interpolated linearly (within 0.3 dB)
+    int exponent = 31 - __builtin_clz(power);
+    uint32_t mantissa = exponent >= 16 ? power >> (exponent - 16) : power << (16 - exponent);
+    int32_t log2_q16 = (exponent << 16) + (int32_t)(mantissa & 0xffff);
+
+    // 10 log10(2) = 0.30103 * 10, in Q16 -> 1/16 dB
+    return (int32_t)(((int64_t)log2_q16 * 197283) >> 28);
+}
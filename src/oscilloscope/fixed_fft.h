@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+// Fixed point FFT of SIZE real samples, in place. The samples are packed as
+// SIZE / 2 complex points (even samples real, odd imaginary), transformed with
+// a radix-2 FFT that halves every stage so nothing overflows, then split into
+// the spectrum of the real input. One quarter sine table serves the twiddles
+// and the Hann window, so the only memory is the caller's sample buffer.
+class FixedFft {
+public:
+    static const int SIZE = 256;
+    static const int BINS = SIZE / 2; // DC up to just below Nyquist
+    // Samples within +-INPUT_LIMIT keep the packed complex points below 2^15 in magnitude
+    static const int16_t INPUT_LIMIT = 1 << 14;
+
+    FixedFft();
+
+    // Multiply by a Hann window
+    void window(int16_t* samples) const;
+
+    // Real samples in, BINS complex bins out as (re, im) pairs scaled by 1 / SIZE.
+    // Bin 0 carries the Nyquist bin in its imaginary part.
+    void transform(int16_t* data) const;
+
+    // 10 log10(re^2 + im^2) in 1/16 dB
+    static int32_t power_db_q4(int32_t re, int32_t im);
+
+    // power_db_q4() of a windowed sine of amplitude INPUT_LIMIT in its bin, 10 log10((2^14 / 4)^2)
+    static const int32_t FULL_SCALE_DB_Q4 = 1156;
+
+private:
+    int16_t sine[SIZE / 4 + 1]; // sin(2 pi i / SIZE), Q15
+
+    int16_t sin_q15(int i) const; // i in 0 .. SIZE - 1
+    int16_t cos_q15(int i) const;
+};
@@ -17,17 +17,156 @@ OscilloscopeRoot::OscilloscopeRoot(Display* display) : ScreenInterface(display)
     signal_config.channels[0] = static_cast<adc_channel_t>(ADC1_GPIO36_CHANNEL);
     signal_config.channels[1] = static_cast<adc_channel_t>(ADC1_GPIO37_CHANNEL);
 
-    signal_config.trigger_mode = is_rolling(current_scale_index)
-        ? TriggerMode::FREE
-        : TriggerMode::AUTO_RISE;
+    configure_scale();
     signal_config.trigger_level = 1000;
-    signal_config.sampling_rate = scale_to_rate(current_scale_index);
     signal_config.auto_speed = 0.005f;  // Default auto_speed value
-    signal_config.buffer_size = TICK_SPACING * (SCREEN_WIDTH / TICK_SPACING);
+    signal_config.buffer_size = CAPTURE_SIZE;
+
+    build_traces();
 
     sigscoper.begin();
 }
 
+void OscilloscopeRoot::configure_scale() {
+    bool rolling = is_rolling(current_scale_index);
+    signal_config.trigger_mode = rolling
+        ? TriggerMode::FREE
+        : TriggerMode::AUTO_RISE;
+    signal_config.sampling_rate = scale_to_rate(current_scale_index) * (rolling ? ROLL_OVERSAMPLE : 1);
+
+    for (int ch = 0; ch < 2; ch++) {
+        peaks[ch].reset(ROLL_OVERSAMPLE);
+    }
+    roll_last_us = micros();
+    roll_carry = 0;
+}
+
+void OscilloscopeRoot::capture_rolling() {
+    // Samples taken since the last frame, from the elapsed time
+    uint32_t now_us = micros();
+    uint64_t due = (uint64_t)(now_us - roll_last_us) * signal_config.sampling_rate + roll_carry;
+    roll_last_us = now_us;
+    roll_carry = due % 1000000;
+    uint32_t count = due / 1000000;
+    if (count == 0) return;
+
+    size_t read = count < CAPTURE_SIZE ? count : CAPTURE_SIZE;
+
+    sigscoper.get_stats(0, &stats);
+    size_t _pos = 0;
+    sigscoper.get_buffer(0, read, capture_buffers[0], &_pos);
+    sigscoper.get_buffer(1, read, capture_buffers[1], &_pos);
+    sigscoper.restart();
+
+    // After a frame longer than the buffer the oldest samples are gone; skip them
+    // so the columns keep their time
+    peaks[0].skip(count - read);
+    peaks[0].add(capture_buffers[0], read);
+    peaks[1].skip(count - read);
+    peaks[1].add(capture_buffers[1], read);
+}
+
+void OscilloscopeRoot::capture_triggered() {
+    sigscoper.get_stats(0, &stats);
+    size_t _pos = 0;
+    sigscoper.get_buffer(0, CAPTURE_SIZE, capture_buffers[0], &_pos);
+    sigscoper.get_buffer(1, CAPTURE_SIZE, capture_buffers[1], &_pos);
+
+    // Both channels are shifted by the crossing found on the first
+    int32_t start = TriggerAligner::find_window(capture_buffers[0], CAPTURE_SIZE, sigscoper.get_trigger_threshold(),
+                                                pre_trigger_samples, BUFFER_SIZE);
+    if (start < 0) {
+        // Auto mode timed out or the crossing is too close to an end, show the capture as is
+        start = 0;
+    }
+    TriggerAligner::resample(capture_buffers[0], CAPTURE_SIZE, start, signal_buffer, BUFFER_SIZE);
+    TriggerAligner::resample(capture_buffers[1], CAPTURE_SIZE, start, signal_buffer2, BUFFER_SIZE);
+}
+
+void OscilloscopeRoot::set_pre_trigger(uint8_t percent) {
+    if (percent > 100) percent = 100;
+    pre_trigger_percent = percent;
+    pre_trigger_samples = BUFFER_SIZE * percent / 100;
+}
+
+void OscilloscopeRoot::turn_knob(int8_t steps) {
+    switch (knob) {
+        case ScopeKnob::TIME_SCALE:
+            // Decrease index (faster time scale) when turned clockwise
+            if (steps > 0 && current_scale_index > 0) {
+                current_scale_index--;
+            }
+            // Increase index (slower time scale) when turned counter-clockwise
+            else if (steps < 0 && current_scale_index < TIME_SCALE_COUNT - 1) {
+                current_scale_index++;
+            }
+
+            configure_scale();
+
+            // save last trigger level
+            signal_config.trigger_level = sigscoper.get_trigger_threshold();
+
+            sigscoper.stop();
+            sigscoper.start(signal_config);
+            break;
+
+        case ScopeKnob::PRE_TRIGGER: {
+            // Clockwise moves the trigger point right
+            int percent = pre_trigger_percent + (steps > 0 ? PRE_TRIGGER_STEP : -PRE_TRIGGER_STEP);
+            set_pre_trigger(percent < 0 ? 0 : percent);
+            break;
+        }
+
+        case ScopeKnob::HOLDOFF:
+            if (steps > 0 && holdoff_index < HOLDOFF_COUNT - 1) {
+                holdoff_index++;
+            } else if (steps < 0 && holdoff_index > 0) {
+                holdoff_index--;
+            }
+            set_holdoff_ms(holdoff_steps[holdoff_index]);
+            break;
+    }
+}
+
+void OscilloscopeRoot::draw_trace(int channel, const uint16_t* samples, uint8_t thickness) {
+    const int first = 1;
+    const int last = SCREEN_WIDTH - 2;
+
+    if (is_rolling(current_scale_index)) {
+        traces[channel].draw_bars(display, peaks[channel].get_min(), peaks[channel].get_max(), first, last, thickness);
+    } else {
+        traces[channel].draw(display, samples, first, last, thickness);
+    }
+}
+
+void OscilloscopeRoot::build_traces() {
+    switch (display_mode) {
+        case DisplayMode::SINGLE:
+        case DisplayMode::JOINED:
+            traces[0].build(TRACE_ADC_LOW, TRACE_ADC_HIGH, SCREEN_HEIGHT, GRAPH_TOP, 0, SCREEN_HEIGHT);
+            traces[1].build(TRACE_ADC_LOW, TRACE_ADC_HIGH, SCREEN_HEIGHT, GRAPH_TOP, 0, SCREEN_HEIGHT);
+            break;
+        case DisplayMode::SPLIT:
+            traces[0].build(TRACE_ADC_LOW, TRACE_ADC_HIGH, SCREEN_HEIGHT / 2, GRAPH_TOP, 0, SCREEN_HEIGHT / 2);
+            traces[1].build(TRACE_ADC_LOW, TRACE_ADC_HIGH, SCREEN_HEIGHT, SCREEN_HEIGHT / 2,
+                            SCREEN_HEIGHT / 2, SCREEN_HEIGHT);
+            break;
+    }
+}
+
+void OscilloscopeRoot::profile_traces(uint32_t us) {
+    trace_us_sum += us;
+    if (us > trace_us_max) trace_us_max = us;
+    trace_frames++;
+
+    if (millis() - last_profile_ms < 1000) return;
+    last_profile_ms = millis();
+    Serial.printf("scope traces: avg %u max %u us per frame\n", trace_us_sum / trace_frames, trace_us_max);
+    trace_us_sum = 0;
+    trace_us_max = 0;
+    trace_frames = 0;
+}
+
 void OscilloscopeRoot::drawGraph() {
     const int TICK_SIZE = 6; // 6 pixels tall (3 above, 3 below)
 
@@ -37,25 +176,37 @@ void OscilloscopeRoot::drawGraph() {
         last_trigger_wait = millis();
     }
 
-    if(millis() - last_trigger_wait > 1000
-        || sigscoper.is_ready()
-        || is_rolling(current_scale_index)) {
-        sigscoper.get_stats(0, &stats);
-        size_t _pos = 0;
-        sigscoper.get_buffer(0, SCREEN_WIDTH, signal_buffer, &_pos);
-        sigscoper.get_buffer(1, SCREEN_WIDTH, signal_buffer2, &_pos);
+    if(is_rolling(current_scale_index)) {
+        capture_rolling();
+    } else if(millis() - last_trigger_wait > 1000
+        || sigscoper.is_ready()) {
+        // Within the holdoff the capture is dropped and the trigger re-armed
+        if (millis() - last_capture_ms >= holdoff_ms) {
+            capture_triggered();
+            last_capture_ms = millis();
+        }
         sigscoper.restart();
         last_trigger_wait = 0;
     }
 
     display->setCursor(0, 0);
 
-    display->printf("%.0f %s/d ",
-        time_scales[current_scale_index] >= 1.0
-            ? time_scales[current_scale_index]
-            : time_scales[current_scale_index] * 1000.0,
-        time_scales[current_scale_index] >= 1.0 ? "ms" : "us"
-    );
+    switch (knob) {
+        case ScopeKnob::TIME_SCALE:
+            display->printf("%.0f %s/d ",
+                time_scales[current_scale_index] >= 1.0
+                    ? time_scales[current_scale_index]
+                    : time_scales[current_scale_index] * 1000.0,
+                time_scales[current_scale_index] >= 1.0 ? "ms" : "us"
+            );
+            break;
+        case ScopeKnob::PRE_TRIGGER:
+            display->printf("pre %u%% ", pre_trigger_percent);
+            break;
+        case ScopeKnob::HOLDOFF:
+            display->printf("hold %ums ", (unsigned)holdoff_ms);
+            break;
+    }
 
     if(display_mode == DisplayMode::SINGLE) {
         display->printf("| %.1f | %.1f ", 
@@ -65,105 +216,29 @@ void OscilloscopeRoot::drawGraph() {
     }
     
 
-    int graph_y = 40;
-    
+    uint32_t trace_start_us = PROFILE_SCOPE ? micros() : 0;
+
     switch (display_mode) {
         case DisplayMode::SINGLE:
-            // Draw only first channel (thick line - 3 pixels)
-            for (int i = 1; i < SCREEN_WIDTH - 2; i++) {
-                if(signal_buffer[i] == 0) continue;
-                if(signal_buffer[i + 1] == 0) continue;
-                
-                int y1 = map(
-                    signal_buffer[i], 400, 2400, SCREEN_HEIGHT, 10);
-                int y2 = map(
-                    signal_buffer[i + 1], 400, 2400, SCREEN_HEIGHT, 10);
-                
-                if (y1 >= 0 && y1 < SCREEN_HEIGHT && y2 >= 0 && y2 < SCREEN_HEIGHT) {
-                    // Draw line with 3-pixel width
-                    display->drawLine(i, y1, i + 1, y2, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 1, i + 1, y2 + 1, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 2, i + 2, y2 + 2, SSD1306_WHITE);
-                }
-            }
+            draw_trace(0, signal_buffer, trace_thickness);
             break;
-            
-        case DisplayMode::JOINED:
-        // Draw only first channel (thick line - 3 pixels)
-            for (int i = 1; i < SCREEN_WIDTH - 2; i++) {
-                if(signal_buffer[i] == 0) continue;
-                if(signal_buffer[i + 1] == 0) continue;
-                
-                int y1 = map(
-                    signal_buffer[i], 400, 2400, SCREEN_HEIGHT, 10);
-                int y2 = map(
-                    signal_buffer[i + 1], 400, 2400, SCREEN_HEIGHT, 10);
-                
-                if (y1 >= 0 && y1 < SCREEN_HEIGHT && y2 >= 0 && y2 < SCREEN_HEIGHT) {
-                    // Draw line with 3-pixel width
-                    display->drawLine(i, y1, i + 1, y2, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 1, i + 1, y2 + 1, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 2, i + 2, y2 + 2, SSD1306_WHITE);
-                }
-            }
 
-            // Draw second channel (thin line - 1 pixel)
-            for (int i = 1; i < SCREEN_WIDTH - 2; i++) {
-                if(signal_buffer2[i] == 0) continue;
-                if(signal_buffer2[i + 1] == 0) continue;
-                
-                int y1 = map(
-                    signal_buffer2[i], 400, 2400, SCREEN_HEIGHT, 10);
-                int y2 = map(
-                    signal_buffer2[i + 1], 400, 2400, SCREEN_HEIGHT, 10);
-                
-                if (y1 >= 0 && y1 < SCREEN_HEIGHT && y2 >= 0 && y2 < SCREEN_HEIGHT) {
-                    // Draw line with 1-pixel width
-                    display->drawLine(i, y1, i + 1, y2, SSD1306_WHITE);
-                }
-            }
+        case DisplayMode::JOINED:
+            draw_trace(0, signal_buffer, trace_thickness);
+            // Second channel thin, to tell the two apart
+            draw_trace(1, signal_buffer2, 1);
             break;
-            
+
         case DisplayMode::SPLIT:
-            // Draw first channel in upper half (thick line - 3 pixels)
-            for (int i = 1; i < SCREEN_WIDTH - 2; i++) {
-                if(signal_buffer[i] == 0) continue;
-                if(signal_buffer[i + 1] == 0) continue;
-                
-                int y1 = map(
-                    signal_buffer[i], 400, 2400, SCREEN_HEIGHT/2, 10);
-                int y2 = map(
-                    signal_buffer[i + 1], 400, 2400, SCREEN_HEIGHT/2, 10);
-                
-                if (y1 >= 0 && y1 < SCREEN_HEIGHT/2 && y2 >= 0 && y2 < SCREEN_HEIGHT/2) {
-                    // Draw line with 3-pixel width
-                    display->drawLine(i, y1, i + 1, y2, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 1, i + 1, y2 + 1, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 2, i + 2, y2 + 2, SSD1306_WHITE);
-                }
-            }
-            
-            // Draw second channel in lower half (thick line - 3 pixels)
-            for (int i = 1; i < SCREEN_WIDTH - 2; i++) {
-                if(signal_buffer2[i] == 0) continue;
-                if(signal_buffer2[i + 1] == 0) continue;
-                
-                int y1 = map(
-                    signal_buffer2[i], 400, 2400, SCREEN_HEIGHT, SCREEN_HEIGHT/2);
-                int y2 = map(
-                    signal_buffer2[i + 1], 400, 2400, SCREEN_HEIGHT, SCREEN_HEIGHT/2);
-                
-                if (y1 >= SCREEN_HEIGHT/2 && y1 < SCREEN_HEIGHT && y2 >= SCREEN_HEIGHT/2 && y2 < SCREEN_HEIGHT) {
-                    // Draw line with 3-pixel width
-                    display->drawLine(i, y1, i + 1, y2, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 1, i + 1, y2 + 1, SSD1306_WHITE);
-                    display->drawLine(i, y1 + 2, i + 2, y2 + 2, SSD1306_WHITE);
-                }
-            }
+            draw_trace(0, signal_buffer, trace_thickness);
+            draw_trace(1, signal_buffer2, trace_thickness);
             break;
     }
 
-    
+    if (PROFILE_SCOPE) {
+        profile_traces(micros() - trace_start_us);
+    }
+
     /*
     // Draw trigger level using dotted line
     int trigger_level =
@@ -176,7 +251,7 @@ void OscilloscopeRoot::drawGraph() {
     /*
     // Draw trigger position using dotted line
     for(int i = 10; i < SCREEN_HEIGHT; i += 2) {
-        display->drawPixel(SCREEN_WIDTH / 2, i, SSD1306_WHITE);
+        display->drawPixel(pre_trigger_samples, i, SSD1306_WHITE);
     }
     // */
 
@@ -226,6 +301,8 @@ void OscilloscopeRoot::drawGraph() {
 }
 
 void OscilloscopeRoot::enter() {
+    // Nothing was captured while away
+    configure_scale();
 
     if (!sigscoper.start(signal_config)) {
         Serial.println("Failed to start signal monitoring");
@@ -253,27 +330,8 @@ void OscilloscopeRoot::update(Event* event) {
     // Clear the display for redrawing
     display->clearDisplay();
     
-    // Handle encoder changes to adjust time scale
     if (event->encoder != 0) {
-        // Decrease index (faster time scale) when turned clockwise
-        if (event->encoder > 0 && current_scale_index > 0) {
-            current_scale_index--;            
-        }
-        // Increase index (slower time scale) when turned counter-clockwise
-        else if (event->encoder < 0 && current_scale_index < TIME_SCALE_COUNT - 1) {
-            current_scale_index++;
-        }
-
-        signal_config.sampling_rate = scale_to_rate(current_scale_index);
-        signal_config.trigger_mode = is_rolling(current_scale_index)
-            ? TriggerMode::FREE
-            : TriggerMode::AUTO_RISE;
-        
-        // save last trigger level
-        signal_config.trigger_level = sigscoper.get_trigger_threshold();
-
-        sigscoper.stop();
-        sigscoper.start(signal_config);
+        turn_knob(event->encoder);
     }
     
     // Draw the graph on each update
@@ -285,14 +343,31 @@ void OscilloscopeRoot::update(Event* event) {
             // Handle button A press
             break;
         case ButtonRelease:
-            // Handle button A release
+            // A short press cycles the trace thickness, holding A switches screens
+            if (event->button_a_ms < ScreenSwitcher::SWITCH_HOLD_MS) {
+                trace_thickness = trace_thickness % TraceRenderer::MAX_THICKNESS + 1;
+            }
             break;
         default:
             break;
     }
 
     switch (event->button_sw) {
-        case ButtonPress:
+        case ButtonHold:
+            if (event->button_sw_ms >= KNOB_PRESS_MS && !knob_switched) {
+                switch (knob) {
+                    case ScopeKnob::TIME_SCALE:  knob = ScopeKnob::PRE_TRIGGER; break;
+                    case ScopeKnob::PRE_TRIGGER: knob = ScopeKnob::HOLDOFF; break;
+                    case ScopeKnob::HOLDOFF:     knob = ScopeKnob::TIME_SCALE; break;
+                }
+                knob_switched = true;
+            }
+            break;
+        case ButtonRelease:
+            if (knob_switched) {
+                knob_switched = false;
+                break;
+            }
             // Switch display mode
             switch (display_mode) {
                 case DisplayMode::SINGLE:
@@ -305,9 +380,7 @@ void OscilloscopeRoot::update(Event* event) {
                     display_mode = DisplayMode::SINGLE;
                     break;
             }
-            break;
-        case ButtonRelease:
-            // Handle encoder switch release
+            build_traces();
             break;
         default:
             break;
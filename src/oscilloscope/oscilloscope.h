@@ -2,6 +2,10 @@
 
 #include "sigscoper.h"
 #include "../urack_types.h"
+#include "trace_renderer.h"
+#include "peak_decimator.h"
+#include "trigger_aligner.h"
+#include "../screen_switcher.h"
 
 enum class DisplayMode {
     SINGLE,  // Only one channel shows
@@ -9,6 +13,13 @@ enum class DisplayMode {
     SPLIT    // Two channels on separate graphs
 };
 
+// What turning the encoder changes, a long press of the encoder switch cycles it
+enum class ScopeKnob {
+    TIME_SCALE,
+    PRE_TRIGGER,
+    HOLDOFF
+};
+
 class OscilloscopeRoot : public ScreenInterface {
 public:
     OscilloscopeRoot(Display* display);
@@ -16,19 +27,65 @@ public:
     void exit() override;
     void update(Event* event) override;
 
+    // Screens that only run while the scope is not shown (spectrum, tuner) share its
+    // Sigscoper and capture memory instead of holding their own
+    static const size_t CAPTURE_MEMORY_SIZE = 3 * SCREEN_WIDTH; // uint16_t, both channels
+    Sigscoper* get_sigscoper() { return &sigscoper; }
+    uint16_t* get_capture_memory() { return capture_buffers[0]; }
+
+    // Part of the screen left of the trigger, in percent of its width
+    void set_pre_trigger(uint8_t percent);
+    // Triggers sooner than this after the last displayed one are skipped
+    void set_holdoff_ms(uint32_t ms) { holdoff_ms = ms; }
+
 private:
     // Buffer size for drawing on screen
     static const uint16_t BUFFER_SIZE = 128;
-    static const uint8_t GRAPH_TRACE_WIDTH = 2; // Width of the graph trace in pixels
     uint16_t signal_buffer[BUFFER_SIZE];
     uint16_t signal_buffer2[BUFFER_SIZE];  // Buffer for second channel
 
+    // Raw capture, one and a half screens so the trigger can be moved by up to
+    // half a screen either way and placed between samples
+    static const uint16_t CAPTURE_SIZE = CAPTURE_MEMORY_SIZE / 2;
+    uint16_t capture_buffers[2][CAPTURE_SIZE];
+
+    static const uint8_t DEFAULT_PRE_TRIGGER = 50; // percent
+    static const uint8_t PRE_TRIGGER_STEP = 10; // percent per encoder step
+    uint8_t pre_trigger_percent = DEFAULT_PRE_TRIGGER;
+    int pre_trigger_samples = BUFFER_SIZE * DEFAULT_PRE_TRIGGER / 100;
+    static const uint8_t HOLDOFF_COUNT = 8;
+    const uint16_t holdoff_steps[HOLDOFF_COUNT] = {0, 5, 10, 20, 50, 100, 200, 500}; // ms
+    uint8_t holdoff_index = 0;
+    uint32_t holdoff_ms = 0;
+    uint32_t last_capture_ms = 0;
+    void capture_triggered();
+
+    // ADC codes shown from the bottom of a graph to its top row
+    static const int TRACE_ADC_LOW = 400;
+    static const int TRACE_ADC_HIGH = 2400;
+    static const int GRAPH_TOP = 10; // below the status line
+    static const uint8_t DEFAULT_TRACE_THICKNESS = 3;
+    uint8_t trace_thickness = DEFAULT_TRACE_THICKNESS; // first channel, button A cycles 1..MAX_THICKNESS
+    TraceRenderer traces[2];
+    void build_traces(); // row tables for the current display mode
+    void draw_trace(int channel, const uint16_t* samples, uint8_t thickness);
+
+    // Rolling mode samples ROLL_OVERSAMPLE times per column and draws the
+    // min/max of each column, capture_buffers hold the raw samples of a frame
+    static const uint16_t ROLL_OVERSAMPLE = 16;
+    PeakDecimator peaks[2];
+    uint32_t roll_last_us = 0;
+    uint32_t roll_carry = 0; // sample fraction left over from the last frame, in 1/1000000
+    void capture_rolling();
+
     const int TICK_SPACING = 25;
     size_t tickOffset = 0;
 
     void drawGraph();
+    void profile_traces(uint32_t us);
     bool is_rolling(size_t scale_index);
     uint16_t scale_to_rate(size_t scale_index);
+    void configure_scale(); // sampling for current_scale_index
     
     // Timing variables
     // Time scales in milliseconds per division
@@ -45,4 +102,16 @@ private:
     SigscoperConfig signal_config;
     SigscoperStats stats;
     DisplayMode display_mode = DisplayMode::JOINED;  // Default mode
+
+    // A short press of the encoder switch changes the display mode, a longer hold the knob
+    static const uint32_t KNOB_PRESS_MS = 400;
+    ScopeKnob knob = ScopeKnob::TIME_SCALE;
+    bool knob_switched = false; // in this hold of the encoder switch
+    void turn_knob(int8_t steps);
+
+    // Trace render time, collected when PROFILE_SCOPE is set
+    uint32_t trace_us_sum = 0;
+    uint32_t trace_us_max = 0;
+    uint32_t trace_frames = 0;
+    uint32_t last_profile_ms = 0;
 }; 
@@ -0,0 +1,59 @@
+#include "peak_decimator.h"
+#include <string.h>
+
+PeakDecimator::PeakDecimator() {
+    reset(1);
+}
+
+void PeakDecimator::reset(uint16_t samples_per_column) {
+    this->samples_per_column = samples_per_column > 0 ? samples_per_column : 1;
+    memset(col_min, 0, sizeof(col_min));
+    memset(col_max, 0, sizeof(col_max));
+    column_fill = 0;
+}
+
+// Scroll left by one column. A few per frame at most, so shifting keeps the
+// arrays in screen order for drawing at no real cost.
+void PeakDecimator::next_column(void) {
+    memmove(col_min, col_min + 1, NEWEST * sizeof(col_min[0]));
+    memmove(col_max, col_max + 1, NEWEST * sizeof(col_max[0]));
+    col_min[NEWEST] = 0;
+    col_max[NEWEST] = 0;
+    column_fill = 0;
+}
+
+void PeakDecimator::add(const uint16_t* samples, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t s = samples[i];
+        if (s != 0) {
+            if (col_max[NEWEST] == 0) {
+                col_min[NEWEST] = s;
+                col_max[NEWEST] = s;
+            } else if (s < col_min[NEWEST]) {
+                col_min[NEWEST] = s;
+            } else if (s > col_max[NEWEST]) {
+                col_max[NEWEST] = s;
+            }
+        }
+        if (++column_fill >= samples_per_column) {
+            next_column();
+        }
+    }
+}
+
+void PeakDecimator::skip(uint32_t count) {
+    // Longer than the screen: nothing captured is left to show
+    if (count >= (uint32_t)COLUMNS * samples_per_column) {
+        reset(samples_per_column);
+        return;
+    }
+    while (count > 0) {
+        uint32_t room = samples_per_column - column_fill;
+        if (count < room) {
+            column_fill += count;
+            return;
+        }
+        count -= room;
+        next_column();
+    }
+}
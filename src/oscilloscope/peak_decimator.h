@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../board.h"
+
+// Rolling-mode capture reduced to one min/max pair per screen column. Samples
+// arrive oversampled and are folded into the newest column as they come, so a
+// pulse shorter than a column still shows as a full-height bar. Fixed cost of
+// 2 x COLUMNS values whatever the oversampling.
+class PeakDecimator {
+public:
+    static const int COLUMNS = SCREEN_WIDTH;
+
+    PeakDecimator();
+
+    // Clear all columns, then fold samples_per_column input samples into each
+    void reset(uint16_t samples_per_column);
+
+    // Append samples, oldest first. Zero samples (no data) are ignored.
+    void add(const uint16_t* samples, size_t count);
+    // Advance time by count samples that were not captured
+    void skip(uint32_t count);
+
+    // Columns oldest first, the one being filled last. Columns without samples are 0.
+    const uint16_t* get_min(void) const { return col_min; }
+    const uint16_t* get_max(void) const { return col_max; }
+
+private:
+    static const int NEWEST = COLUMNS - 1;
+
+    uint16_t col_min[COLUMNS];
+    uint16_t col_max[COLUMNS];
+    uint16_t samples_per_column;
+    uint16_t column_fill; // samples (captured or skipped) in the newest column
+
+    void next_column(void);
+};
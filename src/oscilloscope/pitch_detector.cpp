@@ -0,0 +1,142 @@
+#include "pitch_detector.h"
+#include <math.h>
+
+uint32_t PitchDetector::difference(const int16_t* x, int lag, int length, int step) {
+    // Centred 12 bit samples: a squared difference is below 2^24, WINDOW of them fit 32 bits
+    uint32_t sum = 0;
+    for (int i = 0; i < length; i += step) {
+        int32_t d = x[i] - x[i + lag];
+        sum += d * d;
+    }
+    return sum;
+}
+
+// Offset of the minimum of the parabola through three equally spaced points
+float PitchDetector::vertex(uint32_t before, uint32_t at, uint32_t after) {
+    float curve = (float)before - 2.0f * at + (float)after;
+    if (curve <= 0) return 0;
+    return ((float)before - (float)after) / (2.0f * curve);
+}
+
+// Walk from lag down to the nearest minimum of the full difference function,
+// 0 if it runs off the lags that have length samples to compare
+float PitchDetector::minimum(const int16_t* x, int lag, int length, int count) {
+    const int MAX_STEPS = 8;
+    if (lag < 2 || lag + 1 + length > count) return 0;
+
+    uint32_t before = difference(x, lag - 1, length, 1);
+    uint32_t at = difference(x, lag, length, 1);
+    uint32_t after = difference(x, lag + 1, length, 1);
+    for (int step = 0; step < MAX_STEPS; step++) {
+        if (before < at && before <= after) {
+            if (--lag < 2) return 0;
+            after = at;
+            at = before;
+            before = difference(x, lag - 1, length, 1);
+        } else if (after < at) {
+            if (++lag + 1 + length > count) return 0;
+            before = at;
+            at = after;
+            after = difference(x, lag + 1, length, 1);
+        } else {
+            return lag + vertex(before, at, after);
+        }
+    }
+    return 0;
+}
+
+// Delay in samples of x[lag, lag + length) against x[0, length), less whole
+// periods, from the turn of the fundamental between the two. Both are Hann
+// windowed so the harmonics do not leak into the fundamental.
+float PitchDetector::delay(const int16_t* x, int lag, int length, float period) {
+    // Probe e^(-j w i) and the window's cosine are rotated, not computed per sample
+    float step = 2.0f * (float)M_PI / period;
+    float step_re = cosf(step), step_im = -sinf(step);
+    float hann_step = 2.0f * (float)M_PI / length;
+    float hann_step_re = cosf(hann_step), hann_step_im = sinf(hann_step);
+
+    float probe_re = 1, probe_im = 0;
+    float hann_re = cosf(hann_step / 2), hann_im = sinf(hann_step / 2);
+    float a_re = 0, a_im = 0, b_re = 0, b_im = 0;
+    for (int i = 0; i < length; i++) {
+        float w = 0.5f - 0.5f * hann_re;
+        float re = probe_re * w, im = probe_im * w;
+        a_re += x[i] * re;
+        a_im += x[i] * im;
+        b_re += x[i + lag] * re;
+        b_im += x[i + lag] * im;
+
+        float next_re = probe_re * step_re - probe_im * step_im;
+        probe_im = probe_re * step_im + probe_im * step_re;
+        probe_re = next_re;
+        next_re = hann_re * hann_step_re - hann_im * hann_step_im;
+        hann_im = hann_re * hann_step_im + hann_im * hann_step_re;
+        hann_re = next_re;
+    }
+    // Angle of b * conj(a)
+    float turn = atan2f(b_im * a_re - b_re * a_im, b_re * a_re + b_im * a_im);
+    return turn / step;
+}
+
+float PitchDetector::detect(uint16_t* samples, int count) {
+    if (count > MAX_SAMPLES) count = MAX_SAMPLES;
+    int max_lag = count - WINDOW - 1;
+    if (max_lag <= MIN_PERIOD) return 0;
+
+    // Centre in place, the samples are 12 bit so they fit int16_t either way
+    int32_t sum = 0;
+    uint16_t low = 0xffff;
+    uint16_t high = 0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+        if (samples[i] < low) low = samples[i];
+        if (samples[i] > high) high = samples[i];
+    }
+    if (high - low < MIN_SWING) return 0;
+
+    int32_t mean = sum / count;
+    int16_t* x = reinterpret_cast<int16_t*>(samples);
+    for (int i = 0; i < count; i++) {
+        x[i] = (int32_t)samples[i] - mean;
+    }
+
+    // Coarse: first dip of the normalized difference below THRESHOLD, else the lowest
+    float running = 0;
+    int period = 0;
+    int best = 0;
+    cmnd[0] = 1;
+    for (int lag = 1; lag <= max_lag; lag++) {
+        float d = difference(x, lag, WINDOW, 2);
+        running += d;
+        cmnd[lag] = running > 0 ? d * lag / running : 1;
+
+        if (lag < MIN_PERIOD) continue;
+        if (best == 0 || cmnd[lag] < cmnd[best]) best = lag;
+        if (period != 0) {
+            // Walk down to the bottom of the dip
+            if (cmnd[lag] >= cmnd[period]) break;
+            period = lag;
+        } else if (cmnd[lag] < THRESHOLD) {
+            period = lag;
+        }
+    }
+    if (period == 0) {
+        if (cmnd[best] > UNVOICED) return 0;
+        period = best;
+    }
+    if (period >= max_lag) return 0;
+
+    float coarse = minimum(x, period, WINDOW, count);
+    if (coarse <= 0) return 0;
+
+    // Fine: the most periods that leave half the block to compare. Fewer
+    // samples let the harmonics leak through the window, more periods divide
+    // the error of the delay.
+    int periods = (int)(count / 2 / coarse);
+    if (periods < 1) periods = 1;
+    int lag = (int)(coarse * periods + 0.5f);
+
+    float fine = lag - delay(x, lag, count - lag, coarse);
+    if (fine <= 0) return 0;
+    return fine / periods;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// YIN pitch detector on a block of ADC samples. The coarse period search
+// sums every other sample of the difference function, which halves its cost.
+// The period is then refined by the phase of the fundamental: the block a
+// whole number of periods later is the block itself delayed by the error of
+// that lag, which turns the fundamental by the same angle whatever the
+// harmonics. A parabola through the difference function misses the minimum
+// of saw and square waves by up to a tenth of a sample, their dip is a V.
+class PitchDetector {
+public:
+    static const int MAX_SAMPLES = 384;
+    static const int WINDOW = 128;         // samples compared per lag
+    static const int MIN_PERIOD = 4;       // samples
+    static const int MIN_SWING = 64;       // ADC codes peak to peak, below is silence
+    static constexpr float THRESHOLD = 0.15f; // normalized difference that counts as a period
+    static constexpr float UNVOICED = 0.4f;   // best normalized difference above this is noise
+
+    // Period in samples of count ADC samples (count <= MAX_SAMPLES), 0 if none.
+    // The samples are centred in place.
+    float detect(uint16_t* samples, int count);
+
+private:
+    float cmnd[MAX_SAMPLES - WINDOW]; // cumulative mean normalized difference per lag
+
+    static uint32_t difference(const int16_t* x, int lag, int length, int step);
+    static float vertex(uint32_t before, uint32_t at, uint32_t after);
+    static float minimum(const int16_t* x, int lag, int length, int count);
+    static float delay(const int16_t* x, int lag, int length, float period);
+};
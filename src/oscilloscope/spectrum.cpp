@@ -0,0 +1,167 @@
+#include "spectrum.h"
+#include "../board.h"
+#include <soc/adc_channel.h>
+
+static_assert(OscilloscopeRoot::CAPTURE_MEMORY_SIZE >= FixedFft::SIZE, "FFT does not fit the scope capture memory");
+
+SpectrumRoot::SpectrumRoot(Display* display, OscilloscopeRoot* scope)
+    : ScreenInterface(display),
+      sigscoper(scope->get_sigscoper()),
+      samples(reinterpret_cast<int16_t*>(scope->get_capture_memory())) {
+    config.channel_count = 1;
+    config.trigger_mode = TriggerMode::FREE;
+    config.trigger_level = 0;
+    config.auto_speed = 0.005f;
+    config.buffer_size = FixedFft::SIZE;
+    configure();
+    reset_peaks();
+}
+
+void SpectrumRoot::configure() {
+    config.channels[0] = channel == 0
+        ? static_cast<adc_channel_t>(ADC1_GPIO36_CHANNEL)
+        : static_cast<adc_channel_t>(ADC1_GPIO37_CHANNEL);
+    config.sampling_rate = rates[rate_index];
+}
+
+void SpectrumRoot::reset_peaks() {
+    for (int i = 0; i < FixedFft::BINS; i++) {
+        level[i] = 0;
+        peak[i] = 0;
+    }
+    strongest_bin = 0;
+    last_decay_ms = millis();
+}
+
+void SpectrumRoot::analyze() {
+    size_t _pos = 0;
+    uint16_t* adc = reinterpret_cast<uint16_t*>(samples);
+    sigscoper->get_buffer(0, FixedFft::SIZE, adc, &_pos);
+    sigscoper->restart();
+
+    // Remove the input bias, then scale to the FFT input in place
+    int32_t sum = 0;
+    for (int i = 0; i < FixedFft::SIZE; i++) {
+        sum += adc[i];
+    }
+    int32_t mean = sum / FixedFft::SIZE;
+    for (int i = 0; i < FixedFft::SIZE; i++) {
+        int32_t s = ((int32_t)adc[i] - mean) << ADC_SHIFT;
+        if (s >= FixedFft::INPUT_LIMIT) s = FixedFft::INPUT_LIMIT - 1;
+        if (s <= -FixedFft::INPUT_LIMIT) s = -FixedFft::INPUT_LIMIT + 1;
+        samples[i] = s;
+    }
+
+    fft.window(samples);
+    fft.transform(samples);
+
+    int32_t strongest_db = INT32_MIN;
+    for (int bin = 0; bin < FixedFft::BINS; bin++) {
+        // Bin 0 holds Nyquist in its imaginary part, drop it
+        int32_t im = bin == 0 ? 0 : samples[2 * bin + 1];
+        int32_t db_q4 = FixedFft::power_db_q4(samples[2 * bin], im) - FixedFft::FULL_SCALE_DB_Q4;
+
+        int32_t rows = (db_q4 + DB_RANGE * 16) * GRAPH_ROWS / (DB_RANGE * 16);
+        if (rows < 0) rows = 0;
+        if (rows > GRAPH_ROWS) rows = GRAPH_ROWS;
+        level[bin] = rows;
+        if (rows > peak[bin]) peak[bin] = rows;
+
+        if (bin > 0 && db_q4 > strongest_db) {
+            strongest_db = db_q4;
+            strongest_bin = bin;
+        }
+    }
+}
+
+void SpectrumRoot::decay_peaks() {
+    uint32_t steps = (millis() - last_decay_ms) / PEAK_DECAY_MS;
+    if (steps == 0) return;
+    last_decay_ms += steps * PEAK_DECAY_MS;
+
+    for (int i = 0; i < FixedFft::BINS; i++) {
+        uint32_t fall = peak[i] - level[i];
+        peak[i] -= steps < fall ? steps : fall;
+    }
+}
+
+void SpectrumRoot::draw() {
+    display->setCursor(0, 0);
+    display->printf("IN %d %luk ", channel, rates[rate_index] / 2000);
+    if (strongest_bin > 0) {
+        display->printf("| %lu Hz", (uint32_t)strongest_bin * rates[rate_index] / FixedFft::SIZE);
+    }
+
+    for (int x = 0; x < FixedFft::BINS && x < SCREEN_WIDTH; x++) {
+        if (level[x] > 0) {
+            display->drawFastVLine(x, SCREEN_HEIGHT - level[x], level[x], SSD1306_WHITE);
+        }
+        if (peak[x] > level[x]) {
+            display->drawPixel(x, SCREEN_HEIGHT - peak[x], SSD1306_WHITE);
+        }
+    }
+}
+
+void SpectrumRoot::enter() {
+    reset_peaks();
+    if (!sigscoper->start(config)) {
+        Serial.println("Failed to start signal monitoring");
+    }
+
+    display->setTextSize(1);
+    display->setTextColor(SSD1306_WHITE);
+
+    display->clearDisplay();
+    draw();
+    display->display();
+}
+
+void SpectrumRoot::exit() {
+    sigscoper->stop();
+
+    display->clearDisplay();
+    display->display();
+}
+
+void SpectrumRoot::update(Event* event) {
+    if (event == nullptr) return;
+
+    display->clearDisplay();
+
+    bool restart = false;
+
+    // Encoder changes the span, clockwise is narrower like the scope's time scale
+    if (event->encoder > 0 && rate_index > 0) {
+        rate_index--;
+        restart = true;
+    } else if (event->encoder < 0 && rate_index < RATE_COUNT - 1) {
+        rate_index++;
+        restart = true;
+    }
+
+    // Encoder switch selects the input
+    if (event->button_sw == ButtonPress) {
+        channel ^= 1;
+        restart = true;
+    }
+
+    // A short press on A clears the peak hold, holding A switches screens
+    if (event->button_a == ButtonRelease && event->button_a_ms < ScreenSwitcher::SWITCH_HOLD_MS) {
+        reset_peaks();
+    }
+
+    if (restart) {
+        configure();
+        reset_peaks();
+        sigscoper->stop();
+        sigscoper->start(config);
+    }
+
+    if (sigscoper->is_ready()) {
+        analyze();
+    }
+    decay_peaks();
+    draw();
+
+    display->display();
+}
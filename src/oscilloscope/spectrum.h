@@ -0,0 +1,46 @@
+#pragma once
+
+#include "sigscoper.h"
+#include "../urack_types.h"
+#include "oscilloscope.h"
+#include "fixed_fft.h"
+
+// Log magnitude spectrum of one input, one FFT bin per column with peak hold.
+// Runs on the scope's Sigscoper and transforms in the scope's capture memory,
+// which is free while this screen is shown.
+class SpectrumRoot : public ScreenInterface {
+public:
+    SpectrumRoot(Display* display, OscilloscopeRoot* scope);
+    void enter() override;
+    void exit() override;
+    void update(Event* event) override;
+
+private:
+    static const int GRAPH_TOP = 10; // below the status line
+    static const int GRAPH_ROWS = SCREEN_HEIGHT - GRAPH_TOP;
+    static const int DB_RANGE = 60;  // dB from the top row (full scale) to the bottom
+    static const int ADC_SHIFT = 3;  // 12 bit ADC swing to the FFT input range
+    static const uint32_t PEAK_DECAY_MS = 50; // peak hold falls one row this often
+
+    // Sampling rates, the screen spans half of it
+    static const uint8_t RATE_COUNT = 5;
+    const uint32_t rates[RATE_COUNT] = {5000, 10000, 20000, 40000, 80000};
+    uint8_t rate_index = 2;
+    uint8_t channel = 0; // IN 0 or IN 1
+
+    Sigscoper* sigscoper;
+    SigscoperConfig config;
+    int16_t* samples; // scope capture memory
+    FixedFft fft;
+
+    uint8_t level[FixedFft::BINS]; // rows above the bottom
+    uint8_t peak[FixedFft::BINS];
+    int strongest_bin = 0;
+    uint32_t last_decay_ms = 0;
+
+    void configure();
+    void reset_peaks();
+    void analyze();
+    void decay_peaks();
+    void draw();
+};
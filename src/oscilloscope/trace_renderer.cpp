@@ -0,0 +1,128 @@
+#include "trace_renderer.h"
+#include <Adafruit_SSD1306.h>
+#include "../board.h"
+
+TraceRenderer::TraceRenderer() : first_valid(0), last_valid(-1), clip_bottom(0) {
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        rows[i] = 0;
+    }
+}
+
+void TraceRenderer::build(int adc_low, int adc_high, int row_low, int row_high, int clip_top, int clip_bottom) {
+    this->clip_bottom = clip_bottom;
+    first_valid = TABLE_SIZE;
+    last_valid = -1;
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        // Centre of the table step, so the step error is split both ways
+        long code = (i << ADC_SHIFT) + (1 << ADC_SHIFT) / 2;
+        long y = map(code, adc_low, adc_high, row_low, row_high);
+        if (y >= clip_top && y < clip_bottom) {
+            if (i < first_valid) first_valid = i;
+            last_valid = i;
+        } else {
+            y = y < clip_top ? clip_top : clip_bottom - 1;
+        }
+        rows[i] = (uint8_t)y;
+    }
+}
+
+// Rows top .. bottom (inclusive) of column x in screen coordinates
+void TraceRenderer::span(uint8_t* buffer, bool flip, int x, int top, int bottom) {
+    if (flip) {
+        // setRotation(2): both axes mirrored
+        x = SCREEN_WIDTH - 1 - x;
+        int t = SCREEN_HEIGHT - 1 - bottom;
+        bottom = SCREEN_HEIGHT - 1 - top;
+        top = t;
+    }
+
+    uint8_t* column = buffer + x;
+    int page = top >> 3;
+    int last_page = bottom >> 3;
+    uint8_t first_mask = 0xff << (top & 7);
+    uint8_t last_mask = 0xff >> (7 - (bottom & 7));
+
+    if (page == last_page) {
+        column[page * SCREEN_WIDTH] |= first_mask & last_mask;
+        return;
+    }
+    column[page * SCREEN_WIDTH] |= first_mask;
+    for (page++; page < last_page; page++) {
+        column[page * SCREEN_WIDTH] = 0xff;
+    }
+    column[last_page * SCREEN_WIDTH] |= last_mask;
+}
+
+void TraceRenderer::put_span(Display* display, int x, int top, int bottom, uint8_t thickness) const {
+    if (thickness < 1) thickness = 1;
+    if (thickness > MAX_THICKNESS) thickness = MAX_THICKNESS;
+    bottom += thickness - 1;
+    if (bottom >= clip_bottom) bottom = clip_bottom - 1;
+
+    uint8_t rotation = display->getRotation();
+    if (rotation == 0 || rotation == 2) {
+        span(display->getBuffer(), rotation == 2, x, top, bottom);
+    } else {
+        display->drawFastVLine(x, top, bottom - top + 1, SSD1306_WHITE);
+    }
+}
+
+void TraceRenderer::draw(Display* display, const uint16_t* samples, int first, int last, uint8_t thickness) const {
+    uint8_t prev = NO_ROW;
+    uint8_t cur = row(samples[first]);
+    for (int x = first; x <= last; x++) {
+        uint8_t next = x < last ? row(samples[x + 1]) : NO_ROW;
+        if (cur != NO_ROW) {
+            // Reach halfway to each neighbour, which together join up like a line
+            int top = cur;
+            int bottom = cur;
+            if (prev != NO_ROW) {
+                int mid = (cur + prev) / 2;
+                if (mid < top) top = mid;
+                if (mid > bottom) bottom = mid;
+            }
+            if (next != NO_ROW) {
+                int mid = (cur + next) / 2;
+                if (mid < top) top = mid;
+                if (mid > bottom) bottom = mid;
+            }
+            put_span(display, x, top, bottom, thickness);
+        }
+        prev = cur;
+        cur = next;
+    }
+}
+
+void TraceRenderer::draw_bars(Display* display, const uint16_t* low, const uint16_t* high, int first, int last,
+                              uint8_t thickness) const {
+    // Rows of the previous, current and next bar; top comes from high[], bottom from low[]
+    int prev_top = NO_ROW, prev_bottom = NO_ROW;
+    int cur_top = clamped_row(high[first]);
+    int cur_bottom = clamped_row(low[first]);
+    for (int x = first; x <= last; x++) {
+        int next_top = NO_ROW, next_bottom = NO_ROW;
+        if (x < last) {
+            next_top = clamped_row(high[x + 1]);
+            next_bottom = clamped_row(low[x + 1]);
+        }
+        if (cur_top != NO_ROW) {
+            int top = cur_top < cur_bottom ? cur_top : cur_bottom;
+            int bottom = cur_top < cur_bottom ? cur_bottom : cur_top;
+            // Where a neighbour does not overlap, meet it halfway
+            const int neighbour_top[2] = {prev_top, next_top};
+            const int neighbour_bottom[2] = {prev_bottom, next_bottom};
+            for (int n = 0; n < 2; n++) {
+                if (neighbour_top[n] == NO_ROW) continue;
+                int n_top = neighbour_top[n] < neighbour_bottom[n] ? neighbour_top[n] : neighbour_bottom[n];
+                int n_bottom = neighbour_top[n] < neighbour_bottom[n] ? neighbour_bottom[n] : neighbour_top[n];
+                if (n_bottom < top) top = (n_bottom + top + 1) / 2;
+                if (n_top > bottom) bottom = (n_top + bottom) / 2;
+            }
+            put_span(display, x, top, bottom, thickness);
+        }
+        prev_top = cur_top;
+        prev_bottom = cur_bottom;
+        cur_top = next_top;
+        cur_bottom = next_bottom;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include "../urack_types.h"
+
+// Draws a scope trace straight into the SSD1306 page buffer. Samples go
+// through a row table built once per display mode instead of map() per point,
+// and each column is one vertical span (to halfway towards its neighbours)
+// written a page byte at a time, instead of drawLine() and drawPixel() per pixel.
+class TraceRenderer {
+public:
+    static const int ADC_BITS = 12;
+    static const int ADC_SHIFT = 2; // table step in ADC codes, 4 codes is well under a row
+    static const int TABLE_SIZE = (1 << ADC_BITS) >> ADC_SHIFT;
+    static const uint8_t NO_ROW = 0xff;
+    static const uint8_t MAX_THICKNESS = 3;
+
+    TraceRenderer();
+
+    // Codes adc_low .. adc_high map to rows row_low .. row_high as map() would;
+    // samples landing outside rows clip_top .. clip_bottom - 1 are not drawn
+    void build(int adc_low, int adc_high, int row_low, int row_high, int clip_top, int clip_bottom);
+
+    // Draw samples[first .. last] at the matching columns, thickness rows downwards.
+    // Zero samples (no data) and samples outside the clip rows leave gaps.
+    void draw(Display* display, const uint16_t* samples, int first, int last, uint8_t thickness) const;
+
+    // Draw a bar from low[x] to high[x] in each column, joined to the neighbouring
+    // bars. Bars are clipped to the clip rows rather than dropped, so a peak out of
+    // range still reaches the edge. Columns with high[x] == 0 have no data.
+    void draw_bars(Display* display, const uint16_t* low, const uint16_t* high, int first, int last,
+                   uint8_t thickness) const;
+
+private:
+    uint8_t rows[TABLE_SIZE]; // clamped to the clip rows
+    int16_t first_valid;      // table entries inside the clip rows, map() is monotonic
+    int16_t last_valid;
+    uint8_t clip_bottom;
+
+    inline uint8_t row(uint16_t sample) const {
+        if (sample == 0) return NO_ROW;
+        int i = sample >> ADC_SHIFT;
+        if (i < first_valid || i > last_valid) return NO_ROW;
+        return rows[i];
+    }
+
+    inline uint8_t clamped_row(uint16_t sample) const {
+        if (sample == 0) return NO_ROW;
+        int i = sample >> ADC_SHIFT;
+        return rows[i < TABLE_SIZE ? i : TABLE_SIZE - 1];
+    }
+
+    void put_span(Display* display, int x, int top, int bottom, uint8_t thickness) const;
+    static void span(uint8_t* buffer, bool flip, int x, int top, int bottom);
+};
@@ -0,0 +1,63 @@
+#include "trigger_aligner.h"
+
+int32_t TriggerAligner::find_window(const uint16_t* capture, size_t count, uint16_t level,
+                                    int pre_samples, size_t out_count) {
+    if (count <= out_count) return -1;
+
+    const int32_t ONE = 1 << FRAC_BITS;
+    const int32_t middle = (int32_t)(count / 2) << FRAC_BITS;
+    // The last column interpolates towards the sample after it
+    const int32_t last_start = (int32_t)(count - out_count - 1) << FRAC_BITS;
+
+    int32_t best = -1;
+    int32_t best_distance = INT32_MAX;
+    bool armed = false;
+
+    for (size_t i = 1; i < count; i++) {
+        uint16_t a = capture[i - 1];
+        uint16_t b = capture[i];
+        if (a == 0 || b == 0) {
+            armed = false;
+            continue;
+        }
+        if (a + HYSTERESIS <= level) {
+            armed = true;
+        }
+        if (!armed || a >= level || b < level) continue;
+        armed = false;
+
+        int32_t crossing = ((int32_t)(i - 1) << FRAC_BITS) + ((int32_t)(level - a) << FRAC_BITS) / (b - a);
+        int32_t start = crossing - pre_samples * ONE;
+        if (start < 0) continue;
+        if (start > last_start) break;
+
+        int32_t distance = crossing > middle ? crossing - middle : middle - crossing;
+        if (distance < best_distance) {
+            best_distance = distance;
+            best = start;
+        }
+    }
+
+    return best;
+}
+
+void TriggerAligner::resample(const uint16_t* capture, size_t count, int32_t start,
+                              uint16_t* out, size_t out_count) {
+    const int32_t FRAC_MASK = (1 << FRAC_BITS) - 1;
+    int32_t frac = start & FRAC_MASK;
+    size_t idx = start >> FRAC_BITS;
+
+    for (size_t i = 0; i < out_count; i++, idx++) {
+        if (idx >= count) {
+            out[i] = 0;
+            continue;
+        }
+        int32_t a = capture[idx];
+        int32_t b = idx + 1 < count ? capture[idx + 1] : a;
+        if (a == 0 || b == 0) {
+            out[i] = frac == 0 ? a : 0;
+            continue;
+        }
+        out[i] = a + (((b - a) * frac) >> FRAC_BITS);
+    }
+}
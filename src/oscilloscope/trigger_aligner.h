@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Places the trigger of a capture between samples. Sigscoper triggers on a
+// whole sample, so a periodic trace jitters by up to one column from frame to
+// frame. The aligner finds the rising crossing of the trigger level by linear
+// interpolation and resamples the capture so the crossing lands exactly on a
+// chosen column. Positions are Q8 fixed point sample indices.
+class TriggerAligner {
+public:
+    static const int FRAC_BITS = 8;
+    static const uint16_t HYSTERESIS = 24; // ADC codes below the level that re-arm the trigger
+
+    // Start of an out_count sample window that puts a rising crossing of level
+    // pre_samples into the window. Of the crossings that leave room for the whole
+    // window the one nearest the middle of the capture is used. Returns -1 if
+    // there is none.
+    static int32_t find_window(const uint16_t* capture, size_t count, uint16_t level,
+                               int pre_samples, size_t out_count);
+
+    // out[i] = capture at start + i, linearly interpolated. Zero samples (no data)
+    // stay zero rather than being blended into their neighbours.
+    static void resample(const uint16_t* capture, size_t count, int32_t start,
+                         uint16_t* out, size_t out_count);
+};
@@ -0,0 +1,154 @@
+#include "tuner.h"
+#include "../board.h"
+#include <math.h>
+#include <soc/adc_channel.h>
+
+static_assert(OscilloscopeRoot::CAPTURE_MEMORY_SIZE >= PitchDetector::MAX_SAMPLES,
+              "Pitch detector block does not fit the scope capture memory");
+
+static const char* const NOTE_NAMES[12] = {
+    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+TunerRoot::TunerRoot(Display* display, OscilloscopeRoot* scope)
+    : ScreenInterface(display),
+      sigscoper(scope->get_sigscoper()),
+      samples(scope->get_capture_memory()) {
+    config.channel_count = 1;
+    config.trigger_mode = TriggerMode::FREE;
+    config.trigger_level = 0;
+    config.auto_speed = 0.005f;
+    config.buffer_size = PitchDetector::MAX_SAMPLES;
+    configure();
+}
+
+void TunerRoot::configure() {
+    config.channels[0] = channel == 0
+        ? static_cast<adc_channel_t>(ADC1_GPIO36_CHANNEL)
+        : static_cast<adc_channel_t>(ADC1_GPIO37_CHANNEL);
+    config.sampling_rate = high_rate ? HIGH_RATE : LOW_RATE;
+}
+
+void TunerRoot::restart() {
+    configure();
+    misses = 0;
+    sigscoper->stop();
+    sigscoper->start(config);
+}
+
+void TunerRoot::measure() {
+    size_t _pos = 0;
+    sigscoper->get_buffer(0, PitchDetector::MAX_SAMPLES, samples, &_pos);
+    sigscoper->restart();
+
+    float period = detector.detect(samples, PitchDetector::MAX_SAMPLES);
+    if (period <= 0) {
+        // Nothing at this rate, the note may be in the other range
+        if (++misses >= SEARCH_MISSES) {
+            high_rate = !high_rate;
+            restart();
+        }
+        return;
+    }
+    misses = 0;
+
+    float hz = config.sampling_rate / period;
+    if (frequency > 0 && fabsf(1200.0f * log2f(hz / frequency)) < RESET_CENTS) {
+        frequency += (hz - frequency) * SMOOTHING;
+    } else {
+        frequency = hz;
+    }
+    last_pitch_ms = millis();
+
+    if ((high_rate && hz < LOW_BELOW_HZ) || (!high_rate && hz > HIGH_ABOVE_HZ)) {
+        high_rate = !high_rate;
+        restart();
+    }
+}
+
+void TunerRoot::draw() {
+    const int BAR_Y = 56;
+    const int BAR_CENTER = SCREEN_WIDTH / 2;
+    const int BAR_HALF = 50; // pixels for 50 cents
+
+    display->setTextSize(1);
+    display->setCursor(0, 0);
+    display->printf("IN %d", channel);
+
+    if (frequency <= 0 || millis() - last_pitch_ms > HOLD_MS) {
+        display->setTextSize(3);
+        display->setCursor(0, 20);
+        display->print("--");
+        display->setTextSize(1);
+        return;
+    }
+
+    float note = 69.0f + 12.0f * log2f(frequency / A4_HZ);
+    int nearest = (int)lrintf(note);
+    float cents = (note - nearest) * 100.0f;
+    int octave = nearest / 12 - 1;
+
+    display->setCursor(SCREEN_WIDTH / 2, 0);
+    display->printf("%.2f Hz", frequency);
+
+    display->setTextSize(3);
+    display->setCursor(0, 20);
+    display->printf("%s%d", NOTE_NAMES[nearest % 12], octave);
+
+    display->setTextSize(2);
+    display->setCursor(SCREEN_WIDTH - 5 * 12, 24);
+    display->printf("%+.1f", cents);
+    display->setTextSize(1);
+
+    // Cents bar: centre and +-25 marks, a needle at the deviation
+    display->drawFastHLine(BAR_CENTER - BAR_HALF, BAR_Y, 2 * BAR_HALF + 1, SSD1306_WHITE);
+    display->drawFastVLine(BAR_CENTER, BAR_Y - 4, 9, SSD1306_WHITE);
+    display->drawFastVLine(BAR_CENTER - BAR_HALF / 2, BAR_Y - 2, 5, SSD1306_WHITE);
+    display->drawFastVLine(BAR_CENTER + BAR_HALF / 2, BAR_Y - 2, 5, SSD1306_WHITE);
+    int needle = BAR_CENTER + (int)lrintf(cents * BAR_HALF / 50.0f);
+    display->fillRect(needle - 1, BAR_Y - 6, 3, 13, SSD1306_WHITE);
+}
+
+void TunerRoot::enter() {
+    frequency = 0;
+    misses = 0;
+    configure();
+    if (!sigscoper->start(config)) {
+        Serial.println("Failed to start signal monitoring");
+    }
+
+    display->setTextSize(1);
+    display->setTextColor(SSD1306_WHITE);
+
+    display->clearDisplay();
+    draw();
+    display->display();
+}
+
+void TunerRoot::exit() {
+    sigscoper->stop();
+
+    display->setTextSize(1);
+    display->clearDisplay();
+    display->display();
+}
+
+void TunerRoot::update(Event* event) {
+    if (event == nullptr) return;
+
+    display->clearDisplay();
+
+    // Encoder switch selects the input
+    if (event->button_sw == ButtonPress) {
+        channel ^= 1;
+        frequency = 0;
+        restart();
+    }
+
+    if (sigscoper->is_ready()) {
+        measure();
+    }
+    draw();
+
+    display->display();
+}
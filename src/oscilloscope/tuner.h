@@ -0,0 +1,45 @@
+#pragma once
+
+#include "sigscoper.h"
+#include "../urack_types.h"
+#include "oscilloscope.h"
+#include "pitch_detector.h"
+
+// Chromatic tuner: note, cents and frequency of IN 0 (or IN 1). Captures into
+// the scope's capture memory like the spectrum, and switches between a low and
+// a high sampling rate so a block holds at least two periods of low notes and
+// still resolves high ones.
+class TunerRoot : public ScreenInterface {
+public:
+    TunerRoot(Display* display, OscilloscopeRoot* scope);
+    void enter() override;
+    void exit() override;
+    void update(Event* event) override;
+
+private:
+    static const uint32_t LOW_RATE = 5000;   // 20 Hz .. 1.2 kHz
+    static const uint32_t HIGH_RATE = 20000; // 80 Hz .. 5 kHz
+    static constexpr float LOW_BELOW_HZ = 160;  // high rate switches down, below three periods per block
+    static constexpr float HIGH_ABOVE_HZ = 300; // low rate switches up
+    static const uint8_t SEARCH_MISSES = 3;     // blocks without pitch before trying the other rate
+    static const uint32_t HOLD_MS = 500;        // last reading stays up after the signal stops
+    static constexpr float SMOOTHING = 0.3f;    // weight of a new reading
+    static constexpr float RESET_CENTS = 30;    // jumps further than this are a new note
+    static constexpr float A4_HZ = 440;
+
+    Sigscoper* sigscoper;
+    SigscoperConfig config;
+    uint16_t* samples; // scope capture memory
+    PitchDetector detector;
+
+    uint8_t channel = 0;
+    bool high_rate = true;
+    uint8_t misses = 0;
+    float frequency = 0; // smoothed, 0 before the first reading
+    uint32_t last_pitch_ms = 0;
+
+    void configure();
+    void restart();
+    void measure();
+    void draw();
+};
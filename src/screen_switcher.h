@@ -4,6 +4,10 @@
 
 class ScreenSwitcher {
 public:
+    // Holding button A longer than this switches to the next screen (main.cpp);
+    // screens only act on shorter presses of A
+    static const uint32_t SWITCH_HOLD_MS = 400;
+
     // Default constructor
     ScreenSwitcher();
 
@@ -0,0 +1,120 @@
+#include "clock_follower.h"
+
+static inline int64_t abs64(int64_t v) {
+    return v < 0 ? -v : v;
+}
+
+ClockFollower::ClockFollower() {
+    reset();
+}
+
+void ClockFollower::reset(void) {
+    started = false;
+    seeded = false;
+    hold = false;
+    locked = false;
+    good_ticks = 0;
+    tick_count = 0;
+    last_tick_us = 0;
+    last_tick_q8 = 0;
+    t0_q8 = 0;
+    t1_q8 = 0;
+    period_q8 = 0;
+    jitter_q8 = 0;
+}
+
+void ClockFollower::restart(void) {
+    tick_count = 0;
+    hold = true;
+}
+
+void ClockFollower::seed(int64_t period) {
+    period_q8 = period;
+    t0_q8 = last_tick_q8;
+    t1_q8 = last_tick_q8 + period;
+    seeded = true;
+    locked = false;
+    good_ticks = 0;
+}
+
+void ClockFollower::tick(uint32_t timestamp_us) {
+    tick_count = (tick_count + 1) % TICKS_PER_BEAT;
+    hold = false;
+
+    if (!started) {
+        started = true;
+        last_tick_us = timestamp_us;
+        last_tick_q8 = 0;
+        return;
+    }
+
+    uint32_t delta_us = timestamp_us - last_tick_us;
+    last_tick_us = timestamp_us;
+    last_tick_q8 += (int64_t)delta_us << 8;
+
+    if (!seeded) {
+        seed((int64_t)delta_us << 8);
+        return;
+    }
+
+    int64_t error = last_tick_q8 - t1_q8;
+    if (abs64(error) > period_q8 / 2) {
+        // Tempo jump or dropped ticks: start over from the measured interval
+        seed((int64_t)delta_us << 8);
+        return;
+    }
+
+    t0_q8 = t1_q8;
+    t1_q8 += period_q8 + ((error * DLL_B_Q8) >> 8);
+    period_q8 += (error * DLL_C_Q8) >> 8;
+
+    int64_t abs_error = abs64(error);
+    jitter_q8 += (int32_t)((abs_error - (int64_t)jitter_q8) >> 4);
+
+    if (abs_error < period_q8 / 4) {
+        if (good_ticks < LOCK_TICKS) good_ticks++;
+    } else {
+        good_ticks = 0;
+    }
+    locked = good_ticks >= LOCK_TICKS;
+}
+
+void ClockFollower::update(uint32_t now_us) {
+    if (!started) return;
+
+    uint32_t timeout_us = seeded ? (uint32_t)((period_q8 * TIMEOUT_PERIODS) >> 8) : 1000000;
+    if (now_us - last_tick_us > timeout_us) {
+        // Clock stopped, the next tick starts a new measurement
+        started = false;
+        seeded = false;
+        locked = false;
+        good_ticks = 0;
+    }
+}
+
+uint32_t ClockFollower::get_position_q8(uint32_t now_us) const {
+    uint32_t position = tick_count << 8;
+    if (!seeded || hold || t1_q8 <= t0_q8) {
+        return position;
+    }
+
+    int64_t now_q8 = last_tick_q8 + ((int64_t)(uint32_t)(now_us - last_tick_us) << 8);
+    int64_t frac = ((now_q8 - t0_q8) << 8) / (t1_q8 - t0_q8);
+
+    // A tick that arrives ahead of the filtered timeline leaves the position in the
+    // previous tick until the timeline gets there, so it never jumps forward (derived
+    // rates above the tick would lose pulses). Never run ahead into the next tick
+    // before it arrives.
+    if (frac < -255) frac = -255;
+    if (frac > 255) frac = 255;
+    const int64_t beat_q8 = TICKS_PER_BEAT << 8;
+    return (uint32_t)((position + beat_q8 + frac) % beat_q8);
+}
+
+int ClockFollower::get_bpm_x10(void) const {
+    if (!seeded || period_q8 <= 0) return 0;
+
+    // bpm_x10 = 10 * 60 s / (period * TICKS_PER_BEAT)
+    const int64_t numerator = (int64_t)600000000 / TICKS_PER_BEAT * 256;
+    return (int)((numerator + period_q8 / 2) / period_q8);
+}
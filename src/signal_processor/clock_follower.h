@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+
+// External MIDI clock follower based on a second-order delay-locked loop.
+// Incoming tick timestamps are filtered into a smoothed tick timeline, which
+// gives a jitter-free tempo estimate and a tick position that advances
+// continuously between ticks. Times are in microseconds, internal math is
+// fixed point with 8 fractional bits.
+class ClockFollower {
+public:
+    static const uint32_t TICKS_PER_BEAT = 24;
+
+    ClockFollower();
+
+    // Forget all timing, the next tick starts a new measurement
+    void reset(void);
+    // Restart the tick position (MIDI Start) while keeping the tempo estimate
+    void restart(void);
+
+    void tick(uint32_t timestamp_us);
+    // Drop lock if ticks stop arriving
+    void update(uint32_t now_us);
+
+    // Position within the current beat in 1/256 ticks, 0 .. TICKS_PER_BEAT * 256 - 1
+    uint32_t get_position_q8(uint32_t now_us) const;
+    // Ticks received within the current beat
+    uint32_t get_tick_count(void) const { return tick_count; }
+
+    bool is_locked(void) const { return locked; }
+    // Smoothed absolute deviation of incoming ticks from the filtered timeline
+    uint32_t get_jitter_us(void) const { return jitter_q8 >> 8; }
+    // Filtered tempo in tenths of BPM, 0 if unknown
+    int get_bpm_x10(void) const;
+
+private:
+    // Loop gains in 1/256: B ~ sqrt(2) * w, C ~ w^2 with w ~ 0.06 rad per tick
+    static const int64_t DLL_B_Q8 = 22;
+    static const int64_t DLL_C_Q8 = 1;
+    static const int LOCK_TICKS = TICKS_PER_BEAT;      // consecutive good ticks to report lock
+    static const uint32_t TIMEOUT_PERIODS = 4;         // missing periods before dropping lock
+
+    bool started;      // at least one tick received
+    bool seeded;       // period known
+    bool hold;         // position held at tick_count until the next tick
+    bool locked;
+    int good_ticks;
+    uint32_t tick_count;   // ticks within the beat
+    uint32_t last_tick_us; // raw timestamp of the last tick
+    int64_t last_tick_q8;  // unwrapped raw time of the last tick
+    int64_t t0_q8;         // filtered time of the last tick
+    int64_t t1_q8;         // filtered time of the next tick
+    int64_t period_q8;
+    uint32_t jitter_q8;
+
+    void seed(int64_t period);
+};
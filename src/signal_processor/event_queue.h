@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer ring buffer.
+// One side may call push() and the other pop()/peek() concurrently from
+// different tasks or cores without any locking.
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0), overflow_count(0) {}
+
+    // Producer side. Returns false (and counts an overflow) when the queue is full.
+    bool push(const T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= N) {
+            overflow_count.store(overflow_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        items[t & (N - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns nullptr when the queue is empty.
+    const T* peek(void) const {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[h & (N - 1)];
+    }
+
+    // Consumer side. Drops the item returned by peek().
+    void pop(void) {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint32_t get_overflow_count(void) const {
+        return overflow_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    T items[N];
+    std::atomic<uint32_t> head; // written by consumer only
+    std::atomic<uint32_t> tail; // written by producer only
+    std::atomic<uint32_t> overflow_count; // written by producer only
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Gate edges of one output waiting for their due time, oldest first.
+// Due times never go backwards, so an edge never overtakes an earlier one.
+// Deep enough for a 1 ms retrigger pulse or a 96 ppq clock at 300 BPM
+// over the Mozzi output latency plus the longest settle time.
+class GateQueue {
+public:
+    static const uint8_t SIZE = 32; // power of two
+
+    GateQueue() { clear(); }
+
+    void clear(void) {
+        head = 0;
+        count = 0;
+    }
+
+    bool is_empty(void) const { return count == 0; }
+    bool is_full(void) const { return count == SIZE; }
+
+    // Caller makes room first, see is_full()
+    void push(int32_t code, uint32_t due_us) {
+        if (count > 0) {
+            uint32_t last_due = due[(head + count - 1) & (SIZE - 1)];
+            if ((int32_t)(due_us - last_due) < 0) due_us = last_due;
+        }
+        uint8_t tail = (head + count) & (SIZE - 1);
+        codes[tail] = code;
+        due[tail] = due_us;
+        count++;
+    }
+
+    bool is_due(uint32_t now_us) const {
+        return count > 0 && (int32_t)(now_us - due[head]) >= 0;
+    }
+
+    int32_t pop(void) {
+        int32_t code = codes[head];
+        head = (head + 1) & (SIZE - 1);
+        count--;
+        return code;
+    }
+
+private:
+    int32_t codes[SIZE];
+    uint32_t due[SIZE]; // esp_timer_get_time() when each edge is applied
+    uint8_t head;
+    uint8_t count;
+};
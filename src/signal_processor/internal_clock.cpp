@@ -0,0 +1,33 @@
+#include "internal_clock.h"
+
+// ticks per second = bpm_x10 / 10 / 60 * TICKS_PER_BEAT
+//                  = bpm_x10 * TICKS_PER_BEAT / 600
+// ticks per update = bpm_x10 * TICKS_PER_BEAT / (600 * update_rate_hz)
+
+InternalClock::InternalClock(uint32_t update_rate_hz)
+    : phase_period(600 * update_rate_hz), phase_increment(0), phase(0) {
+}
+
+void InternalClock::set_bpm_x10(int bpm_x10) {
+    if (bpm_x10 < 0) bpm_x10 = 0;
+    phase_increment = (uint32_t)bpm_x10 * TICKS_PER_BEAT;
+}
+
+void InternalClock::reset(void) {
+    phase = 0;
+}
+
+uint32_t InternalClock::advance(void) {
+    phase += phase_increment;
+
+    uint32_t ticks = 0;
+    while (phase >= phase_period) {
+        phase -= phase_period;
+        ticks++;
+    }
+    return ticks;
+}
+
+uint16_t InternalClock::get_tick_phase(void) const {
+    return (uint16_t)(((uint64_t)phase << 16) / phase_period);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+// Internal MIDI clock (24 ticks per quarter note) driven by a phase accumulator.
+// advance() is called at a fixed update rate (the Mozzi control rate, which is
+// derived from the audio sample clock). The accumulator works in exact integer
+// units of 1/(600 * update_rate_hz) ticks, so fractional BPM (tenths) is supported
+// and the tick count never drifts over time.
+class InternalClock {
+public:
+    static const uint32_t TICKS_PER_BEAT = 24;
+
+    InternalClock(uint32_t update_rate_hz);
+
+    void set_bpm_x10(int bpm_x10);
+    void reset(void);
+
+    // Advance by one update period. Returns the number of ticks that elapsed (usually 0 or 1).
+    uint32_t advance(void);
+
+    // Position between the last and the next tick, 0..65535
+    uint16_t get_tick_phase(void) const;
+
+private:
+    uint32_t phase_period;    // accumulator units per tick: 600 * update rate
+    uint32_t phase_increment; // accumulator units per update: bpm_x10 * TICKS_PER_BEAT
+    uint32_t phase;
+};
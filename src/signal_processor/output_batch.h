@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../board.h"
+
+// Output writes collected while handling one event.
+// A later write to the same output replaces the earlier one, so each output is
+// written at most once per commit. Writes are tagged CV or gate so the commit can
+// apply all CV changes before any gate edge.
+class OutputBatch {
+public:
+    OutputBatch() { clear(); }
+
+    void clear(void) {
+        for (size_t i = 0; i < OutChannelCount; i++) {
+            kind[i] = KindNone;
+        }
+        count = 0;
+    }
+
+    // code: DAC code for PWM/mozzi outputs, 0/1 for GPIO outputs
+    void set_cv(uint8_t ch, int32_t code) { set(ch, code, KindCv); }
+    void set_gate(uint8_t ch, int32_t code) { set(ch, code, KindGate); }
+
+    void remove(uint8_t ch) {
+        if (ch >= OutChannelCount || kind[ch] == KindNone) return;
+        kind[ch] = KindNone;
+        count--;
+    }
+
+    bool is_empty(void) const { return count == 0; }
+    bool is_cv(uint8_t ch) const { return kind[ch] == KindCv; }
+    bool is_gate(uint8_t ch) const { return kind[ch] == KindGate; }
+    int32_t get(uint8_t ch) const { return code[ch]; }
+
+    bool has_cv(void) const {
+        for (size_t i = 0; i < OutChannelCount; i++) {
+            if (kind[i] == KindCv) return true;
+        }
+        return false;
+    }
+
+    bool has_gate(void) const {
+        for (size_t i = 0; i < OutChannelCount; i++) {
+            if (kind[i] == KindGate) return true;
+        }
+        return false;
+    }
+
+private:
+    enum Kind : uint8_t {
+        KindNone,
+        KindCv,
+        KindGate,
+    };
+
+    int32_t code[OutChannelCount];
+    Kind kind[OutChannelCount];
+    uint8_t count;
+
+    void set(uint8_t ch, int32_t value, Kind k) {
+        if (ch >= OutChannelCount) return;
+        if (kind[ch] == KindNone) count++;
+        kind[ch] = k;
+        code[ch] = value;
+    }
+};
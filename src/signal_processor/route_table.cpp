@@ -0,0 +1,178 @@
+#include "route_table.h"
+
+RouteTable::RouteTable()
+    : poly_mode(PolyOff), gate_settle_us(0), clock_count(0), mozzi_cv(false), revision(0), valid(false) {
+    empty.count = 0;
+    empty_voices.count = 0;
+    for (size_t ch = 0; ch < MIDI_CHANNEL_COUNT; ch++) {
+        voice_lists[ch].count = 0;
+        for (size_t kind = 0; kind < RouteKindCount; kind++) {
+            lists[ch][kind].count = 0;
+        }
+    }
+    for (size_t i = 0; i < 2; i++) {
+        mozzi_enabled[i] = false;
+    }
+}
+
+bool RouteTable::sync(MidiSettingsState* state) {
+    if (valid && state->get_revision() == revision) {
+        return false;
+    }
+    build(state);
+    return true;
+}
+
+void RouteTable::build(MidiSettingsState* state) {
+    // Take the revision first so a change made while building triggers another rebuild
+    revision = state->get_revision();
+
+    // Snapshot the settings once
+    MidiChannel global_channel = state->get_midi_channel();
+    MidiOutType out_type[OutChannelCount];
+    MidiChannel out_channel[OutChannelCount];
+    NotePriority priority[OutChannelCount];
+    GateMode gate_mode[OutChannelCount];
+    poly_mode = state->get_poly_mode();
+    gate_settle_us = state->get_gate_settle_us();
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        out_type[i] = state->get_midi_out_type(i);
+        out_channel[i] = state->get_midi_out_channel(i);
+        priority[i] = state->get_note_priority(i);
+        gate_mode[i] = state->get_gate_mode(i);
+        if (out_channel[i] == MidiChannelUnchanged) {
+            out_channel[i] = global_channel;
+        }
+    }
+
+    for (size_t ch = 0; ch < MIDI_CHANNEL_COUNT; ch++) {
+        VoiceList* voices = &voice_lists[ch];
+        bool poly = poly_mode != PolyOff && build_voices(voices, ch, out_type, out_channel, gate_mode);
+        if (!poly) {
+            voices->count = 0;
+        }
+
+        for (size_t kind = 0; kind < RouteKindCount; kind++) {
+            RouteList* list = &lists[ch][kind];
+            list->count = 0;
+
+            for (size_t i = 0; i < OutChannelCount; i++) {
+                if (out_channel[i] != (MidiChannel)ch && out_channel[i] != MidiChannelAll) continue;
+                if (!is_kind_match((RouteKind)kind, out_type[i])) continue;
+                // Voice outputs get their notes from the voice allocator
+                if (poly && kind == RouteNote && is_voice_out(voices, i)) continue;
+                add(list, i, out_type[i], priority[i], gate_mode[i]);
+            }
+        }
+    }
+
+    clock_count = 0;
+    mozzi_cv = false;
+    for (size_t i = 0; i < 2; i++) {
+        mozzi_enabled[i] = false;
+    }
+
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        if (state->is_clock_type(out_type[i])) {
+            clock_routes[clock_count].out = i;
+            clock_routes[clock_count].period_q8 = state->get_clock_period_q8(out_type[i]);
+            clock_count++;
+        }
+
+        if (OUT_CHANNELS[i].type == OutTypeMozzi) {
+            int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
+            if (mozzi_ch >= 0 && mozzi_ch < 2) {
+                mozzi_enabled[mozzi_ch] = (out_type[i] == MidiOutType::MidiOutMozzi);
+            }
+            if (type_is_cv(out_type[i])) mozzi_cv = true;
+        }
+    }
+
+    valid = true;
+}
+
+bool RouteTable::build_voices(VoiceList* list, uint8_t channel, const MidiOutType* out_type,
+                              const MidiChannel* out_channel, const GateMode* gate_mode) {
+    uint8_t pitch_count = 0;
+    uint8_t gate_count = 0;
+    uint8_t velocity_count = 0;
+
+    for (size_t v = 0; v < OutChannelCount; v++) {
+        list->voices[v].pitch = NO_OUT;
+        list->voices[v].gate = NO_OUT;
+        list->voices[v].velocity = NO_OUT;
+        list->voices[v].gate_mode = GateLegato;
+    }
+
+    // The n-th pitch, gate and velocity outputs of the channel form voice n
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        if (out_channel[i] != (MidiChannel)channel && out_channel[i] != MidiChannelAll) continue;
+
+        if (out_type[i] == MidiOutType::MidiOutPitch) {
+            list->voices[pitch_count++].pitch = i;
+        } else if (out_type[i] == MidiOutType::MidiOutGate) {
+            list->voices[gate_count].gate_mode = gate_mode[i];
+            list->voices[gate_count++].gate = i;
+        } else if (out_type[i] == MidiOutType::MidiOutVelocity) {
+            list->voices[velocity_count++].velocity = i;
+        }
+    }
+
+    list->count = pitch_count > gate_count ? pitch_count : gate_count;
+
+    // Velocity outputs beyond the voices stay mono, as if poly were off
+    for (size_t v = list->count; v < velocity_count; v++) {
+        list->voices[v].velocity = NO_OUT;
+    }
+
+    // A single voice is plain mono
+    return list->count >= 2;
+}
+
+bool RouteTable::is_voice_out(const VoiceList* list, size_t out) {
+    for (size_t v = 0; v < list->count; v++) {
+        const Voice& voice = list->voices[v];
+        if (voice.pitch == out || voice.gate == out || voice.velocity == out) return true;
+    }
+    return false;
+}
+
+bool RouteTable::type_is_cv(MidiOutType type) {
+    return type == MidiOutType::MidiOutPitch ||
+           type == MidiOutType::MidiOutVelocity ||
+           type == MidiOutType::MidiOutAfterTouch ||
+           type == MidiOutType::MidiOutPitchBend ||
+           (type >= MidiOutType::MidiOutCc0 && type <= MidiOutType::MidiOutCc127);
+}
+
+bool RouteTable::is_kind_match(RouteKind kind, MidiOutType type) {
+    // Every message kind is forwarded to the mozzi voice engine
+    if (type == MidiOutType::MidiOutMozzi) return true;
+
+    switch (kind) {
+        case RouteNote:
+            return type == MidiOutType::MidiOutGate ||
+                   type == MidiOutType::MidiOutPitch ||
+                   type == MidiOutType::MidiOutVelocity;
+        case RouteCc:
+            return type >= MidiOutType::MidiOutCc0 && type <= MidiOutType::MidiOutCc127;
+        case RouteAftertouch:
+            return type == MidiOutType::MidiOutAfterTouch;
+        case RoutePitchBend:
+            return type == MidiOutType::MidiOutPitch ||
+                   type == MidiOutType::MidiOutPitchBend;
+        default:
+            return false;
+    }
+}
+
+void RouteTable::add(RouteList* list, size_t out, MidiOutType type, NotePriority priority, GateMode gate_mode) {
+    // MidiOutMozzi is only meaningful on outputs driven by mozzi
+    if (type == MidiOutType::MidiOutMozzi && OUT_CHANNELS[out].type != OutTypeMozzi) return;
+
+    list->routes[list->count].out = out;
+    list->routes[list->count].type = type;
+    list->routes[list->count].priority = priority;
+    list->routes[list->count].gate_mode = gate_mode;
+    list->count++;
+}
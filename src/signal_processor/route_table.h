@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../board.h"
+#include "../midi/midi_settings_state.h"
+
+enum RouteKind {
+    RouteNote,       // note on / note off
+    RouteCc,
+    RouteAftertouch,
+    RoutePitchBend,
+    RouteKindCount
+};
+
+// Compiled view of the output routing settings.
+// Maps (MIDI channel, message kind) to the outputs that react to it, so event
+// handlers do not have to query MidiSettingsState (and take its mutex) per output.
+class RouteTable {
+public:
+    struct Route {
+        uint8_t out;  // OutChannelName
+        uint8_t type; // MidiOutType
+        uint8_t priority;  // NotePriority
+        uint8_t gate_mode; // GateMode
+    };
+
+    struct RouteList {
+        uint8_t count;
+        Route routes[OutChannelCount];
+    };
+
+    static const uint8_t NO_OUT = 0xff;
+
+    // Pitch/gate(/velocity) outputs that play one note in poly mode, NO_OUT if missing
+    struct Voice {
+        uint8_t pitch;
+        uint8_t gate;
+        uint8_t velocity;
+        uint8_t gate_mode; // GateMode of the gate output
+    };
+
+    struct VoiceList {
+        uint8_t count;
+        Voice voices[OutChannelCount];
+    };
+
+    struct ClockRoute {
+        uint8_t out;
+        uint16_t period_q8; // pulse period in 1/256 clock ticks
+    };
+
+    RouteTable();
+
+    // Rebuild the table if settings changed since the last build. Returns true if rebuilt.
+    bool sync(MidiSettingsState* state);
+    void build(MidiSettingsState* state);
+
+    inline const RouteList& get(uint8_t channel, RouteKind kind) const {
+        if (channel >= MIDI_CHANNEL_COUNT) return empty;
+        return lists[channel][kind];
+    }
+
+    // Voices of a channel when poly mode is on. Their outputs are not in the RouteNote list.
+    inline const VoiceList& get_voices(uint8_t channel) const {
+        if (channel >= MIDI_CHANNEL_COUNT) return empty_voices;
+        return voice_lists[channel];
+    }
+    inline PolyMode get_poly_mode(void) const { return poly_mode; }
+    inline uint32_t get_gate_settle_us(void) const { return gate_settle_us; }
+
+    inline uint8_t get_clock_count(void) const { return clock_count; }
+    inline const ClockRoute& get_clock(uint8_t idx) const { return clock_routes[idx]; }
+
+    // True if the mozzi channel (0 or 1) is routed to MidiOutMozzi
+    inline bool is_mozzi_enabled(int mozzi_ch) const { return mozzi_enabled[mozzi_ch]; }
+    // True if a mozzi channel carries a CV (pitch, velocity, CC...), which reaches
+    // the jack later than the directly written outputs
+    inline bool has_mozzi_cv(void) const { return mozzi_cv; }
+
+private:
+    RouteList lists[MIDI_CHANNEL_COUNT][RouteKindCount];
+    RouteList empty;
+    VoiceList voice_lists[MIDI_CHANNEL_COUNT];
+    VoiceList empty_voices;
+    PolyMode poly_mode;
+    uint32_t gate_settle_us;
+    ClockRoute clock_routes[OutChannelCount];
+    uint8_t clock_count;
+    bool mozzi_enabled[2]; // MOZZI_AUDIO_CHANNELS
+    bool mozzi_cv;
+    uint32_t revision;
+    bool valid;
+
+    static bool build_voices(VoiceList* list, uint8_t channel, const MidiOutType* out_type,
+                             const MidiChannel* out_channel, const GateMode* gate_mode);
+    static bool is_voice_out(const VoiceList* list, size_t out);
+    static bool type_is_cv(MidiOutType type);
+    static bool is_kind_match(RouteKind kind, MidiOutType type);
+    static void add(RouteList* list, size_t out, MidiOutType type, NotePriority priority, GateMode gate_mode);
+};
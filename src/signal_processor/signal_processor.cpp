@@ -1,5 +1,6 @@
 #include <MIDI.h>
 #include "signal_processor.h"
+#include <esp_timer.h>
 
 #include <Mozzi.h>
 #if(MOZZI_AUDIO_BITS != PWM_RESOLUTION)
@@ -13,40 +14,42 @@ MIDI_CREATE_INSTANCE(HardwareSerial, Serial2, MIDI);
 
 static SignalProcessor* processor = nullptr;
 
+// Serial MIDI callbacks run from MIDI.read() on the control task; they queue
+// like every other source so all inputs are processed in arrival order.
 void handle_note_on(uint8_t channel, uint8_t note, uint8_t velocity) {
-    processor->handle_note_on(channel, note, velocity);
+    processor->post_event(MidiInputSerial, EventNoteOn, channel, note, velocity);
 }
 
 void handle_note_off(uint8_t channel, uint8_t note, uint8_t velocity) {
-    processor->handle_note_off(channel, note, velocity);
+    processor->post_event(MidiInputSerial, EventNoteOff, channel, note, velocity);
 }
 
 void handle_cc(uint8_t channel, uint8_t cc, uint8_t value) {
-    processor->handle_cc(channel, cc, value);
+    processor->post_event(MidiInputSerial, EventCc, channel, cc, value);
 }
 
 void handle_aftertouch(uint8_t channel, uint8_t value) {
-    processor->handle_aftertouch(channel, value);
+    processor->post_event(MidiInputSerial, EventAftertouch, channel, 0, value);
 }
 
 void handle_pitchbend(uint8_t channel, int value) {
-    processor->handle_pitchbend(channel, value);
+    processor->post_event(MidiInputSerial, EventPitchBend, channel, 0, 0, value);
 }
 
 void handle_clock(void) {
-    processor->handle_clock();
+    processor->post_event(MidiInputSerial, EventClock);
 }
 
 void handle_start(void) {
-    processor->handle_start();
+    processor->post_event(MidiInputSerial, EventStart);
 }
 
 void handle_stop(void) {
-    processor->handle_stop();
+    processor->post_event(MidiInputSerial, EventStop);
 }
 
 SignalProcessor::SignalProcessor(MidiSettingsState* state)
-    : state(state) {
+    : state(state), internal_clock(MOZZI_CONTROL_RATE) {
 
     processor = this;
 
@@ -73,6 +76,8 @@ SignalProcessor::SignalProcessor(MidiSettingsState* state)
 
     for(size_t i = 0; i < OutChannelCount; i++) {
         last_out[i] = 0;
+        out_note[i] = NoteHistory::NO_NOTE;
+        retrigger[i] = 0;
     }
 
     // Initialize pitchbend to center (0 = no bend)
@@ -82,10 +87,7 @@ SignalProcessor::SignalProcessor(MidiSettingsState* state)
     }
 
     // Initialize clock measurement
-    clock_last_time = 0;
     clock_tick_count = 0;
-    clock_measurement_start = 0;
-    internal_clock_last_tick_time = 0;
     
     // Initialize Mozzi arrays
     for(size_t i = 0; i < 2; i++) {
@@ -93,12 +95,36 @@ SignalProcessor::SignalProcessor(MidiSettingsState* state)
         mozzi_out[i] = 0;
     }
     
+    output_hold = false;
+    gates_pending = false;
+
+    audio_cycles_sum = 0;
+    audio_cycles_max = 0;
+    audio_calls = 0;
+    filter_cycles_sum = 0;
+    filter_cycles_max = 0;
+    filter_calls = 0;
+    profile_ticks = 0;
+
+    for (size_t i = 0; i < 2; i++) {
+        for (int n = 0; n < AUDIO_BLOCK_SIZE; n++) {
+            audio_block[i][n] = 0;
+        }
+    }
+    audio_block_pos = AUDIO_BLOCK_SIZE; // render on the first sample
+    control_tick_us = 0;
+    prev_control_tick_us = 0;
+    event_offset = 0;
+
     // Initialize callbacks
-    update_audio_callback = nullptr;
+    render_audio_callback = nullptr;
     event_callback = nullptr;
 }
 
 void SignalProcessor::begin(void) {
+    // Load per-output pitch calibration (NVS must be initialized)
+    calibration.begin();
+
     // Create MIDI task on second core
     xTaskCreatePinnedToCore(
         midi_task,
@@ -116,18 +142,28 @@ static SignalProcessor* signal_processor = nullptr;
 void updateControl() {
     MIDI.read();
     if (signal_processor != nullptr) {
-        signal_processor->clock_routine();
+        signal_processor->start_control_tick();
+        // Raise gates lowered by a retrigger during the previous control tick
+        signal_processor->retrigger_routine();
+        signal_processor->commit_outputs();
+        signal_processor->process_events();
+        signal_processor->sync_routes();
+        bool held = signal_processor->is_output_held();
+        if (!held) {
+            signal_processor->clock_routine();
+        }
         // Update osc_enabled based on output types
-        for (size_t i = 0; i < OutChannelCount; i++) {
-            if (OUT_CHANNELS[i].type == OutTypeMozzi) {
-                int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
-                if (mozzi_ch >= 0 && mozzi_ch < 2) {
-                    signal_processor->osc_enabled[mozzi_ch] = 
-                        (signal_processor->state->get_midi_out_type(i) == MidiOutType::MidiOutMozzi);
-                }
-            }
+        for (size_t i = 0; i < 2; i++) {
+            signal_processor->osc_enabled[i] = !held && signal_processor->routes.is_mozzi_enabled(i);
         }
         
+        signal_processor->commit_outputs();
+        signal_processor->flush_gates();
+
+        if (PROFILE_AUDIO) {
+            signal_processor->report_audio_profile();
+        }
+
         // Call EventControl callback
         if (signal_processor->event_callback != nullptr) {
             ProcessorEvent event = {};
@@ -140,35 +176,43 @@ AudioOutput updateAudio() {
     if (signal_processor == nullptr) {
         return StereoOutput::from8Bit(0, 0);
     }
-    
-    AudioOutputStorage_t left_val, right_val;
-    AudioOutput cb_output = StereoOutput::from8Bit(0, 0);
 
-    // Call update_audio callback if any channel has osc enabled
-    if (signal_processor->update_audio_callback != nullptr && 
-        (signal_processor->osc_enabled[0] || signal_processor->osc_enabled[1])) {
-        cb_output = signal_processor->update_audio_callback();
-    }
+    uint32_t start_cycles = PROFILE_AUDIO ? ESP.getCycleCount() : 0;
 
-    // Left channel (index 0)
-    if (signal_processor->osc_enabled[0]) {
-        left_val = cb_output.l();
-    } else {
-        // mozzi_out contains zero-centered values, use directly
-        left_val = signal_processor->mozzi_out[0];
+    // Sub control-rate timing for gates waiting on their settle time
+    signal_processor->flush_gates();
+
+    if (signal_processor->audio_block_pos >= SignalProcessor::AUDIO_BLOCK_SIZE) {
+        signal_processor->render_block();
     }
+    int pos = signal_processor->audio_block_pos++;
+
+    // Channels without voices play mozzi_out (zero-centered) per sample, so gates
+    // deferred by flush_gates() keep their sub-block timing
+    AudioOutputStorage_t left_val = signal_processor->osc_enabled[0] ?
+        signal_processor->audio_block[0][pos] : signal_processor->mozzi_out[0];
+    AudioOutputStorage_t right_val = signal_processor->osc_enabled[1] ?
+        signal_processor->audio_block[1][pos] : signal_processor->mozzi_out[1];
     
-    // Right channel (index 1)
-    if (signal_processor->osc_enabled[1]) {
-        right_val = cb_output.r();
-    } else {
-        // mozzi_out contains zero-centered values, use directly
-        right_val = signal_processor->mozzi_out[1];
+    if (PROFILE_AUDIO) {
+        signal_processor->profile_audio(ESP.getCycleCount() - start_cycles);
     }
-    
+
     return StereoOutput(left_val, right_val);
 }
 
+void SignalProcessor::render_block(void) {
+    audio_block_pos = 0;
+    if (render_audio_callback != nullptr && (osc_enabled[0] || osc_enabled[1])) {
+        render_audio_callback(audio_block[0], audio_block[1], AUDIO_BLOCK_SIZE);
+    }
+}
+
+void SignalProcessor::start_control_tick(void) {
+    prev_control_tick_us = control_tick_us;
+    control_tick_us = (uint32_t)esp_timer_get_time();
+}
+
 void SignalProcessor::midi_task(void* parameter) {
     signal_processor = static_cast<SignalProcessor*>(parameter);
 
@@ -180,71 +224,176 @@ void SignalProcessor::midi_task(void* parameter) {
             signal_processor->last_out[i] = 255;
         }
     }
+    signal_processor->commit_outputs();
     
     while (true) {
         audioHook();
     }
 }
 
+void SignalProcessor::profile_audio(uint32_t cycles) {
+    audio_cycles_sum += cycles;
+    if (cycles > audio_cycles_max) audio_cycles_max = cycles;
+    audio_calls++;
+}
+
+void SignalProcessor::profile_filter(uint32_t cycles) {
+    filter_cycles_sum += cycles;
+    if (cycles > filter_cycles_max) filter_cycles_max = cycles;
+    filter_calls++;
+}
+
+void SignalProcessor::report_audio_profile(void) {
+    if (++profile_ticks < MOZZI_CONTROL_RATE) return;
+    profile_ticks = 0;
+
+    if (audio_calls > 0) {
+        uint32_t budget = ESP.getCpuFreqMHz() * 1000000 / MOZZI_AUDIO_RATE;
+        Serial.printf("updateAudio: avg %u max %u cycles, budget %u cycles per sample\n",
+                      audio_cycles_sum / audio_calls, audio_cycles_max, budget);
+    }
+    if (filter_calls > 0) {
+        Serial.printf("  filter: avg %u max %u cycles per sample\n",
+                      filter_cycles_sum / filter_calls, filter_cycles_max);
+    }
+    audio_cycles_sum = 0;
+    audio_cycles_max = 0;
+    audio_calls = 0;
+    filter_cycles_sum = 0;
+    filter_cycles_max = 0;
+    filter_calls = 0;
+}
+
+bool SignalProcessor::post_event(MidiInputSource source, ProcessorEventType type, uint8_t channel,
+                                 uint8_t data1, uint8_t data2, int16_t value) {
+    if (source >= MidiInputSourceCount) return false;
+
+    InputEvent event;
+    event.timestamp = (uint32_t)esp_timer_get_time();
+    event.type = type;
+    event.channel = channel;
+    event.data1 = data1;
+    event.data2 = data2;
+    event.value = value;
+    return input_queue[source].push(event);
+}
+
+void SignalProcessor::process_events(void) {
+    while (true) {
+        // Pick the oldest pending event across all sources
+        const InputEvent* oldest = nullptr;
+        size_t oldest_source = 0;
+        for (size_t i = 0; i < MidiInputSourceCount; i++) {
+            const InputEvent* event = input_queue[i].peek();
+            if (event == nullptr) continue;
+            if (oldest == nullptr || (int32_t)(event->timestamp - oldest->timestamp) < 0) {
+                oldest = event;
+                oldest_source = i;
+            }
+        }
+        if (oldest == nullptr) break;
+
+        InputEvent event = *oldest;
+        input_queue[oldest_source].pop();
+
+        // Events received during the previous control period keep their position
+        // in it, one block later. Backlogged ones start the block.
+        event_offset = 0;
+        uint32_t since_tick_us = event.timestamp - prev_control_tick_us;
+        if (AUDIO_SUB_BLOCK_TIMING && (int32_t)since_tick_us > 0) {
+            uint64_t samples = (uint64_t)since_tick_us * MOZZI_AUDIO_RATE / 1000000;
+            event_offset = samples < AUDIO_BLOCK_SIZE ? (int)samples : AUDIO_BLOCK_SIZE - 1;
+        }
+        // While outputs are held the queues are still drained, but events are dropped
+        if (!output_hold) {
+            dispatch_event(event);
+            commit_outputs();
+        }
+    }
+    event_offset = 0;
+}
+
+uint32_t SignalProcessor::get_overflow_count(MidiInputSource source) const {
+    if (source >= MidiInputSourceCount) return 0;
+    return input_queue[source].get_overflow_count();
+}
+
+void SignalProcessor::dispatch_event(const InputEvent& event) {
+    if (event.channel >= MIDI_CHANNEL_COUNT) return;
+
+    switch (event.type) {
+        case EventNoteOn:     handle_note_on(event.channel, event.data1, event.data2); break;
+        case EventNoteOff:    handle_note_off(event.channel, event.data1, event.data2); break;
+        case EventCc:         handle_cc(event.channel, event.data1, event.data2); break;
+        case EventAftertouch: handle_aftertouch(event.channel, event.data2); break;
+        case EventPitchBend:  handle_pitchbend(event.channel, event.value); break;
+        case EventClock:      handle_clock(event.timestamp); break;
+        case EventStart:      handle_start(); break;
+        case EventStop:       handle_stop(); break;
+        default: break;
+    }
+}
+
 void SignalProcessor::clock_routine(void) {
-    unsigned long current_time = millis();
-    
     // Generate internal clock ticks if MidiClkInt
     if (state->get_midi_clk_type() == MidiClkType::MidiClkInt) {
-        int bpm = state->get_bpm();
-        if (bpm > 0) {
-            // Calculate tick interval: (60 seconds * 1000 ms) / (bpm * 24 ticks per beat)
-            unsigned long tick_interval_ms = (60 * 1000) / (bpm * CLOCK_TICKS_PER_BEAT);
-            
-            if (internal_clock_last_tick_time == 0) {
-                // Initialize on first call
-                internal_clock_last_tick_time = current_time;
-                clock_measurement_start = current_time;
+        // clock_routine runs once per control tick, so the accumulator is locked to the audio clock
+        internal_clock.set_bpm_x10(state->get_bpm_x10());
+        uint32_t ticks = internal_clock.advance();
+
+        for (uint32_t t = 0; t < ticks; t++) {
+            clock_tick_count++;
+
+            // Call EventClock callback for internal clock
+            if (event_callback != nullptr) {
+                ProcessorEvent event = {};
+                event_callback(EventClock, event);
+            }
+
+            // Reset clock_tick_count every CLOCK_TICKS_PER_BEAT ticks (one beat)
+            if (clock_tick_count >= CLOCK_TICKS_PER_BEAT) {
                 clock_tick_count = 0;
-            } else {
-                // Check if enough time has passed for next tick
-                if (current_time - internal_clock_last_tick_time >= tick_interval_ms) {
-                    internal_clock_last_tick_time = current_time;
-                    clock_tick_count++;
-                    
-                    // Call EventClock callback for internal clock
-                    if (event_callback != nullptr) {
-                        ProcessorEvent event = {};
-                        event_callback(EventClock, event);
-                    }
-                    
-                    // Reset clock_tick_count every CLOCK_TICKS_PER_BEAT ticks (one beat)
-                    if (clock_tick_count >= CLOCK_TICKS_PER_BEAT) {
-                        clock_tick_count = 0;
-                        clock_measurement_start = current_time;
-                    }
-                }
             }
         }
     }
     
-    // Update all clock outputs based on current clock_tick_count
-    for (int i = 0; i < OutChannelCount; i++) {
-        MidiOutType type = state->get_midi_out_type(i);
-        if (state->is_clock_type(type)) {
-            int division_ticks = state->get_clock_division_ticks(type);
-            if (division_ticks > 0) {
-                // Calculate pulse duration: half of period, but not more than MAX_CLOCK_TICK_DURATION
-                int pulse_duration = division_ticks / 2;
-                if (pulse_duration > MAX_CLOCK_TICK_DURATION) {
-                    pulse_duration = MAX_CLOCK_TICK_DURATION;
-                }
-                
-                // Check if gate should be high based on current clock_tick_count
-                int phase = clock_tick_count % division_ticks;
-                bool should_be_high = phase < pulse_duration;
-                
-                // Update gate state if needed
-                uint8_t target_value = should_be_high ? 255 : 0;
-                if (last_out[i] != target_value) {
-                    out_gate(i, target_value);
-                    last_out[i] = target_value;
-                }
+    // Clock position within the beat in 1/256 ticks
+    uint32_t position_q8;
+    if (state->get_midi_clk_type() == MidiClkType::MidiClkExt) {
+        // Derived outputs follow the filtered timeline, not the raw (jittery) incoming ticks
+        uint32_t now_us = (uint32_t)esp_timer_get_time();
+        clock_follower.update(now_us);
+        position_q8 = clock_follower.get_position_q8(now_us);
+    } else {
+        position_q8 = (clock_tick_count << 8) + (internal_clock.get_tick_phase() >> 8);
+    }
+
+    // Update all clock outputs based on current clock position
+    for (uint8_t r = 0; r < routes.get_clock_count(); r++) {
+        const RouteTable::ClockRoute& route = routes.get_clock(r);
+        int i = route.out;
+        uint32_t period_q8 = route.period_q8;
+        if (period_q8 > 0) {
+            // Calculate pulse duration: half of period in whole ticks, but not more than
+            // MAX_CLOCK_TICK_DURATION. Periods shorter than a tick (48/96 ppq) keep half
+            // their period and are placed by the fractional position.
+            uint32_t pulse_q8 = (period_q8 / 2) & ~0xffu;
+            if (pulse_q8 == 0) {
+                pulse_q8 = period_q8 / 2;
+            }
+            if (pulse_q8 > (MAX_CLOCK_TICK_DURATION << 8)) {
+                pulse_q8 = MAX_CLOCK_TICK_DURATION << 8;
+            }
+            
+            // Check if gate should be high based on current clock position
+            uint32_t phase_q8 = position_q8 % period_q8;
+            bool should_be_high = phase_q8 < pulse_q8;
+            
+            // Update gate state if needed
+            uint8_t target_value = should_be_high ? 255 : 0;
+            if (last_out[i] != target_value) {
+                out_gate(i, target_value);
+                last_out[i] = target_value;
             }
         }
     }
@@ -252,34 +401,28 @@ void SignalProcessor::clock_routine(void) {
 
 void SignalProcessor::out_pitch(int ch, int note, int pitchbend_value)
 {
-    if(ch >= OutChannelCount) return;
+    if(ch >= CAL_OUTPUT_COUNT) return;
     if(ch < 0) return;
 
-    // Calculate pitchbend offset in semitones
+    // Pitchbend offset in semitones, Q12
     // pitchbend_value: -8192 to +8192, 0 = center (no bend)
-    float bend_semitones = (float)pitchbend_value / 8192.0f * PITCHBEND_RANGE_SEMITONES;
-    float bent_note = note + bend_semitones;
+    int32_t bend_q12 = (pitchbend_value * PITCHBEND_RANGE) >> 1;
 
-    if(DEBUG_MIDI_PROCESSOR) Serial.printf("out_pitch: %d, %d (bend: %.2f)\n", ch, note, bend_semitones);
+    if(DEBUG_MIDI_PROCESSOR) Serial.printf("out_pitch: %d, %d (bend: %d)\n", ch, note, pitchbend_value);
 
-    // Calculate value using PWM_ZERO_OFFSET (preserves carefully tuned offset)
-    int v = (bent_note - MIDDLE_NOTE) * PWM_NOTE_SCALE + PWM_ZERO_OFFSET;
-    if (v > int(PWM_MAX_VAL)) return;
+    // Per-output calibrated note table
+    batch.set_cv(ch, calibration.get_pitch_code(ch, note, bend_q12));
+}
 
-    // Map channel to pin for new LEDC API
-    int pin = OUT_CHANNELS[ch].pin;
-    if(OUT_CHANNELS[ch].type == OutTypeMozzi) {
-        // For Mozzi, convert to zero-centered format (Mozzi will add BIAS in audioOutput)
-        // This preserves the PWM_ZERO_OFFSET calibration
-        int mozzi_ch = pin; // pin contains mozzi channel index (0 or 1)
-        if (mozzi_ch >= 0 && mozzi_ch < 2) {
-            mozzi_out[mozzi_ch] = v - MOZZI_AUDIO_BIAS;
-        }
-    } else if(OUT_CHANNELS[ch].type == OutTypePwm) {
-        ledcWrite(pin, v);
-    } else {
-        return;
-    }
+void SignalProcessor::out_code(int ch, int code)
+{
+    if(ch >= CAL_OUTPUT_COUNT) return;
+    if(ch < 0) return;
+
+    if (code < 0) code = 0;
+    if (code > int(PWM_MAX_VAL)) code = PWM_MAX_VAL;
+
+    write_output(ch, code);
 }
 
 void SignalProcessor::out_7bit_value(int pwm_ch, int value)
@@ -287,24 +430,21 @@ void SignalProcessor::out_7bit_value(int pwm_ch, int value)
     if(pwm_ch >= OutChannelCount) return;
     if(pwm_ch < 0) return;
 
-    if(DEBUG_MIDI_PROCESSOR) Serial.printf("out_7bit_value: %d, %d\n", pwm_ch, value);
-    
-    // Calculate value using PWM_ZERO_OFFSET (preserves carefully tuned offset)
-    int v = map(value, 0, (1 << 7) - 1, PWM_ZERO_OFFSET, PWM_MAX_VAL);
-    
-    // Map channel to pin for new LEDC API
-    int pin = OUT_CHANNELS[pwm_ch].pin;
-    if(OUT_CHANNELS[pwm_ch].type == OutTypeMozzi) {
-        // For Mozzi, convert to zero-centered format (Mozzi will add BIAS in audioOutput)
-        // This preserves the PWM_ZERO_OFFSET calibration
-        int mozzi_ch = pin; // pin contains mozzi channel index (0 or 1)
-        if (mozzi_ch >= 0 && mozzi_ch < 2) {
-            mozzi_out[mozzi_ch] = v - MOZZI_AUDIO_BIAS;
-        }
-    } else if(OUT_CHANNELS[pwm_ch].type == OutTypePwm) {
-        ledcWrite(pin, v);
+    write_output(pwm_ch, value_code(pwm_ch, value));
+}
+
+void SignalProcessor::out_value(int pwm_ch, int value)
+{
+    if(pwm_ch >= OutChannelCount) return;
+    if(pwm_ch < 0) return;
+
+    if(DEBUG_MIDI_PROCESSOR) Serial.printf("out_value: %d, %d\n", pwm_ch, value);
+
+    if(OUT_CHANNELS[pwm_ch].type == OutTypeGpio) {
+        // A digital output only has edges, order it like a gate
+        batch.set_gate(pwm_ch, value_code(pwm_ch, value));
     } else {
-        digitalWrite(pin, value > 0 ? HIGH : LOW);
+        batch.set_cv(pwm_ch, value_code(pwm_ch, value));
     }
 }
 
@@ -315,34 +455,219 @@ void SignalProcessor::out_gate(int pwm_ch, int velocity)
 
     if(DEBUG_MIDI_PROCESSOR) Serial.printf("out_gate: %d, %d\n", pwm_ch, velocity);
 
+    if(OUT_CHANNELS[pwm_ch].type == OutTypeGpio) {
+        batch.set_gate(pwm_ch, velocity > 0 ? 1 : 0);
+    } else {
+        // Gate low is the calibrated 0 V code, high is full scale
+        batch.set_gate(pwm_ch, velocity > 0 ? PWM_MAX_VAL : calibration.get_zero_code(pwm_ch));
+    }
+}
+
+int SignalProcessor::value_code(int pwm_ch, int value)
+{
+    if(OUT_CHANNELS[pwm_ch].type == OutTypeGpio) {
+        return value > 0 ? 1 : 0;
+    }
+    // 0 .. 127 maps from the calibrated 0 V code to full scale
+    return map(value, 0, (1 << 7) - 1, calibration.get_zero_code(pwm_ch), PWM_MAX_VAL);
+}
+
+void SignalProcessor::write_output(int pwm_ch, int code)
+{
     // Map channel to pin for new LEDC API
     int pin = OUT_CHANNELS[pwm_ch].pin;
     if(OUT_CHANNELS[pwm_ch].type == OutTypeMozzi) {
         // For Mozzi, convert to zero-centered format (Mozzi will add BIAS in audioOutput)
-        // This preserves the PWM_ZERO_OFFSET calibration
         int mozzi_ch = pin; // pin contains mozzi channel index (0 or 1)
         if (mozzi_ch >= 0 && mozzi_ch < 2) {
-            if (velocity == 0) {
-                mozzi_out[mozzi_ch] = PWM_ZERO_OFFSET - MOZZI_AUDIO_BIAS;
-            } else {
-                mozzi_out[mozzi_ch] = PWM_MAX_VAL - MOZZI_AUDIO_BIAS;
-            }
+            mozzi_out[mozzi_ch] = code - MOZZI_AUDIO_BIAS;
         }
     } else if(OUT_CHANNELS[pwm_ch].type == OutTypePwm) {
-        // For PWM, use original values with PWM_ZERO_OFFSET
-        if (velocity == 0) {
-            ledcWrite(pin, PWM_ZERO_OFFSET);
+        ledcWrite(pin, code);
+    } else {
+        digitalWrite(pin, code > 0 ? HIGH : LOW);
+    }
+}
+
+void SignalProcessor::set_output_hold(bool hold)
+{
+    output_hold = hold;
+    // A deferred gate must not land on an output calibration is driving;
+    // commit_outputs() and flush_gates() drop the gates themselves
+    if (hold) gates_pending = false;
+}
+
+void SignalProcessor::commit_outputs(void)
+{
+    if (output_hold) {
+        // Outputs belong to calibration
+        batch.clear();
+        clear_deferred_gates();
+        return;
+    }
+
+    if (batch.is_empty()) return;
+
+    // CV first, so a gate edge never sees the previous pitch
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        if (batch.is_cv(i)) write_output(i, batch.get(i));
+    }
+
+    // Let the output filters settle; flush_gates() raises the gates once the time is up
+    uint32_t settle_us = routes.get_gate_settle_us();
+    if (!batch.has_cv() || !batch.has_gate()) settle_us = 0;
+    // A CV on A/B leaves through Mozzi's buffer. Direct gates go out that much later,
+    // on and off alike, so they keep their place and length against the CV.
+    uint32_t latency_us = routes.has_mozzi_cv() ? MOZZI_OUTPUT_LATENCY_US : 0;
+
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        if (!batch.is_gate(i)) continue;
+
+        uint32_t delay_us = settle_us;
+        if (OUT_CHANNELS[i].type != OutTypeMozzi) delay_us += latency_us;
+        GateQueue& queue = deferred_gates[i];
+        // Behind any edge still waiting, so edges keep their order and spacing
+        if (delay_us == 0 && queue.is_empty()) {
+            write_output(i, batch.get(i));
         } else {
-            ledcWrite(pin, PWM_MAX_VAL);
+            // Out of room: the oldest edge goes out early rather than being lost
+            if (queue.is_full()) write_output(i, queue.pop());
+            queue.push(batch.get(i), now + delay_us);
+            gates_pending = true;
         }
-    } else {
-        digitalWrite(pin, velocity > 0 ? HIGH : LOW);
+    }
+
+    batch.clear();
+}
+
+void SignalProcessor::flush_gates(void)
+{
+    if (output_hold) {
+        clear_deferred_gates();
+        return;
+    }
+    if (!gates_pending) return;
+
+    uint32_t now = (uint32_t)esp_timer_get_time();
+    bool pending = false;
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        GateQueue& queue = deferred_gates[i];
+        while (queue.is_due(now)) {
+            write_output(i, queue.pop());
+        }
+        if (!queue.is_empty()) pending = true;
+    }
+    gates_pending = pending;
+}
+
+void SignalProcessor::clear_deferred_gates(void)
+{
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        deferred_gates[i].clear();
+    }
+    gates_pending = false;
+}
+
+void SignalProcessor::retrigger_gate(int pwm_ch, int velocity)
+{
+    if (velocity == 0) return;
+
+    // Drop the gate now and raise it again on the next control tick (~1 ms pulse),
+    // so envelopes see a new edge
+    out_gate(pwm_ch, 0);
+    retrigger[pwm_ch] = velocity;
+    last_out[pwm_ch] = velocity;
+}
+
+void SignalProcessor::retrigger_routine(void)
+{
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        if (retrigger[i] != 0) {
+            if (!output_hold) out_gate(i, retrigger[i]);
+            retrigger[i] = 0;
+        }
+    }
+}
+
+uint8_t SignalProcessor::select_note(uint8_t channel, NotePriority priority)
+{
+    switch (priority) {
+        case NotePriorityLow:  return note_history[channel].get_lowest();
+        case NotePriorityLast: return note_history[channel].get_last();
+        case NotePriorityHigh:
+        default:               return note_history[channel].get_highest();
+    }
+}
+
+void SignalProcessor::sync_routes(void)
+{
+    if (!routes.sync(state)) return;
+
+    // Voices may have moved: start allocation over and release gates driven by notes,
+    // their note off would no longer find them
+    for (size_t ch = 0; ch < MIDI_CHANNEL_COUNT; ch++) {
+        voice_allocator[ch].reset(routes.get_voices(ch).count);
+    }
+    for (size_t i = 0; i < OutChannelCount; i++) {
+        if (out_note[i] == NoteHistory::NO_NOTE) continue;
+        out_note[i] = NoteHistory::NO_NOTE;
+        if (state->get_midi_out_type(i) == MidiOutType::MidiOutGate) {
+            retrigger[i] = 0;
+            out_gate(i, 0);
+            last_out[i] = 0;
+        }
+    }
+}
+
+void SignalProcessor::voice_note_on(const RouteTable::Voice& voice, uint8_t channel, uint8_t note, uint8_t velocity)
+{
+    if (voice.pitch != RouteTable::NO_OUT) {
+        out_note[voice.pitch] = note;
+        out_pitch(voice.pitch, note, pitchbend[channel]);
+        last_out[voice.pitch] = note;
+    }
+    if (voice.velocity != RouteTable::NO_OUT) {
+        out_value(voice.velocity, velocity);
+        last_out[voice.velocity] = velocity;
+    }
+    if (voice.gate != RouteTable::NO_OUT) {
+        int i = voice.gate;
+        out_note[i] = note;
+        if (last_out[i] == 0) {
+            out_gate(i, velocity);
+            last_out[i] = velocity;
+        } else if (voice.gate_mode == GateRetrigger) {
+            // Stolen voice
+            retrigger_gate(i, velocity);
+        }
+    }
+}
+
+void SignalProcessor::voice_note_off(const RouteTable::Voice& voice)
+{
+    // keep last note CV after note off
+    if (voice.pitch != RouteTable::NO_OUT) {
+        out_note[voice.pitch] = NoteHistory::NO_NOTE;
+    }
+    if (voice.velocity != RouteTable::NO_OUT) {
+        out_value(voice.velocity, 0);
+        last_out[voice.velocity] = 0;
+    }
+    if (voice.gate != RouteTable::NO_OUT) {
+        int i = voice.gate;
+        out_note[i] = NoteHistory::NO_NOTE;
+        retrigger[i] = 0;
+        out_gate(i, 0);
+        last_out[i] = 0;
     }
 }
 
 void SignalProcessor::handle_note_on(uint8_t channel, uint8_t note, uint8_t velocity) {
     if(DEBUG_MIDI_PROCESSOR) Serial.printf("handle_note_on: %d, %d, %d\n", channel, note, velocity);
 
+    sync_routes();
+
     if (velocity == 0) {
         handle_note_off(channel, note, velocity);
         return;
@@ -354,23 +679,46 @@ void SignalProcessor::handle_note_on(uint8_t channel, uint8_t note, uint8_t velo
         return;
     }
 
-    for (int i = 0; i < OutChannelCount; i++) {
-        if (!is_out_channel_match(i, channel)) continue;
+    const RouteTable::VoiceList& voices = routes.get_voices(channel);
+    if (voices.count > 0) {
+        uint8_t stolen_id;
+        uint8_t v = voice_allocator[channel].note_on(note, note_id, routes.get_poly_mode(), &stolen_id);
+        if (v != VoiceAllocator::NO_VOICE) {
+            voice_note_on(voices.voices[v], channel, note, velocity);
+        }
+    }
 
-        MidiOutType type = state->get_midi_out_type(i);
-        if (type == MidiOutType::MidiOutGate) {
-            out_gate(i, velocity);
-            last_out[i] = velocity;
-        } else if (type == MidiOutType::MidiOutPitch) {
-            out_pitch(i, note, pitchbend[channel]);
-            last_out[i] = note;
-        } else if (type == MidiOutType::MidiOutVelocity) {
-            out_7bit_value(i, velocity);
-            last_out[i] = velocity;
+    const RouteTable::RouteList& list = routes.get(channel, RouteNote);
+    for (uint8_t r = 0; r < list.count; r++) {
+        const RouteTable::Route& route = list.routes[r];
+        int i = route.out;
+        MidiOutType type = (MidiOutType)route.type;
+
+        if (type != MidiOutType::MidiOutMozzi) {
+            // Mono outputs only follow the new note if it wins under the output's priority
+            uint8_t selected = select_note(channel, (NotePriority)route.priority);
+            if (selected != out_note[i]) {
+                out_note[i] = selected;
+
+                if (type == MidiOutType::MidiOutGate) {
+                    if (last_out[i] == 0) {
+                        out_gate(i, velocity);
+                        last_out[i] = velocity;
+                    } else if (route.gate_mode == GateRetrigger) {
+                        retrigger_gate(i, velocity);
+                    }
+                } else if (type == MidiOutType::MidiOutPitch) {
+                    out_pitch(i, selected, pitchbend[channel]);
+                    last_out[i] = selected;
+                } else if (type == MidiOutType::MidiOutVelocity) {
+                    out_value(i, velocity);
+                    last_out[i] = velocity;
+                }
+            }
         }
         
         // Call EventNoteOn callback for OutTypeMozzi channels
-        if (event_callback != nullptr && OUT_CHANNELS[i].type == OutTypeMozzi && type == MidiOutType::MidiOutMozzi) {
+        if (event_callback != nullptr && type == MidiOutType::MidiOutMozzi) {
             int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
             if (mozzi_ch >= 0 && mozzi_ch < 2) {
                 ProcessorEvent event = {};
@@ -387,40 +735,60 @@ void SignalProcessor::handle_note_on(uint8_t channel, uint8_t note, uint8_t velo
 void SignalProcessor::handle_note_off(uint8_t channel, uint8_t note, uint8_t velocity) {
     if(DEBUG_MIDI_PROCESSOR) Serial.printf("handle_note_off: %d, %d, %d\n", channel, note, velocity);
 
+    sync_routes();
+
     uint8_t note_id;
     if (!note_history[channel].pop(note, &note_id)) {
         // Note not in use. Skipping.
         return;
     }
 
-    uint8_t current_note = note_history[channel].get_current();
+    const RouteTable::VoiceList& voices = routes.get_voices(channel);
+    if (voices.count > 0) {
+        // Stolen notes have no voice left to release
+        uint8_t v = voice_allocator[channel].note_off(note_id);
+        if (v != VoiceAllocator::NO_VOICE) {
+            voice_note_off(voices.voices[v]);
+        }
+    }
 
-    for (int i = 0; i < OutChannelCount; i++) {
-        if (!is_out_channel_match(i, channel)) continue;
+    const RouteTable::RouteList& list = routes.get(channel, RouteNote);
+    for (uint8_t r = 0; r < list.count; r++) {
+        const RouteTable::Route& route = list.routes[r];
+        int i = route.out;
+        MidiOutType type = (MidiOutType)route.type;
 
-        MidiOutType type = state->get_midi_out_type(i);
-        
-        if (current_note == NoteHistory::NO_NOTE) {
-            if (type == MidiOutType::MidiOutGate) {
-                out_gate(i, 0);
-                last_out[i] = 0;
-            }
-            if (type == MidiOutType::MidiOutVelocity) {
-                out_7bit_value(i, 0);
-                last_out[i] = 0;
-            }
-        }
+        if (type != MidiOutType::MidiOutMozzi) {
+            uint8_t selected = select_note(channel, (NotePriority)route.priority);
+            if (selected != out_note[i]) {
+                out_note[i] = selected;
 
-        if (type == MidiOutType::MidiOutPitch) {
-            // keep last note CV after note off, with pitchbend applied
-            if (current_note != NoteHistory::NO_NOTE) {
-                out_pitch(i, current_note, pitchbend[channel]);
-                last_out[i] = current_note;
+                if (selected == NoteHistory::NO_NOTE) {
+                    if (type == MidiOutType::MidiOutGate) {
+                        retrigger[i] = 0;
+                        out_gate(i, 0);
+                        last_out[i] = 0;
+                    }
+                    if (type == MidiOutType::MidiOutVelocity) {
+                        out_value(i, 0);
+                        last_out[i] = 0;
+                    }
+                    // keep last note CV after note off
+                } else {
+                    // Fall back to a still held note
+                    if (type == MidiOutType::MidiOutPitch) {
+                        out_pitch(i, selected, pitchbend[channel]);
+                        last_out[i] = selected;
+                    }
+                    if (type == MidiOutType::MidiOutGate && route.gate_mode == GateRetrigger) {
+                        retrigger_gate(i, last_out[i]);
+                    }
+                }
             }
         }
         
         // Call EventNoteOff callback for OutTypeMozzi channels
-        if (event_callback != nullptr && OUT_CHANNELS[i].type == OutTypeMozzi && type == MidiOutType::MidiOutMozzi) {
+        if (event_callback != nullptr && type == MidiOutType::MidiOutMozzi) {
             int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
             if (mozzi_ch >= 0 && mozzi_ch < 2) {
                 ProcessorEvent event = {};
@@ -435,21 +803,23 @@ void SignalProcessor::handle_note_off(uint8_t channel, uint8_t note, uint8_t vel
 }
 
 void SignalProcessor::handle_cc(uint8_t channel, uint8_t cc, uint8_t value) {
+    sync_routes();
+
     // Store last CC number for the channel
     last_cc[channel] = cc;
 
-    for (int i = 0; i < OutChannelCount; i++) {
-        if (!is_out_channel_match(i, channel)) continue;
-
-        MidiOutType type = state->get_midi_out_type(i);
+    const RouteTable::RouteList& list = routes.get(channel, RouteCc);
+    for (uint8_t r = 0; r < list.count; r++) {
+        int i = list.routes[r].out;
+        MidiOutType type = (MidiOutType)list.routes[r].type;
         
         if (type == MidiOutType::MidiOutCc0 + cc) {
-            out_7bit_value(i, value);
+            out_value(i, value);
             last_out[i] = value;
         }
         
         // Call EventCc callback for OutTypeMozzi channels
-        if (event_callback != nullptr && OUT_CHANNELS[i].type == OutTypeMozzi && type == MidiOutType::MidiOutMozzi) {
+        if (event_callback != nullptr && type == MidiOutType::MidiOutMozzi) {
             int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
             if (mozzi_ch >= 0 && mozzi_ch < 2) {
                 ProcessorEvent event = {};
@@ -463,18 +833,20 @@ void SignalProcessor::handle_cc(uint8_t channel, uint8_t cc, uint8_t value) {
 }
 
 void SignalProcessor::handle_aftertouch(uint8_t channel, uint8_t value) {
-    for (int i = 0; i < OutChannelCount; i++) {
-        if (!is_out_channel_match(i, channel)) continue;
+    sync_routes();
 
-        MidiOutType type = state->get_midi_out_type(i);
+    const RouteTable::RouteList& list = routes.get(channel, RouteAftertouch);
+    for (uint8_t r = 0; r < list.count; r++) {
+        int i = list.routes[r].out;
+        MidiOutType type = (MidiOutType)list.routes[r].type;
         
         if (type == MidiOutType::MidiOutAfterTouch) {
-            out_7bit_value(i, value);
+            out_value(i, value);
             last_out[i] = value;
         }
         
         // Call EventAftertouch callback for OutTypeMozzi channels
-        if (event_callback != nullptr && OUT_CHANNELS[i].type == OutTypeMozzi && type == MidiOutType::MidiOutMozzi) {
+        if (event_callback != nullptr && type == MidiOutType::MidiOutMozzi) {
             int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
             if (mozzi_ch >= 0 && mozzi_ch < 2) {
                 ProcessorEvent event = {};
@@ -489,29 +861,31 @@ void SignalProcessor::handle_aftertouch(uint8_t channel, uint8_t value) {
 void SignalProcessor::handle_pitchbend(uint8_t channel, int value) {
     if(DEBUG_MIDI_PROCESSOR) Serial.printf("handle_pitchbend: %d, %d\n", channel, value);
 
+    sync_routes();
+
     // Store raw pitchbend value
     pitchbend[channel] = value;
 
     // For all outputs with MidiOutPitch type, update pitch with pitchbend applied
-    for (int i = 0; i < OutChannelCount; i++) {
-        if (!is_out_channel_match(i, channel)) continue;
-
-        MidiOutType type = state->get_midi_out_type(i);
+    const RouteTable::RouteList& list = routes.get(channel, RoutePitchBend);
+    for (uint8_t r = 0; r < list.count; r++) {
+        int i = list.routes[r].out;
+        MidiOutType type = (MidiOutType)list.routes[r].type;
         
         if (type == MidiOutType::MidiOutPitch) {
-            // Get current note from note history
-            uint8_t current_note = note_history[channel].get_current();
+            // Bend the note the output is playing (priority selected or poly voice)
+            uint8_t current_note = out_note[i];
             if (current_note != NoteHistory::NO_NOTE) {
                 out_pitch(i, current_note, value);
             }
         } else if (type == MidiOutType::MidiOutPitchBend) {
             // Direct pitchbend output (for compatibility)
-            out_7bit_value(i, value >> 7); // Use upper 7 bits
+            out_value(i, value >> 7); // Use upper 7 bits
             last_out[i] = value >> 7;
         }
         
         // Call EventPitchBend callback for OutTypeMozzi channels
-        if (event_callback != nullptr && OUT_CHANNELS[i].type == OutTypeMozzi && type == MidiOutType::MidiOutMozzi) {
+        if (event_callback != nullptr && type == MidiOutType::MidiOutMozzi) {
             int mozzi_ch = OUT_CHANNELS[i].pin; // pin contains mozzi channel index (0 or 1)
             if (mozzi_ch >= 0 && mozzi_ch < 2) {
                 ProcessorEvent event = {};
@@ -523,42 +897,23 @@ void SignalProcessor::handle_pitchbend(uint8_t channel, int value) {
     }
 }
 
-void SignalProcessor::handle_clock(void) {
+void SignalProcessor::handle_clock(uint32_t timestamp_us) {
     if (state->get_midi_clk_type() != MidiClkType::MidiClkExt) return;
 
-    unsigned long current_time = millis();
-    
-    // Start measurement on first clock tick
-    if (clock_measurement_start == 0) {
-        clock_measurement_start = current_time;
-        clock_tick_count = 0;
-    }
-    
-    clock_tick_count++;
+    // Use the receive timestamp from the input queue, not the time of processing
+    clock_follower.tick(timestamp_us);
 
-    // Calculate BPM every CLOCK_TICKS_PER_BEAT ticks (one beat)
-    if (clock_tick_count >= CLOCK_TICKS_PER_BEAT) {
-        unsigned long elapsed_ms = current_time - clock_measurement_start;
-        
-        if (elapsed_ms > 0) {
-            // BPM = (60 seconds * 1000 ms/sec) / (elapsed_ms ms for one beat)
-            // elapsed_ms is already the time for CLOCK_TICKS_PER_BEAT ticks (one beat)
-            int bpm = (60 * 1000) / elapsed_ms;
-            
-            // Clamp to valid range
-            if (bpm < state->get_min_bpm()) bpm = state->get_min_bpm();
-            if (bpm > state->get_max_bpm()) bpm = state->get_max_bpm();
-            
-            state->set_bpm(bpm);
-        }
-        
-        // Reset for next measurement
-        clock_measurement_start = current_time;
-        clock_tick_count = 0;
+    // Publish the filtered tempo once per beat while locked, so the display does not flicker
+    if (clock_follower.is_locked() && clock_follower.get_tick_count() == 0) {
+        int bpm_x10 = clock_follower.get_bpm_x10();
+
+        // Clamp to valid range
+        if (bpm_x10 < state->get_min_bpm_x10()) bpm_x10 = state->get_min_bpm_x10();
+        if (bpm_x10 > state->get_max_bpm_x10()) bpm_x10 = state->get_max_bpm_x10();
+
+        state->set_bpm_x10(bpm_x10);
     }
     
-    clock_last_time = current_time;
-    
     // Call EventClock callback
     if (event_callback != nullptr) {
         ProcessorEvent event = {};
@@ -569,8 +924,7 @@ void SignalProcessor::handle_clock(void) {
 void SignalProcessor::handle_start(void) {
     // Reset clock measurement on start (for external clock)
     if (state->get_midi_clk_type() == MidiClkType::MidiClkExt) {
-        clock_measurement_start = 0;
-        clock_tick_count = 0;
+        clock_follower.restart();
         
         // Lower all clock outputs
         for (size_t i = 0; i < OutChannelCount; i++) {
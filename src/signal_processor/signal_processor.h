@@ -4,6 +4,14 @@
 #include "../urack_types.h"
 #include "../midi/midi_settings_state.h"
 #include "../midi/note_history.h"
+#include "../calibration/calibration.h"
+#include "route_table.h"
+#include "event_queue.h"
+#include "internal_clock.h"
+#include "clock_follower.h"
+#include "voice_allocator.h"
+#include "output_batch.h"
+#include "gate_queue.h"
 
 #include <MozziConfigValues.h>
 #define MOZZI_AUDIO_MODE MOZZI_OUTPUT_PWM
@@ -13,6 +21,7 @@
 #define MOZZI_AUDIO_PIN_1 OUT_CHANNEL_A_PIN
 #define MOZZI_AUDIO_PIN_2 OUT_CHANNEL_B_PIN
 #define MOZZI_ANALOG_READ MOZZI_ANALOG_READ_NONE
+#define MOZZI_OUTPUT_BUFFER_SIZE 256
 
 // Forward declaration for AudioOutput (defined in AudioOutput.h)
 struct StereoOutput;
@@ -59,6 +68,16 @@ union ProcessorEvent {
     } pitchbend;
 };
 
+// Incoming MIDI message, queued by the input sources and consumed on the control core
+struct InputEvent {
+    uint32_t timestamp; // esp_timer_get_time() when the message was received, truncated
+    uint8_t type;       // ProcessorEventType
+    uint8_t channel;    // 1-16
+    uint8_t data1;      // note / cc number
+    uint8_t data2;      // velocity / cc value / aftertouch value
+    int16_t value;      // pitchbend, -8192 to +8191
+};
+
 class SignalProcessor {
 public:
     SignalProcessor(MidiSettingsState* state);
@@ -70,68 +89,149 @@ public:
     void handle_cc(uint8_t channel, uint8_t cc, uint8_t value);
     void handle_aftertouch(uint8_t channel, uint8_t value);
     void handle_pitchbend(uint8_t channel, int value);
-    void handle_clock(void);
+    void handle_clock(uint32_t timestamp_us);
     void handle_start(void);
     void handle_stop(void);
     void clock_routine(void);
+    void retrigger_routine(void); // raise gates after a retrigger pulse, once per control tick
+
+    // Queue a message from an input source. Safe to call from any single task per source,
+    // never blocks. Returns false if the source queue overflowed.
+    bool post_event(MidiInputSource source, ProcessorEventType type, uint8_t channel = 0,
+                    uint8_t data1 = 0, uint8_t data2 = 0, int16_t value = 0);
+    // Drain all source queues in timestamp order. Called from the control task only.
+    void process_events(void);
+    uint32_t get_overflow_count(MidiInputSource source) const;
 
+    // External clock tracking, for UI and telemetry
+    bool is_clock_locked(void) const { return clock_follower.is_locked(); }
+    uint32_t get_clock_jitter_us(void) const { return clock_follower.get_jitter_us(); }
+
+    // updateAudio() cost in CPU cycles per call, collected when PROFILE_AUDIO is set.
+    // The average is per sample; the max is the call that rendered a block.
+    void profile_audio(uint32_t cycles);
+    // Share of that spent in the voice filters, per sample
+    void profile_filter(uint32_t cycles);
+    void report_audio_profile(void);
+
+    // Write a 7 bit value to an output immediately (test mode)
     void out_7bit_value(int pwm_ch, int value);
+    // Write a raw DAC code to output A, B or C (bypasses calibration)
+    void out_code(int ch, int code);
+
+    // Hold outputs for exclusive use (calibration): incoming events are dropped,
+    // clock outputs and mozzi voices stop driving the outputs. Gates still
+    // waiting in flush_gates() are dropped.
+    void set_output_hold(bool hold);
+    bool is_output_held(void) const { return output_hold; }
 
     uint8_t last_out[OutChannelCount];
     uint8_t last_cc[MIDI_CHANNEL_COUNT]; // Last CC number per channel
     int pitchbend[MIDI_CHANNEL_COUNT]; // Raw pitchbend value per channel
     
+    RouteTable routes; // Output routing compiled from state, rebuilt on settings change
+    // Rebuild routes after a settings change and restart voice allocation. Control task only.
+    void sync_routes(void);
+    // Apply the outputs written while handling an event: CV first, then gates,
+    // optionally after the configured settle time. Control task only.
+    void commit_outputs(void);
+    // Apply gates deferred by commit_outputs() once they are due. Audio/control task.
+    void flush_gates(void);
+
+    // A/B are written through Mozzi's output buffer and reach the jack this much
+    // later than C and CLK/RST, which are written directly
+    static const uint32_t MOZZI_OUTPUT_LATENCY_US =
+        (uint64_t)MOZZI_OUTPUT_BUFFER_SIZE * 1000000 / MOZZI_AUDIO_RATE;
+
     bool osc_enabled[2]; // MOZZI_AUDIO_CHANNELS
     int mozzi_out[2]; // MOZZI_AUDIO_CHANNELS
-    
+
+    // The voice engine renders this many samples per call and updateAudio() drains
+    // them. One control period, so events handled in updateControl() take effect on
+    // a block boundary.
+    static const int AUDIO_BLOCK_SIZE = MOZZI_AUDIO_RATE / MOZZI_CONTROL_RATE;
+    int32_t audio_block[2][AUDIO_BLOCK_SIZE]; // MOZZI_AUDIO_CHANNELS, in output range
+    int audio_block_pos;
+    // Fill audio_block for the enabled channels. Audio task only.
+    void render_block(void);
+
+    // Sample offset within the next block of the event being dispatched, from its
+    // receive time, so notes keep their spacing instead of snapping to blocks.
+    // 0 when AUDIO_SUB_BLOCK_TIMING is off.
+    int get_event_offset(void) const { return event_offset; }
+    void start_control_tick(void);
+
     // Callback function types
-    typedef AudioOutput (*UpdateAudioCallback)(void);
+    typedef void (*RenderAudioCallback)(int32_t* left, int32_t* right, int count);
     typedef void (*EventCallback)(ProcessorEventType, ProcessorEvent);
     
     // Callback setters
-    void set_update_audio_callback(UpdateAudioCallback callback) {
-        update_audio_callback = callback;
+    void set_render_audio_callback(RenderAudioCallback callback) {
+        render_audio_callback = callback;
     }
     
     void set_event_callback(EventCallback callback) {
         event_callback = callback;
     }
 
-    UpdateAudioCallback update_audio_callback;
+    RenderAudioCallback render_audio_callback;
     EventCallback event_callback;
 
     static constexpr float PITCHBEND_RANGE_SEMITONES = 2.0f; // Standard MIDI pitchbend range in semitones
+    static constexpr int PITCHBEND_RANGE = (int)PITCHBEND_RANGE_SEMITONES;
+
+    Calibration calibration; // Per-output pitch CV calibration and note tables
 
 private:
-    static constexpr float PWM_NOTE_SCALE = (1 << PWM_RESOLUTION) / (12 * 10.99); // 10.99 Vpp, 12 notes per octave (1 V/oct)
-    static const int PWM_ZERO_OFFSET = 498; // 0 V at MIDDLE_NOTE
-    static const int MIDDLE_NOTE = 60; // C4 (middle C)
         
+    static const size_t INPUT_QUEUE_SIZE = 64; // Events per source
+    SpscQueue<InputEvent, INPUT_QUEUE_SIZE> input_queue[MidiInputSourceCount];
+
     NoteHistory note_history[MIDI_CHANNEL_COUNT];
+    uint8_t out_note[OutChannelCount];  // Held note driving each mono output, NO_NOTE when idle
+    uint8_t retrigger[OutChannelCount]; // Gate level to restore after a retrigger pulse, 0 = none
+    VoiceAllocator voice_allocator[MIDI_CHANNEL_COUNT]; // Poly mode note to voice assignment
     TaskHandle_t midi_task_handle;
     
-    // Clock frequency measurement
+    volatile bool output_hold;
+
+    // Internal clock generation and external clock tracking
     static constexpr int CLOCK_TICKS_PER_BEAT = 24; // MIDI clock sends 24 ticks per quarter note
     static constexpr unsigned long MAX_CLOCK_TICK_DURATION = 4; // Maximum clock pulse duration in ticks
-    unsigned long clock_last_time;
-    int clock_tick_count;
-    unsigned long clock_measurement_start;
-    unsigned long internal_clock_last_tick_time; // Time of last internal clock tick
+    uint32_t clock_tick_count; // Internal clock ticks within the beat
+    InternalClock internal_clock;
+    ClockFollower clock_follower;
+
+    // Audio profiling, see PROFILE_AUDIO
+    uint32_t audio_cycles_sum;
+    uint32_t audio_cycles_max;
+    uint32_t audio_calls;
+    uint32_t filter_cycles_sum;
+    uint32_t filter_cycles_max;
+    uint32_t filter_calls;
+    uint32_t profile_ticks;
+
+    // Sub-block event timing, see get_event_offset()
+    uint32_t control_tick_us;      // esp_timer_get_time() at the current control tick
+    uint32_t prev_control_tick_us; // and at the previous one
+    int event_offset;
     
+    // Pending output writes of the current event, see commit_outputs()
+    OutputBatch batch;
+    GateQueue deferred_gates[OutChannelCount]; // gate edges waiting in flush_gates()
+    bool gates_pending;
+
     void out_gate(int pwm_ch, int velocity);
     void out_pitch(int pwm_ch, int note, int pitchbend_value = 0);
+    void out_value(int pwm_ch, int value);
+    int value_code(int pwm_ch, int value);
+    void write_output(int pwm_ch, int code);
+    void retrigger_gate(int pwm_ch, int velocity);
+    void clear_deferred_gates(void);
+    uint8_t select_note(uint8_t channel, NotePriority priority);
+    void voice_note_on(const RouteTable::Voice& voice, uint8_t channel, uint8_t note, uint8_t velocity);
+    void voice_note_off(const RouteTable::Voice& voice);
     
     static void midi_task(void* parameter);
-
-    inline bool is_global_channel_match(uint8_t channel) const {
-        return (state->get_midi_channel() == channel) ||
-               (state->get_midi_channel() == MidiChannelAll);
-    }
-
-    inline bool is_out_channel_match(int out_channel, uint8_t channel) const {
-        if(state->get_midi_out_channel(out_channel) == MidiChannelUnchanged) return is_global_channel_match(channel);
-
-        return (state->get_midi_out_channel(out_channel) == channel) ||
-               (state->get_midi_out_channel(out_channel) == MidiChannelAll);
-    }
+    void dispatch_event(const InputEvent& event);
 };
@@ -0,0 +1,97 @@
+#include "voice_allocator.h"
+
+VoiceAllocator::VoiceAllocator() {
+    reset(0);
+}
+
+void VoiceAllocator::reset(uint8_t voice_count) {
+    if (voice_count > MAX_VOICES) voice_count = MAX_VOICES;
+
+    for (size_t i = 0; i < ID_COUNT; i++) {
+        voice_of_id[i] = NO_VOICE;
+    }
+    for (size_t v = 0; v < MAX_VOICES; v++) {
+        voices[v].id = NO_ID;
+        voices[v].note = NO_ID;
+        voices[v].started = 0;
+    }
+
+    this->voice_count = voice_count;
+    next_voice = 0;
+    counter = 0;
+}
+
+uint8_t VoiceAllocator::note_on(uint8_t note, uint8_t id, PolyMode mode, uint8_t* stolen_id) {
+    *stolen_id = NO_ID;
+    if (voice_count == 0 || id >= ID_COUNT) return NO_VOICE;
+
+    uint8_t voice = NO_VOICE;
+    switch (mode) {
+        case PolyRoundRobin:
+            voice = find_free(next_voice);
+            if (voice == NO_VOICE) voice = next_voice;
+            break;
+        case PolyReuse:
+            voice = find_same_note(note);
+            if (voice == NO_VOICE) voice = find_free(next_voice);
+            if (voice == NO_VOICE) voice = find_oldest();
+            break;
+        case PolySteal:
+        default:
+            voice = find_free(0);
+            if (voice == NO_VOICE) voice = find_oldest();
+            break;
+    }
+
+    Voice* v = &voices[voice];
+    if (v->id != NO_ID) {
+        *stolen_id = v->id;
+        voice_of_id[v->id] = NO_VOICE;
+    }
+
+    v->id = id;
+    v->note = note;
+    v->started = counter++;
+    voice_of_id[id] = voice;
+
+    next_voice = voice + 1;
+    if (next_voice >= voice_count) next_voice = 0;
+
+    return voice;
+}
+
+uint8_t VoiceAllocator::note_off(uint8_t id) {
+    if (id >= ID_COUNT) return NO_VOICE;
+
+    uint8_t voice = voice_of_id[id];
+    if (voice == NO_VOICE) return NO_VOICE;
+
+    voice_of_id[id] = NO_VOICE;
+    voices[voice].id = NO_ID; // keep note for reuse
+    return voice;
+}
+
+uint8_t VoiceAllocator::find_free(uint8_t start) const {
+    for (uint8_t n = 0; n < voice_count; n++) {
+        uint8_t v = start + n;
+        if (v >= voice_count) v -= voice_count;
+        if (voices[v].id == NO_ID) return v;
+    }
+    return NO_VOICE;
+}
+
+uint8_t VoiceAllocator::find_same_note(uint8_t note) const {
+    // A free voice whose pitch is already there, so the CV does not have to move
+    for (uint8_t v = 0; v < voice_count; v++) {
+        if (voices[v].id == NO_ID && voices[v].note == note) return v;
+    }
+    return NO_VOICE;
+}
+
+uint8_t VoiceAllocator::find_oldest(void) const {
+    uint8_t oldest = 0;
+    for (uint8_t v = 1; v < voice_count; v++) {
+        if ((int32_t)(voices[v].started - voices[oldest].started) < 0) oldest = v;
+    }
+    return oldest;
+}
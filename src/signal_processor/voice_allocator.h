@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../board.h"
+#include "../midi/midi_settings_state.h"
+
+// Assigns the notes of one MIDI channel to a small set of voices (pitch/gate output pairs).
+// Notes are tracked by the id NoteHistory::push() assigned, so note off is a table lookup.
+// Every call scans at most MAX_VOICES voices and is deterministic for a given event stream.
+class VoiceAllocator {
+public:
+    static const size_t MAX_VOICES = OutChannelCount;
+    static const uint8_t NO_VOICE = 0xff;
+    static const uint8_t NO_ID = 0xff;
+    static const size_t ID_COUNT = 128; // NoteHistory ids are below MIDI_NOTES_COUNT
+
+    VoiceAllocator();
+
+    // Release every voice and set the number of voices to allocate from
+    void reset(uint8_t voice_count);
+
+    // Returns the voice for the note, or NO_VOICE if there are no voices.
+    // *stolen_id is the id of the note that lost the voice, NO_ID if it was free.
+    uint8_t note_on(uint8_t note, uint8_t id, PolyMode mode, uint8_t* stolen_id);
+
+    // Returns the voice that played the note, NO_VOICE if it was stolen (or never assigned)
+    uint8_t note_off(uint8_t id);
+
+    uint8_t get_voice_count(void) const { return voice_count; }
+    bool is_active(uint8_t voice) const { return voices[voice].id != NO_ID; }
+
+private:
+    struct Voice {
+        uint8_t id;        // id of the held note, NO_ID when free
+        uint8_t note;      // current or last played note
+        uint32_t started;  // note on order, for oldest-steal
+    };
+
+    Voice voices[MAX_VOICES];
+    uint8_t voice_of_id[ID_COUNT];
+    uint8_t voice_count;
+    uint8_t next_voice; // round robin position
+    uint32_t counter;
+
+    uint8_t find_free(uint8_t start) const;
+    uint8_t find_same_note(uint8_t note) const;
+    uint8_t find_oldest(void) const;
+};
@@ -0,0 +1,122 @@
+// Pitchbend before and after the Q16 ratio table. Before, every bend message
+// set each sounding voice from its float note frequency times powf(); after,
+// the message costs one bend_ratio_q16() lookup and each voice one multiply
+// of its Q16.16 base frequency.
+//
+//   pio test -e native -f test_bench_bend_ratio -v
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+#include <mozzi_midi.h>
+#include "osc/bend.h"
+#include "signal_processor/signal_processor.h"
+
+static const int MESSAGE_COUNT = 100000;
+static const int ROUNDS = 5;
+static const int VOICES = 10;
+static const float RANGE = SignalProcessor::PITCHBEND_RANGE_SEMITONES;
+
+static uint8_t notes[VOICES];
+static Q16n16 base_freq[VOICES];
+static volatile uint32_t sink;
+
+static int bend_value(int message) {
+    return (message * 37) % 16384 - 8192;
+}
+
+// The handler before the table, frequencies in Q16.16 like setFreq_Q16n16()
+static uint32_t bend_pow(int value) {
+    float bend = value / 8192.0f;
+    uint32_t sum = 0;
+    for (int v = 0; v < VOICES; v++) {
+        float freq = Q16n16_to_float(Q16n16_mtof(Q8n0_to_Q16n16(notes[v]))) * powf(2.0f, bend * RANGE / 12.0f);
+        sum += (uint32_t)(freq * 65536.0f);
+    }
+    return sum;
+}
+
+static uint32_t bend_table(int value) {
+    uint32_t ratio = bend_ratio_q16(value);
+    uint32_t sum = 0;
+    for (int v = 0; v < VOICES; v++) {
+        sum += (uint32_t)(((uint64_t)base_freq[v] * ratio) >> 16);
+    }
+    return sum;
+}
+
+// Best of ROUNDS, in messages per second
+template <typename Bend>
+static double measure(Bend bend) {
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        uint32_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int m = 0; m < MESSAGE_COUNT; m++) sum += bend(bend_value(m));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        sink = sum;
+        double rate = MESSAGE_COUNT / elapsed.count();
+        if (rate > best) best = rate;
+    }
+    return best;
+}
+
+void setUp(void) {
+    bend_ratio_init(RANGE);
+    for (int v = 0; v < VOICES; v++) {
+        notes[v] = 36 + v * 7;
+        base_freq[v] = Q16n16_mtof(Q8n0_to_Q16n16(notes[v]));
+    }
+}
+
+void tearDown(void) {}
+
+void test_ratio_accuracy(void) {
+    TEST_ASSERT_EQUAL_UINT32(0x10000, bend_ratio_q16(0));
+
+    double worst = 0;
+    for (int value = -8192; value < 8192; value++) {
+        double exact = pow(2.0, value / 8192.0 * RANGE / 12.0);
+        double cents = 1200.0 * log2(bend_ratio_q16(value) / 65536.0 / exact);
+        if (fabs(cents) > worst) worst = fabs(cents);
+    }
+
+    char message[64];
+    snprintf(message, sizeof(message), "worst error %.3f cent", worst);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(worst < 0.05);
+}
+
+// Both paths land on the same voice frequencies
+void test_frequencies_match(void) {
+    for (int m = 0; m < 1000; m++) {
+        int value = bend_value(m);
+        float bend = value / 8192.0f;
+        uint32_t ratio = bend_ratio_q16(value);
+        for (int v = 0; v < VOICES; v++) {
+            double before = Q16n16_to_float(base_freq[v]) * pow(2.0, bend * RANGE / 12.0);
+            double after = (((uint64_t)base_freq[v] * ratio) >> 16) / 65536.0;
+            TEST_ASSERT_TRUE(fabs(1200.0 * log2(after / before)) < 0.1);
+        }
+    }
+}
+
+void test_bench(void) {
+    double before = measure(bend_pow);
+    double after = measure(bend_table);
+
+    char message[128];
+    snprintf(message, sizeof(message), "%d voices: powf %.2f M messages/s, table %.2f M messages/s (x%.1f)",
+             VOICES, before / 1e6, after / 1e6, after / before);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(after > before);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_ratio_accuracy);
+    RUN_TEST(test_frequencies_match);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,130 @@
+// Voice engine cost per sample, rendering a block per call against one sample
+// per call. Before block rendering, updateAudio() called the voice engine once
+// per sample, so every sample paid for the callback, the osc_enabled[] checks,
+// building the voice list and the filter dispatch. Both paths here call the
+// same render_audio() through SignalProcessor::render_audio_callback, with
+// chords held on both channels as the offline renderer plays them.
+//
+//   pio test -e native -f test_bench_block_render -v
+
+#include <unity.h>
+#include <nvs_flash.h>
+#include <stdio.h>
+#include <chrono>
+#include "signal_processor/signal_processor.h"
+#include "host/hal.h"
+
+void osc_init(SignalProcessor* signal_processor);
+
+static const int BLOCK = SignalProcessor::AUDIO_BLOCK_SIZE;
+static const int BLOCKS = 20000;
+static const int ROUNDS = 5;
+static const int SETTLE_TICKS = 64; // past the attack, so every voice is sounding
+static const uint8_t CHORD[] = {48, 52, 55, 59, 62, 65};
+static const int VOICES = sizeof(CHORD);
+
+static SignalProcessor* processor = nullptr;
+static int ticks = 0;
+static double ns_block = 0;
+static double ns_sample = 0;
+static int32_t check_block[2][4 * BLOCK];
+static int32_t check_sample[2][4 * BLOCK];
+
+// Best of ROUNDS, in ns per sample; count samples per call
+static double measure(int count) {
+    static int32_t left[BLOCK];
+    static int32_t right[BLOCK];
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int b = 0; b < BLOCKS; b++) {
+            for (int n = 0; n < BLOCK; n += count) {
+                processor->render_audio_callback(left + n, right + n, count);
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double ns = elapsed.count() * 1e9 / ((double)BLOCKS * BLOCK);
+        if (best == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+static void render(int32_t out[2][4 * BLOCK], int count) {
+    for (int n = 0; n < 4 * BLOCK; n += count) {
+        processor->render_audio_callback(out[0] + n, out[1] + n, count);
+    }
+}
+
+static void control_hook(void) {
+    if (ticks == 0) {
+        for (int v = 0; v < VOICES; v++) {
+            processor->post_event(MidiInputSerial, EventNoteOn, 1, CHORD[v], 100);
+        }
+    }
+    if (++ticks < SETTLE_TICKS) return;
+
+    ns_block = measure(BLOCK);
+    ns_sample = measure(1);
+    render(check_block, BLOCK);
+    render(check_sample, 1);
+    throw HostStop();
+}
+
+static void audio_sink(int left, int right) {
+    (void)left;
+    (void)right;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+static int32_t swing(const int32_t* out) {
+    int32_t low = out[0];
+    int32_t high = out[0];
+    for (int n = 1; n < 4 * BLOCK; n++) {
+        if (out[n] < low) low = out[n];
+        if (out[n] > high) high = out[n];
+    }
+    return high - low;
+}
+
+// Both paths still play the chord on both channels
+void test_voices_sound(void) {
+    for (int ch = 0; ch < 2; ch++) {
+        TEST_ASSERT_TRUE(swing(check_block[ch]) > 64);
+        TEST_ASSERT_TRUE(swing(check_sample[ch]) > 64);
+    }
+}
+
+void test_bench(void) {
+    char message[128];
+    snprintf(message, sizeof(message), "%d voices per channel: per sample %.1f ns, block of %d %.1f ns per sample (x%.1f)",
+             VOICES, ns_sample, BLOCK, ns_block, ns_sample / ns_block);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(ns_block < ns_sample);
+}
+
+int main(void) {
+    nvs_flash_init();
+
+    MidiSettingsState state;
+    state.begin();
+    state.set_midi_out_type(OutChannelA, MidiOutMozzi);
+    state.set_midi_out_type(OutChannelB, MidiOutMozzi);
+
+    SignalProcessor signal_processor(&state);
+    processor = &signal_processor;
+    osc_init(&signal_processor);
+    host_mozzi_set_hooks(control_hook, audio_sink);
+    try {
+        signal_processor.begin();
+    } catch (const HostStop&) {
+    }
+    processor = nullptr;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_voices_sound);
+    RUN_TEST(test_bench);
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+// NoteHistory before and after the held-note and id masks. The old structure
+// below is the linked list alone: push() sorted the used ids to find a free
+// one and the highest note was a walk over every held note.
+//
+//   pio test -e native -f test_bench_note_history -v
+
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "midi/note_history.h"
+
+static const int EVENT_COUNT = 200000;
+static const int ROUNDS = 5;
+static const uint8_t NO_NOTE = NoteHistory::NO_NOTE;
+
+// Out of line like NoteHistory, which sits in its own translation unit
+#define OUT_OF_LINE __attribute__((noinline))
+
+struct ListNoteHistory {
+    struct Note {
+        uint8_t prev;
+        uint8_t next;
+        bool in_use;
+        uint8_t id;
+    };
+
+    // One entry past NO_NOTE: the old pop() wrote through it when removing the oldest note
+    Note history[NO_NOTE + 1];
+    uint8_t last;
+
+    ListNoteHistory() {
+        for (Note& n : history) n = {NO_NOTE, NO_NOTE, false, 0};
+        last = NO_NOTE;
+    }
+
+    OUT_OF_LINE bool push(uint8_t note, uint8_t* out_id) {
+        if (history[note].in_use) return false;
+
+        uint8_t new_id = 0;
+        if (last != NO_NOTE) {
+            uint8_t used_ids[NO_NOTE];
+            uint8_t ids_count = 0;
+            uint8_t current = last;
+            do {
+                used_ids[ids_count++] = history[current].id;
+                current = history[current].prev;
+            } while (current != NO_NOTE);
+            std::sort(used_ids, used_ids + ids_count);
+            for (uint8_t i = 0; i < ids_count; i++) {
+                if (used_ids[i] != i) {
+                    new_id = i;
+                    break;
+                }
+                new_id = i + 1;
+            }
+        }
+
+        history[note] = {last, NO_NOTE, true, new_id};
+        if (last != NO_NOTE) history[last].next = note;
+        last = note;
+        *out_id = new_id;
+        return true;
+    }
+
+    OUT_OF_LINE bool pop(uint8_t note, uint8_t* out_id) {
+        if (!history[note].in_use) return false;
+        uint8_t prev = history[note].prev;
+        uint8_t next = history[note].next;
+        if (note != last) {
+            history[prev].next = next;
+            history[next].prev = prev;
+        } else {
+            last = prev;
+            if (prev != NO_NOTE) history[prev].next = NO_NOTE;
+        }
+        *out_id = history[note].id;
+        history[note] = {NO_NOTE, NO_NOTE, false, 0};
+        return true;
+    }
+
+    OUT_OF_LINE uint8_t get_highest(void) {
+        if (last == NO_NOTE) return NO_NOTE;
+        uint8_t max_note = last;
+        for (uint8_t current = history[last].prev; current != NO_NOTE; current = history[current].prev) {
+            if (current > max_note) max_note = current;
+        }
+        return max_note;
+    }
+};
+
+struct Event {
+    bool on;
+    uint8_t note;
+};
+
+static std::vector<Event> events;
+
+// Chords of held_notes notes: each event presses a new note or releases a held one,
+// then asks for the highest note like a mono output under high note priority
+static void make_events(int held_notes) {
+    std::mt19937 rng(held_notes);
+    std::uniform_int_distribution<int> pitch(24, 108);
+    std::vector<uint8_t> held;
+    events.clear();
+    while ((int)events.size() < EVENT_COUNT) {
+        if ((int)held.size() < held_notes) {
+            uint8_t note = pitch(rng);
+            if (std::find(held.begin(), held.end(), note) != held.end()) continue;
+            held.push_back(note);
+            events.push_back({true, note});
+        } else {
+            size_t i = rng() % held.size();
+            events.push_back({false, held[i]});
+            held.erase(held.begin() + i);
+        }
+    }
+    for (uint8_t note : held) events.push_back({false, note});
+}
+
+template <typename History>
+static uint32_t replay(History* history, uint8_t (History::*highest)(void)) {
+    uint32_t sum = 0;
+    for (const Event& event : events) {
+        uint8_t id;
+        bool done = event.on ? history->push(event.note, &id) : history->pop(event.note, &id);
+        if (done) sum = sum * 31 + id;
+        sum = sum * 31 + (history->*highest)();
+    }
+    return sum;
+}
+
+// Best of ROUNDS, in events per second
+template <typename History>
+static double measure(uint8_t (History::*highest)(void), uint32_t* checksum) {
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        History* history = new History();
+        auto start = std::chrono::steady_clock::now();
+        *checksum = replay(history, highest);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        delete history;
+        double rate = events.size() / elapsed.count();
+        if (rate > best) best = rate;
+    }
+    return best;
+}
+
+static void bench(int held_notes) {
+    make_events(held_notes);
+    uint32_t before_sum, after_sum;
+    double before = measure(&ListNoteHistory::get_highest, &before_sum);
+    double after = measure(&NoteHistory::get_highest, &after_sum);
+    // Same ids and the same highest note after every event
+    TEST_ASSERT_EQUAL_UINT32(before_sum, after_sum);
+
+    char message[128];
+    snprintf(message, sizeof(message), "%2d held: list %.2f M events/s, masks %.2f M events/s (x%.1f)",
+             held_notes, before / 1e6, after / 1e6, after / before);
+    TEST_MESSAGE(message);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_two_held(void) { bench(2); }
+void test_chord_held(void) { bench(6); }
+void test_sustained_held(void) { bench(32); }
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_two_held);
+    RUN_TEST(test_chord_held);
+    RUN_TEST(test_sustained_held);
+    return UNITY_END();
+}
@@ -0,0 +1,150 @@
+// Events per second through the output routing before and after RouteTable.
+// Before, every event asked MidiSettingsState for the channel and type of every
+// output, each call taking the settings mutex; the loop below is that code from
+// the handlers. After, an event reads its list from the table.
+//
+//   pio test -e native -f test_bench_route_table -v
+
+#include <unity.h>
+#include <nvs_flash.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "signal_processor/route_table.h"
+
+static const int EVENT_COUNT = 200000;
+static const int ROUNDS = 5;
+
+struct Event {
+    uint8_t channel;
+    uint8_t kind; // RouteKind
+    uint8_t cc;
+};
+
+static MidiSettingsState* state;
+static std::vector<Event> events;
+
+// The outputs an event drives, as a bit mask
+static uint32_t select_outputs(MidiOutType type, const Event& event) {
+    switch (event.kind) {
+        case RouteNote:
+            return type == MidiOutGate || type == MidiOutPitch || type == MidiOutVelocity || type == MidiOutMozzi;
+        case RouteCc:
+            return type == MidiOutCc0 + event.cc || type == MidiOutMozzi;
+        case RouteAftertouch:
+            return type == MidiOutAfterTouch || type == MidiOutMozzi;
+        case RoutePitchBend:
+            return type == MidiOutPitch || type == MidiOutPitchBend || type == MidiOutMozzi;
+        default:
+            return false;
+    }
+}
+
+static bool is_global_channel_match(uint8_t channel) {
+    return (state->get_midi_channel() == channel) ||
+           (state->get_midi_channel() == MidiChannelAll);
+}
+
+static bool is_out_channel_match(int out_channel, uint8_t channel) {
+    if (state->get_midi_out_channel(out_channel) == MidiChannelUnchanged) return is_global_channel_match(channel);
+
+    return (state->get_midi_out_channel(out_channel) == channel) ||
+           (state->get_midi_out_channel(out_channel) == MidiChannelAll);
+}
+
+static uint32_t dispatch_settings(const Event& event) {
+    uint32_t outputs = 0;
+    for (int i = 0; i < OutChannelCount; i++) {
+        if (!is_out_channel_match(i, event.channel)) continue;
+        MidiOutType type = state->get_midi_out_type(i);
+        if (select_outputs(type, event)) outputs |= 1 << i;
+    }
+    return outputs;
+}
+
+static uint32_t dispatch_table(RouteTable* routes, const Event& event) {
+    routes->sync(state);
+    uint32_t outputs = 0;
+    const RouteTable::RouteList& list = routes->get(event.channel, (RouteKind)event.kind);
+    for (uint8_t r = 0; r < list.count; r++) {
+        if (select_outputs((MidiOutType)list.routes[r].type, event)) outputs |= 1 << list.routes[r].out;
+    }
+    return outputs;
+}
+
+// Best of ROUNDS, in events per second
+template <typename Dispatch>
+static double measure(Dispatch dispatch, uint32_t* checksum) {
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        uint32_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const Event& event : events) sum = sum * 31 + dispatch(event);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double rate = events.size() / elapsed.count();
+        if (rate > best) best = rate;
+        *checksum = sum;
+    }
+    return best;
+}
+
+static void bench(const char* name) {
+    RouteTable routes;
+    for (const Event& event : events) {
+        TEST_ASSERT_EQUAL_UINT32(dispatch_settings(event), dispatch_table(&routes, event));
+    }
+
+    uint32_t before_sum, after_sum;
+    double before = measure(dispatch_settings, &before_sum);
+    double after = measure([&](const Event& event) { return dispatch_table(&routes, event); }, &after_sum);
+    TEST_ASSERT_EQUAL_UINT32(before_sum, after_sum);
+
+    char message[128];
+    snprintf(message, sizeof(message), "%s: settings %.2f M events/s, route table %.2f M events/s (x%.1f)",
+             name, before / 1e6, after / 1e6, after / before);
+    TEST_MESSAGE(message);
+}
+
+void setUp(void) {
+    state = new MidiSettingsState();
+    state->begin();
+
+    // Notes, CCs, aftertouch and bends spread over all channels
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> channel(1, 16);
+    std::uniform_int_distribution<int> kind(0, RouteKindCount - 1);
+    std::uniform_int_distribution<int> cc(0, 127);
+    events.clear();
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        events.push_back({(uint8_t)channel(rng), (uint8_t)kind(rng), (uint8_t)cc(rng)});
+    }
+}
+
+void tearDown(void) {
+    delete state;
+}
+
+void test_default_routing(void) {
+    bench("default routing");
+}
+
+// Every output on its own channel, one listening to all
+void test_split_routing(void) {
+    state->set_midi_out_type(OutChannelA, MidiOutPitch);
+    state->set_midi_out_type(OutChannelB, (MidiOutType)(MidiOutCc0 + 74));
+    state->set_midi_out_type(OutChannelC, MidiOutAfterTouch);
+    state->set_midi_out_type(OutChannelClk, MidiOutGate);
+    state->set_midi_out_channel(OutChannelA, MidiChannel1);
+    state->set_midi_out_channel(OutChannelB, MidiChannelAll);
+    state->set_midi_out_channel(OutChannelC, (MidiChannel)2);
+    state->set_midi_out_channel(OutChannelClk, MidiChannel1);
+    bench("split routing");
+}
+
+int main(void) {
+    nvs_flash_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_default_routing);
+    RUN_TEST(test_split_routing);
+    return UNITY_END();
+}
@@ -0,0 +1,113 @@
+// Clock outputs faster than MIDI clock (48/96 ppq) from the interpolated tick
+// position, for the internal clock and for external clock through the DLL.
+// Runs SignalProcessor at the control rate and watches the clk and reset jacks.
+//
+//   pio test -e native -f test_clock_outputs
+
+#include <unity.h>
+#include <nvs_flash.h>
+#include <vector>
+#include "signal_processor/signal_processor.h"
+#include "host/hal.h"
+
+static const uint32_t WARM_UP_TICKS = 2 * MOZZI_CONTROL_RATE; // lets the DLL lock
+static const uint32_t COUNT_TICKS = 4 * MOZZI_CONTROL_RATE;
+
+struct Jack {
+    uint8_t pin;
+    int level;
+    std::vector<uint32_t> edges; // control ticks of rising edges after the warm-up
+};
+
+static SignalProcessor* processor = nullptr;
+static Jack jacks[2];
+static uint32_t control_ticks = 0;
+static uint64_t midi_tick_us = 0; // 0 = internal clock
+static uint64_t next_midi_tick_us = 0;
+
+static void control_hook(void) {
+    // External clock arrives whenever the control task gets to it, up to a control period late
+    if (midi_tick_us > 0 && host_get_time_us() >= next_midi_tick_us) {
+        processor->post_event(MidiInputSerial, EventClock);
+        next_midi_tick_us += midi_tick_us;
+    }
+
+    for (Jack& jack : jacks) {
+        int level = digitalRead(jack.pin);
+        if (level && !jack.level && control_ticks >= WARM_UP_TICKS) jack.edges.push_back(control_ticks);
+        jack.level = level;
+    }
+
+    if (++control_ticks >= WARM_UP_TICKS + COUNT_TICKS) throw HostStop();
+}
+
+static void run(MidiClkType clk_type, int bpm_x10) {
+    MidiSettingsState state;
+    state.begin();
+    state.set_midi_clk_type(clk_type);
+    state.set_bpm_x10(bpm_x10);
+    state.set_midi_out_type(OutChannelClk, MidiOutClock96);
+    state.set_midi_out_type(OutChannelRst, MidiOutClock48);
+
+    jacks[0] = {(uint8_t)OUT_CHANNELS[OutChannelClk].pin, 0, {}};
+    jacks[1] = {(uint8_t)OUT_CHANNELS[OutChannelRst].pin, 0, {}};
+    control_ticks = 0;
+    midi_tick_us = clk_type == MidiClkExt ? 600000000ull / (bpm_x10 * ClockFollower::TICKS_PER_BEAT) : 0;
+    next_midi_tick_us = 0;
+
+    SignalProcessor signal_processor(&state);
+    processor = &signal_processor;
+    host_mozzi_set_hooks(control_hook, nullptr);
+    try {
+        signal_processor.begin();
+    } catch (const HostStop&) {
+    }
+    processor = nullptr;
+}
+
+// Pulses per quarter note at bpm_x10 over the counted span, one either way for
+// where the span starts, and no gap off by more than max_error control ticks
+static void check_jack(const Jack& jack, int ppq, int bpm_x10, double max_error) {
+    double per_tick = (double)bpm_x10 * ppq / 600.0 / MOZZI_CONTROL_RATE;
+    int expected = (int)(per_tick * COUNT_TICKS + 0.5);
+    char message[64];
+    snprintf(message, sizeof(message), "%d ppq at bpm_x10 %d", ppq, bpm_x10);
+    TEST_ASSERT_INT_WITHIN_MESSAGE(1, expected, (int)jack.edges.size(), message);
+
+    for (size_t e = 1; e < jack.edges.size(); e++) {
+        double gap = jack.edges[e] - jack.edges[e - 1];
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(max_error, 1.0 / per_tick, gap, message);
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Edges land on the control tick they fall due, so a gap is off by less than one
+void test_internal_clock(void) {
+    run(MidiClkInt, 1200);
+    check_jack(jacks[0], 96, 1200, 1.0);
+    check_jack(jacks[1], 48, 1200, 1.0);
+}
+
+// Incoming ticks are up to a control period late; the DLL smooths that out
+void test_external_clock(void) {
+    run(MidiClkExt, 1250);
+    check_jack(jacks[0], 96, 1250, 1.5);
+    check_jack(jacks[1], 48, 1250, 1.5);
+}
+
+void test_external_fast_clock(void) {
+    run(MidiClkExt, 2400);
+    check_jack(jacks[0], 96, 2400, 1.5);
+    check_jack(jacks[1], 48, 2400, 1.5);
+}
+
+int main(void) {
+    nvs_flash_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_internal_clock);
+    RUN_TEST(test_external_clock);
+    RUN_TEST(test_external_fast_clock);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+// FixedFft against a double precision DFT of the same windowed input.
+//
+//   pio test -e native -f test_fixed_fft
+
+#include <unity.h>
+#include <math.h>
+#include <complex>
+#include "oscilloscope/fixed_fft.h"
+
+static FixedFft fft;
+
+static void fill_sine(int16_t* samples, double bin, double amplitude, double phase) {
+    for (int i = 0; i < FixedFft::SIZE; i++) {
+        samples[i] = (int16_t)lrint(amplitude * sin(2 * M_PI * bin * i / FixedFft::SIZE + phase));
+    }
+}
+
+// Magnitude of every bin of the windowed samples, scaled by 1 / SIZE like transform()
+static void reference_dft(const int16_t* windowed, double* magnitude) {
+    for (int k = 0; k < FixedFft::BINS; k++) {
+        std::complex<double> sum = 0;
+        for (int i = 0; i < FixedFft::SIZE; i++) {
+            sum += (double)windowed[i] * std::polar(1.0, -2 * M_PI * k * i / FixedFft::SIZE);
+        }
+        magnitude[k] = std::abs(sum) / FixedFft::SIZE;
+    }
+}
+
+static double bin_magnitude(const int16_t* data, int k) {
+    return hypot(data[2 * k], data[2 * k + 1]);
+}
+
+static int peak_bin(const int16_t* data) {
+    int peak = 1;
+    for (int k = 2; k < FixedFft::BINS; k++) {
+        if (FixedFft::power_db_q4(data[2 * k], data[2 * k + 1]) >
+            FixedFft::power_db_q4(data[2 * peak], data[2 * peak + 1])) peak = k;
+    }
+    return peak;
+}
+
+// Transform a sine and compare every bin but DC with the reference
+static void check_sine(double bin, double amplitude) {
+    int16_t data[FixedFft::SIZE];
+    double reference[FixedFft::BINS];
+    char message[64];
+    snprintf(message, sizeof(message), "bin %.1f amplitude %.0f", bin, amplitude);
+
+    fill_sine(data, bin, amplitude, 0.3);
+    fft.window(data);
+    reference_dft(data, reference);
+    fft.transform(data);
+
+    // Halving every stage rounds off about one code per stage
+    for (int k = 1; k < FixedFft::BINS; k++) {
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(3.0, reference[k], bin_magnitude(data, k), message);
+    }
+    TEST_ASSERT_INT_WITHIN_MESSAGE(0, (int)lround(bin), peak_bin(data), message);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_bin_centred_sine(void) {
+    for (double bin : {1.0, 5.0, 31.0, 64.0, 120.0, 127.0}) {
+        check_sine(bin, FixedFft::INPUT_LIMIT - 1);
+    }
+}
+
+void test_off_bin_sine(void) {
+    for (double bin : {2.5, 17.3, 50.8, 100.4}) {
+        check_sine(bin, FixedFft::INPUT_LIMIT - 1);
+    }
+}
+
+void test_quiet_sine(void) {
+    for (double amplitude : {1600.0, 160.0, 16.0}) {
+        check_sine(10.0, amplitude);
+        check_sine(77.0, amplitude);
+    }
+}
+
+// A full scale sine reads 0 dBFS, and 20 dB less per tenth of the amplitude down to -40 dBFS
+void test_level(void) {
+    int16_t data[FixedFft::SIZE];
+    double amplitude = FixedFft::INPUT_LIMIT;
+    for (int step = 0; step < 3; step++, amplitude /= 10) {
+        fill_sine(data, 20, amplitude, 0);
+        fft.window(data);
+        fft.transform(data);
+        double dbfs = (FixedFft::power_db_q4(data[40], data[41]) - FixedFft::FULL_SCALE_DB_Q4) / 16.0;
+        TEST_ASSERT_FLOAT_WITHIN(1.0, -20.0 * step, dbfs);
+    }
+}
+
+// Rounding noise away from the peak stays 60 dB down
+void test_noise_floor(void) {
+    int16_t data[FixedFft::SIZE];
+    fill_sine(data, 20, FixedFft::INPUT_LIMIT - 1, 0);
+    fft.window(data);
+    fft.transform(data);
+    for (int k = 30; k < FixedFft::BINS; k++) {
+        double dbfs = (FixedFft::power_db_q4(data[2 * k], data[2 * k + 1]) - FixedFft::FULL_SCALE_DB_Q4) / 16.0;
+        TEST_ASSERT_LESS_THAN(-60.0, dbfs);
+    }
+}
+
+// DC lands in bin 0, Nyquist in the imaginary part of bin 0
+void test_dc_and_nyquist(void) {
+    int16_t data[FixedFft::SIZE];
+    for (int i = 0; i < FixedFft::SIZE; i++) data[i] = 8000;
+    fft.transform(data);
+    TEST_ASSERT_INT_WITHIN(8, 8000, data[0]);
+    TEST_ASSERT_INT_WITHIN(2, 0, data[1]);
+    for (int k = 1; k < FixedFft::BINS; k++) TEST_ASSERT_LESS_THAN(3.0, bin_magnitude(data, k));
+
+    for (int i = 0; i < FixedFft::SIZE; i++) data[i] = i & 1 ? -8000 : 8000;
+    fft.transform(data);
+    TEST_ASSERT_INT_WITHIN(8, 0, data[0]);
+    TEST_ASSERT_INT_WITHIN(8, 8000, data[1]);
+    for (int k = 1; k < FixedFft::BINS; k++) TEST_ASSERT_LESS_THAN(3.0, bin_magnitude(data, k));
+}
+
+void test_power_db(void) {
+    TEST_ASSERT_EQUAL_INT(0, FixedFft::power_db_q4(0, 0));
+    // 10 log10(4096^2) = 72.25 dB
+    TEST_ASSERT_INT_WITHIN(1, 1156, FixedFft::power_db_q4(4096, 0));
+    TEST_ASSERT_INT_WITHIN(1, FixedFft::power_db_q4(0, 4096), FixedFft::power_db_q4(4096, 0));
+    TEST_ASSERT_INT_WITHIN(1, FixedFft::power_db_q4(4096, 0) + 48, FixedFft::power_db_q4(4096, 4096));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bin_centred_sine);
+    RUN_TEST(test_off_bin_sine);
+    RUN_TEST(test_quiet_sine);
+    RUN_TEST(test_level);
+    RUN_TEST(test_noise_floor);
+    RUN_TEST(test_dc_and_nyquist);
+    RUN_TEST(test_power_db);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+// Gates on the directly written jacks wait out the Mozzi output latency when a
+// CV leaves through A/B. Edges committed closer together than that latency all
+// go out at their own due time, none is pulled forward by the next one.
+// Runs SignalProcessor and watches the gate jack every audio sample.
+//
+//   pio test -e native -f test_gate_latency
+
+#include <unity.h>
+#include <nvs_flash.h>
+#include <stdio.h>
+#include <vector>
+#include "signal_processor/signal_processor.h"
+#include "host/hal.h"
+
+static const uint32_t LATENCY_US = SignalProcessor::MOZZI_OUTPUT_LATENCY_US;
+static const uint32_t SAMPLE_US = 1000000 / MOZZI_AUDIO_RATE + 1;
+static const uint32_t START_TICK = 16;
+static const uint32_t END_TICK = START_TICK + 32;
+
+struct Step {
+    uint32_t tick; // control ticks after START_TICK
+    ProcessorEventType type;
+    uint8_t note;
+};
+
+// Note on/off 2-3 ms apart, all inside one output latency
+static const Step STEPS[] = {
+    {0, EventNoteOn, 60},
+    {3, EventNoteOff, 60},
+    {5, EventNoteOn, 64},
+    {7, EventNoteOff, 64},
+};
+static const size_t STEP_COUNT = sizeof(STEPS) / sizeof(STEPS[0]);
+
+struct Edge {
+    uint64_t time_us;
+    int level;
+};
+
+static SignalProcessor* processor = nullptr;
+static const uint8_t GATE_PIN = OUT_CHANNELS[OutChannelClk].pin;
+static uint32_t control_ticks = 0;
+static uint64_t commit_us[STEP_COUNT];
+static int gate_level = 0;
+static std::vector<Edge> edges;
+
+static void control_hook(void) {
+    for (size_t s = 0; s < STEP_COUNT; s++) {
+        if (control_ticks != START_TICK + STEPS[s].tick) continue;
+        // Handled in this control tick's updateControl(), at the same time
+        processor->post_event(MidiInputSerial, STEPS[s].type, 1, STEPS[s].note, STEPS[s].type == EventNoteOn ? 100 : 0);
+        commit_us[s] = host_get_time_us();
+    }
+    if (++control_ticks >= END_TICK) throw HostStop();
+}
+
+static void audio_sink(int left, int right) {
+    (void)left;
+    (void)right;
+    int level = digitalRead(GATE_PIN);
+    if (level != gate_level) edges.push_back({host_get_time_us(), level});
+    gate_level = level;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_edges_keep_their_due_time(void) {
+    TEST_ASSERT_EQUAL_UINT32(STEP_COUNT, edges.size());
+    for (size_t s = 0; s < STEP_COUNT; s++) {
+        TEST_ASSERT_EQUAL_INT(STEPS[s].type == EventNoteOn ? 1 : 0, edges[s].level);
+        uint64_t due = commit_us[s] + LATENCY_US;
+        char message[64];
+        snprintf(message, sizeof(message), "edge %u: %lld us after its due time", (unsigned)s, (long long)(edges[s].time_us - due));
+        TEST_ASSERT_TRUE_MESSAGE(edges[s].time_us >= due, message);
+        TEST_ASSERT_TRUE_MESSAGE(edges[s].time_us <= due + SAMPLE_US, message);
+    }
+}
+
+int main(void) {
+    nvs_flash_init();
+
+    MidiSettingsState state;
+    state.begin();
+    state.set_gate_settle_us(0);
+    state.set_midi_out_type(OutChannelA, MidiOutPitch);
+    state.set_midi_out_type(OutChannelClk, MidiOutGate);
+
+    SignalProcessor signal_processor(&state);
+    processor = &signal_processor;
+    host_mozzi_set_hooks(control_hook, audio_sink);
+    try {
+        signal_processor.begin();
+    } catch (const HostStop&) {
+    }
+    processor = nullptr;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_edges_keep_their_due_time);
+    return UNITY_END();
+}
@@ -0,0 +1,98 @@
+// InternalClock over simulated time at the Mozzi control rate.
+//
+//   pio test -e native -f test_internal_clock
+
+#include <unity.h>
+#include "signal_processor/internal_clock.h"
+
+static const uint32_t UPDATE_RATE_HZ = 1024; // MOZZI_CONTROL_RATE
+static const uint32_t TEN_MINUTES = UPDATE_RATE_HZ * 600;
+
+// Ten minutes at bpm_x10 / 10 BPM are bpm_x10 beats, and the clock may not
+// lose or gain a single tick
+static void check_ten_minutes(int bpm_x10) {
+    char message[32];
+    snprintf(message, sizeof(message), "bpm_x10 %d", bpm_x10);
+
+    InternalClock clock(UPDATE_RATE_HZ);
+    clock.set_bpm_x10(bpm_x10);
+    uint32_t ticks = 0;
+    uint32_t last_tick = 0;
+    for (uint32_t update = 1; update <= TEN_MINUTES; update++) {
+        uint32_t elapsed = clock.advance();
+        if (elapsed == 0) continue;
+        ticks += elapsed;
+
+        // Each tick lands on the update where it falls due, never an update late
+        uint32_t due = (uint32_t)(((uint64_t)ticks * 600 * UPDATE_RATE_HZ + bpm_x10 * InternalClock::TICKS_PER_BEAT - 1) /
+                                  (bpm_x10 * InternalClock::TICKS_PER_BEAT));
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(due, update, message);
+        last_tick = update;
+    }
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(bpm_x10 * InternalClock::TICKS_PER_BEAT, ticks, message);
+    TEST_ASSERT_TRUE_MESSAGE(last_tick > 0, message);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_whole_bpm(void) {
+    check_ten_minutes(10);
+    check_ten_minutes(1200);
+    check_ten_minutes(2550);
+}
+
+void test_fractional_bpm(void) {
+    check_ten_minutes(997);
+    check_ten_minutes(1205);
+    check_ten_minutes(1333);
+}
+
+void test_stopped(void) {
+    InternalClock clock(UPDATE_RATE_HZ);
+    clock.set_bpm_x10(0);
+    for (uint32_t update = 0; update < UPDATE_RATE_HZ; update++) {
+        TEST_ASSERT_EQUAL_UINT32(0, clock.advance());
+    }
+    clock.set_bpm_x10(-50);
+    TEST_ASSERT_EQUAL_UINT32(0, clock.advance());
+}
+
+// Half way between two ticks the phase reads half, and reset() starts a tick over
+void test_tick_phase(void) {
+    InternalClock clock(UPDATE_RATE_HZ);
+    // 128 BPM: 51.2 ticks per second, one tick per 20 updates
+    clock.set_bpm_x10(1280);
+    for (int update = 0; update < 10; update++) clock.advance();
+    TEST_ASSERT_EQUAL_UINT32(32768, clock.get_tick_phase());
+    for (int update = 0; update < 9; update++) TEST_ASSERT_EQUAL_UINT32(0, clock.advance());
+    TEST_ASSERT_EQUAL_UINT32(1, clock.advance());
+    TEST_ASSERT_EQUAL_UINT32(0, clock.get_tick_phase());
+
+    for (int update = 0; update < 5; update++) clock.advance();
+    clock.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, clock.get_tick_phase());
+    for (int update = 0; update < 19; update++) TEST_ASSERT_EQUAL_UINT32(0, clock.advance());
+    TEST_ASSERT_EQUAL_UINT32(1, clock.advance());
+}
+
+// A tempo change keeps the phase, so the tick after it is not cut short or doubled
+void test_tempo_change(void) {
+    InternalClock clock(UPDATE_RATE_HZ);
+    clock.set_bpm_x10(1280);
+    for (int update = 0; update < 10; update++) clock.advance();
+    // Twice the tempo covers the other half of the tick in 5 updates
+    clock.set_bpm_x10(2560);
+    for (int update = 0; update < 4; update++) TEST_ASSERT_EQUAL_UINT32(0, clock.advance());
+    TEST_ASSERT_EQUAL_UINT32(1, clock.advance());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_whole_bpm);
+    RUN_TEST(test_fractional_bpm);
+    RUN_TEST(test_stopped);
+    RUN_TEST(test_tick_phase);
+    RUN_TEST(test_tempo_change);
+    return UNITY_END();
+}
@@ -0,0 +1,48 @@
+// Voice mixer scaling: chords up to the whole pool clip at the rails.
+//
+//   pio test -e native -f test_mixer
+
+#include <unity.h>
+#include "osc/mixer.h"
+
+// One voice at full velocity on a table peak: int8 sample times the Q15 level
+static const int32_t PEAK_HIGH = 127 * 32767;
+static const int32_t PEAK_LOW = -128 * 32767;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_whole_pool_in_phase(void) {
+    TEST_ASSERT_EQUAL_INT(32767, mix_to_16(MAX_OSCS * PEAK_HIGH));
+    TEST_ASSERT_EQUAL_INT(-32768, mix_to_16(MAX_OSCS * PEAK_LOW));
+}
+
+// Adding voices never moves the output away from the rail it is heading for
+void test_monotonic_in_voices(void) {
+    int32_t high = 0, low = 0;
+    for (int voices = 1; voices <= MAX_OSCS; voices++) {
+        int32_t next_high = mix_to_16(voices * PEAK_HIGH);
+        int32_t next_low = mix_to_16(voices * PEAK_LOW);
+        TEST_ASSERT_TRUE(next_high >= high);
+        TEST_ASSERT_TRUE(next_low <= low);
+        high = next_high;
+        low = next_low;
+    }
+    TEST_ASSERT_EQUAL_INT(32767, high);
+    TEST_ASSERT_EQUAL_INT(-32768, low);
+}
+
+// MIX_VOICES voices reach full scale within 1% (+127 peaks, gain rounded down), fewer stay inside it
+void test_mix_voices_reach_full_scale(void) {
+    TEST_ASSERT_INT_WITHIN(32767 / 100, 32767, mix_to_16(MIX_VOICES * PEAK_HIGH));
+    TEST_ASSERT_TRUE(mix_to_16((MIX_VOICES - 1) * PEAK_HIGH) < 32767);
+    TEST_ASSERT_EQUAL_INT(0, mix_to_16(0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_whole_pool_in_phase);
+    RUN_TEST(test_monotonic_in_voices);
+    RUN_TEST(test_mix_voices_reach_full_scale);
+    return UNITY_END();
+}
@@ -0,0 +1,102 @@
+// PitchDetector on synthetic ADC blocks at the tuner's two sampling rates.
+//
+//   pio test -e native -f test_pitch_detector
+
+#include <unity.h>
+#include <math.h>
+#include <random>
+#include "oscilloscope/pitch_detector.h"
+
+enum Wave { WaveSine, WaveSaw, WaveSquare, WaveTriangle };
+
+static const double ADC_MID = 1800;     // 12 bit codes around the input bias
+static const double ADC_NOISE = 2.0;    // codes rms
+static const double LOW_RATE = 5000;    // TunerRoot::LOW_RATE
+static const double HIGH_RATE = 20000;  // TunerRoot::HIGH_RATE
+static const double LOW_BELOW_HZ = 160; // TunerRoot::LOW_BELOW_HZ
+
+static PitchDetector detector;
+static std::mt19937 rng(1);
+
+// Band limited to the harmonics below Nyquist, peak about 1
+static double wave(Wave type, double phase, double hz, double rate) {
+    if (type == WaveSine) return sin(2 * M_PI * phase);
+    double v = 0;
+    for (int h = 1; h * hz < rate / 2; h++) {
+        double s = sin(2 * M_PI * h * phase);
+        if (type == WaveSaw) v += 0.6 * s / h;
+        if (type == WaveSquare && (h & 1)) v += 0.8 * s / h;
+        if (type == WaveTriangle && (h & 1)) v += ((h / 2) & 1 ? -0.8 : 0.8) * s / (h * h);
+    }
+    return v;
+}
+
+// One block at a random phase, as the tuner captures it
+static float detect(Wave type, double hz, double rate, double amplitude) {
+    std::uniform_real_distribution<double> start(0, 1);
+    std::normal_distribution<double> noise(0, ADC_NOISE);
+    uint16_t samples[PitchDetector::MAX_SAMPLES];
+    double phase = start(rng);
+    for (int i = 0; i < PitchDetector::MAX_SAMPLES; i++) {
+        samples[i] = (uint16_t)lrint(ADC_MID + amplitude * wave(type, phase + hz * i / rate, hz, rate) + noise(rng));
+    }
+    return detector.detect(samples, PitchDetector::MAX_SAMPLES);
+}
+
+// Every block of notes from 41 Hz to 2.1 kHz, at the rate the tuner settles on
+static void check_wave(Wave type, double amplitude, double tolerance_cents) {
+    char message[64];
+    for (double note = 28; note <= 96; note += 0.37) {
+        double hz = 440 * pow(2, (note - 69) / 12);
+        double rate = hz < LOW_BELOW_HZ ? LOW_RATE : HIGH_RATE;
+        for (int block = 0; block < 4; block++) {
+            float period = detect(type, hz, rate, amplitude);
+            snprintf(message, sizeof(message), "wave %d at %.2f Hz", type, hz);
+            TEST_ASSERT_GREATER_THAN_MESSAGE(0, period, message);
+            double cents = 1200 * log2(rate / period / hz);
+            TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance_cents, 0, cents, message);
+        }
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_sine(void) { check_wave(WaveSine, 1000, 1.0); }
+void test_saw(void) { check_wave(WaveSaw, 1000, 1.0); }
+void test_square(void) { check_wave(WaveSquare, 1000, 1.0); }
+void test_triangle(void) { check_wave(WaveTriangle, 1000, 1.0); }
+
+// At a tenth of the level the ADC noise alone spreads low notes by about 0.3 cent rms
+void test_quiet_sine(void) { check_wave(WaveSine, 100, 2.0); }
+
+void test_silence(void) {
+    std::normal_distribution<double> noise(0, ADC_NOISE);
+    uint16_t samples[PitchDetector::MAX_SAMPLES];
+    for (int block = 0; block < 16; block++) {
+        for (int i = 0; i < PitchDetector::MAX_SAMPLES; i++) samples[i] = (uint16_t)lrint(ADC_MID + noise(rng));
+        TEST_ASSERT_EQUAL_FLOAT(0, detector.detect(samples, PitchDetector::MAX_SAMPLES));
+    }
+}
+
+// Loud white noise has no period
+void test_noise(void) {
+    std::uniform_int_distribution<int> noise(-750, 750);
+    uint16_t samples[PitchDetector::MAX_SAMPLES];
+    for (int block = 0; block < 16; block++) {
+        for (int i = 0; i < PitchDetector::MAX_SAMPLES; i++) samples[i] = (uint16_t)(ADC_MID + noise(rng));
+        TEST_ASSERT_EQUAL_FLOAT(0, detector.detect(samples, PitchDetector::MAX_SAMPLES));
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sine);
+    RUN_TEST(test_saw);
+    RUN_TEST(test_square);
+    RUN_TEST(test_triangle);
+    RUN_TEST(test_quiet_sine);
+    RUN_TEST(test_silence);
+    RUN_TEST(test_noise);
+    return UNITY_END();
+}
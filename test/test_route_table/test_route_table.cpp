@@ -0,0 +1,106 @@
+// RouteTable voices built from the output settings.
+//
+//   pio test -e native -f test_route_table
+
+#include <unity.h>
+#include <nvs_flash.h>
+#include "signal_processor/route_table.h"
+
+static MidiSettingsState* state;
+static RouteTable routes;
+
+static bool in_note_routes(uint8_t channel, uint8_t out) {
+    const RouteTable::RouteList& list = routes.get(channel, RouteNote);
+    for (uint8_t r = 0; r < list.count; r++) {
+        if (list.routes[r].out == out) return true;
+    }
+    return false;
+}
+
+void setUp(void) {
+    state = new MidiSettingsState();
+    state->begin();
+    for (size_t i = 0; i < OutChannelCount; i++) state->set_midi_out_channel(i, MidiChannel1);
+    state->set_poly_mode(PolySteal);
+}
+
+void tearDown(void) {
+    delete state;
+}
+
+// Pitch A/B with gates CLK/RST: two voices, C's velocity goes with the first
+void test_pitch_gate_voices(void) {
+    state->set_midi_out_type(OutChannelA, MidiOutPitch);
+    state->set_midi_out_type(OutChannelB, MidiOutPitch);
+    state->set_midi_out_type(OutChannelC, MidiOutVelocity);
+    state->set_midi_out_type(OutChannelClk, MidiOutGate);
+    state->set_midi_out_type(OutChannelRst, MidiOutGate);
+    routes.build(state);
+
+    const RouteTable::VoiceList& voices = routes.get_voices(MidiChannel1);
+    TEST_ASSERT_EQUAL_INT(2, voices.count);
+    TEST_ASSERT_EQUAL_INT(OutChannelA, voices.voices[0].pitch);
+    TEST_ASSERT_EQUAL_INT(OutChannelClk, voices.voices[0].gate);
+    TEST_ASSERT_EQUAL_INT(OutChannelC, voices.voices[0].velocity);
+    TEST_ASSERT_EQUAL_INT(OutChannelB, voices.voices[1].pitch);
+    TEST_ASSERT_EQUAL_INT(OutChannelRst, voices.voices[1].gate);
+    TEST_ASSERT_EQUAL_INT(RouteTable::NO_OUT, voices.voices[1].velocity);
+    for (uint8_t out = 0; out < OutChannelCount; out++) TEST_ASSERT_FALSE(in_note_routes(MidiChannel1, out));
+}
+
+// More velocity outputs than voices: the extra one stays a mono route instead of going silent
+void test_extra_velocity_stays_mono(void) {
+    state->set_midi_out_type(OutChannelA, MidiOutVelocity);
+    state->set_midi_out_type(OutChannelB, MidiOutVelocity);
+    state->set_midi_out_type(OutChannelC, MidiOutVelocity);
+    state->set_midi_out_type(OutChannelClk, MidiOutGate);
+    state->set_midi_out_type(OutChannelRst, MidiOutGate);
+    routes.build(state);
+
+    const RouteTable::VoiceList& voices = routes.get_voices(MidiChannel1);
+    TEST_ASSERT_EQUAL_INT(2, voices.count);
+    TEST_ASSERT_EQUAL_INT(OutChannelA, voices.voices[0].velocity);
+    TEST_ASSERT_EQUAL_INT(OutChannelB, voices.voices[1].velocity);
+    for (size_t v = voices.count; v < OutChannelCount; v++) {
+        TEST_ASSERT_EQUAL_INT(RouteTable::NO_OUT, voices.voices[v].velocity);
+    }
+    TEST_ASSERT_TRUE(in_note_routes(MidiChannel1, OutChannelC));
+    TEST_ASSERT_FALSE(in_note_routes(MidiChannel1, OutChannelA));
+    TEST_ASSERT_FALSE(in_note_routes(MidiChannel1, OutChannelB));
+}
+
+// One pitch and one gate are plain mono even with poly on
+void test_single_voice_is_mono(void) {
+    state->set_midi_out_type(OutChannelA, MidiOutMozzi);
+    state->set_midi_out_type(OutChannelB, MidiOutMozzi);
+    state->set_midi_out_type(OutChannelC, MidiOutPitch);
+    state->set_midi_out_type(OutChannelClk, MidiOutGate);
+    state->set_midi_out_type(OutChannelRst, MidiOutClock1_4);
+    routes.build(state);
+
+    TEST_ASSERT_EQUAL_INT(0, routes.get_voices(MidiChannel1).count);
+    TEST_ASSERT_TRUE(in_note_routes(MidiChannel1, OutChannelC));
+    TEST_ASSERT_TRUE(in_note_routes(MidiChannel1, OutChannelClk));
+}
+
+// Mono outputs follow the latest note on out of the box
+void test_default_priority_is_last(void) {
+    state->set_poly_mode(PolyOff);
+    routes.build(state);
+
+    const RouteTable::RouteList& list = routes.get(MidiChannel1, RouteNote);
+    TEST_ASSERT_TRUE(list.count > 0);
+    for (uint8_t r = 0; r < list.count; r++) {
+        TEST_ASSERT_EQUAL_INT(NotePriorityLast, list.routes[r].priority);
+    }
+}
+
+int main(void) {
+    nvs_flash_init();
+    UNITY_BEGIN();
+    RUN_TEST(test_pitch_gate_voices);
+    RUN_TEST(test_extra_velocity_stays_mono);
+    RUN_TEST(test_single_voice_is_mono);
+    RUN_TEST(test_default_priority_is_last);
+    return UNITY_END();
+}
@@ -0,0 +1,200 @@
+// VoiceAllocator fed by NoteHistory ids as handle_note_on()/handle_note_off()
+// do, replaying chord progressions in every poly mode for 2 to 5 voices.
+//
+//   pio test -e native -f test_voice_allocator
+
+#include <unity.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "midi/note_history.h"
+#include "signal_processor/voice_allocator.h"
+
+static const PolyMode MODES[] = {PolyRoundRobin, PolyReuse, PolySteal};
+static const uint8_t MIN_VOICES = 2;
+static const uint8_t MAX_VOICES = 5;
+static const uint8_t NO_NOTE = NoteHistory::NO_NOTE;
+
+// The outputs as SignalProcessor drives them: the note on each voice's gate
+struct Player {
+    NoteHistory history;
+    VoiceAllocator allocator;
+    PolyMode mode;
+    uint8_t gate[VoiceAllocator::MAX_VOICES];
+    uint8_t voice_count;
+
+    Player(PolyMode mode, uint8_t voice_count) : mode(mode), voice_count(voice_count) {
+        allocator.reset(voice_count);
+        for (size_t v = 0; v < VoiceAllocator::MAX_VOICES; v++) gate[v] = NO_NOTE;
+    }
+
+    // A key that is already down cannot be struck again
+    void note_on(uint8_t note) {
+        if (history.is_in_use(note)) return;
+        uint8_t id;
+        TEST_ASSERT_TRUE(history.push(note, &id));
+        uint8_t stolen_id;
+        uint8_t v = allocator.note_on(note, id, mode, &stolen_id);
+        TEST_ASSERT_TRUE(v < voice_count);
+        // A voice is only taken from a note while every voice is busy
+        if (stolen_id != VoiceAllocator::NO_ID) TEST_ASSERT_TRUE(all_busy_but(v));
+        gate[v] = note;
+        check();
+    }
+
+    void note_off(uint8_t note) {
+        if (!history.is_in_use(note)) return;
+        uint8_t id;
+        TEST_ASSERT_TRUE(history.pop(note, &id));
+        uint8_t v = allocator.note_off(id);
+        if (v == VoiceAllocator::NO_VOICE) {
+            // Stolen: the voice has moved on to another note
+            for (uint8_t i = 0; i < voice_count; i++) TEST_ASSERT_TRUE(gate[i] != note);
+        } else {
+            TEST_ASSERT_TRUE(v < voice_count);
+            TEST_ASSERT_EQUAL_INT(note, gate[v]);
+            gate[v] = NO_NOTE;
+        }
+        check();
+    }
+
+    bool all_busy_but(uint8_t voice) const {
+        for (uint8_t v = 0; v < voice_count; v++) {
+            if (v != voice && !allocator.is_active(v)) return false;
+        }
+        return true;
+    }
+
+    // Gates sound only held notes, each on one voice, and the allocator agrees
+    void check(void) {
+        for (uint8_t v = 0; v < voice_count; v++) {
+            TEST_ASSERT_EQUAL_INT(gate[v] != NO_NOTE, allocator.is_active(v));
+            if (gate[v] == NO_NOTE) continue;
+            TEST_ASSERT_TRUE(history.is_in_use(gate[v]));
+            for (uint8_t w = v + 1; w < voice_count; w++) TEST_ASSERT_TRUE(gate[w] != gate[v]);
+        }
+        for (uint8_t v = voice_count; v < VoiceAllocator::MAX_VOICES; v++) {
+            TEST_ASSERT_FALSE(allocator.is_active(v));
+        }
+    }
+
+    void check_silent(void) {
+        TEST_ASSERT_TRUE(history.is_empty());
+        for (uint8_t v = 0; v < voice_count; v++) {
+            TEST_ASSERT_FALSE(allocator.is_active(v));
+            TEST_ASSERT_EQUAL_INT(NO_NOTE, gate[v]);
+        }
+    }
+};
+
+typedef void (*Replay)(Player& player);
+
+static void for_every_setup(Replay replay) {
+    for (PolyMode mode : MODES) {
+        for (uint8_t voices = MIN_VOICES; voices <= MAX_VOICES; voices++) {
+            Player player(mode, voices);
+            replay(player);
+            player.check_silent();
+        }
+    }
+}
+
+// I - vi - IV - V in four note chords: common tones stay down, the new notes
+// are pressed before the old ones are released
+static void legato_progression(Player& player) {
+    static const uint8_t CHORDS[4][4] = {
+        {48, 52, 55, 60}, {45, 52, 57, 60}, {41, 53, 57, 60}, {43, 50, 55, 59}};
+    for (int bar = 0; bar < 8; bar++) {
+        const uint8_t* chord = CHORDS[bar % 4];
+        const uint8_t* last = CHORDS[(bar + 3) % 4];
+        for (int n = 0; n < 4; n++) player.note_on(chord[n]);
+        if (bar == 0) continue;
+        for (int n = 0; n < 4; n++) {
+            if (std::find(chord, chord + 4, last[n]) == chord + 4) player.note_off(last[n]);
+        }
+    }
+    for (int n = 0; n < 4; n++) player.note_off(CHORDS[3][n]);
+}
+
+// Chords wider than the voices, released top down, bottom up and inside out
+static void wide_chords(Player& player) {
+    static const uint8_t CHORD[7] = {36, 43, 48, 52, 55, 60, 64};
+    for (int order = 0; order < 3; order++) {
+        for (int n = 0; n < 7; n++) player.note_on(CHORD[n]);
+        for (int n = 0; n < 7; n++) {
+            int i = order == 0 ? 6 - n : order == 1 ? n : (n & 1 ? 3 + (n + 1) / 2 : 3 - n / 2);
+            player.note_off(CHORD[i]);
+        }
+    }
+}
+
+// The same notes struck again while they ring and while others are stolen
+static void repeated_notes(Player& player) {
+    for (int round = 0; round < 4; round++) {
+        player.note_on(60);
+        player.note_on(64);
+        player.note_off(60);
+        player.note_on(60);
+        player.note_on(67);
+        player.note_on(71);
+        player.note_on(74);
+        player.note_off(64);
+        player.note_on(64);
+        player.note_off(60);
+    }
+    for (uint8_t note : {64, 67, 71, 74}) player.note_off(note);
+}
+
+// Random chords of 1 to 8 notes, common tones held over, the rest released in random order
+static void random_chords(Player& player) {
+    std::mt19937 rng(player.voice_count * 16 + player.mode);
+    std::uniform_int_distribution<int> size(1, 8);
+    std::uniform_int_distribution<int> pitch(36, 84);
+    std::vector<uint8_t> held;
+    for (int chord = 0; chord < 500; chord++) {
+        std::vector<uint8_t> next;
+        for (int n = size(rng); n > 0; n--) next.push_back(pitch(rng));
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        std::shuffle(next.begin(), next.end(), rng);
+        for (uint8_t note : next) player.note_on(note);
+
+        std::shuffle(held.begin(), held.end(), rng);
+        for (uint8_t note : held) {
+            if (std::find(next.begin(), next.end(), note) == next.end()) player.note_off(note);
+        }
+        held = next;
+    }
+    for (uint8_t note : held) player.note_off(note);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_legato_progression(void) { for_every_setup(legato_progression); }
+void test_wide_chords(void) { for_every_setup(wide_chords); }
+void test_repeated_notes(void) { for_every_setup(repeated_notes); }
+void test_random_chords(void) { for_every_setup(random_chords); }
+
+// reset() with notes down frees every voice, their note offs find nothing
+void test_reset_while_held(void) {
+    for (PolyMode mode : MODES) {
+        VoiceAllocator allocator;
+        allocator.reset(3);
+        uint8_t stolen_id;
+        for (uint8_t id = 0; id < 3; id++) allocator.note_on(60 + id, id, mode, &stolen_id);
+        allocator.reset(4);
+        for (uint8_t v = 0; v < VoiceAllocator::MAX_VOICES; v++) TEST_ASSERT_FALSE(allocator.is_active(v));
+        for (uint8_t id = 0; id < 3; id++) TEST_ASSERT_EQUAL_INT(VoiceAllocator::NO_VOICE, allocator.note_off(id));
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_legato_progression);
+    RUN_TEST(test_wide_chords);
+    RUN_TEST(test_repeated_notes);
+    RUN_TEST(test_random_chords);
+    RUN_TEST(test_reset_while_held);
+    return UNITY_END();
+}
@@ -0,0 +1,221 @@
+// Fold-back per wavetable: plays a note sweep of every waveform through
+// SignalProcessor and the osc voice engine, as the offline renderer does, and
+// measures the share of the output energy that is not at a harmonic of the
+// note. Harmonics above Nyquist land between the harmonics when they fold back.
+//
+//   pio test -e native -f test_wavetable_aliasing -v
+
+#include <unity.h>
+#include <nvs_flash.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "signal_processor/signal_processor.h"
+#include <Mozzi.h>
+#include <Oscil.h>
+#include <mozzi_midi.h>
+#include "host/hal.h"
+#include "osc/wavetables.h"
+#include "osc/cc_map.h"
+
+void osc_init(SignalProcessor* signal_processor);
+
+static const uint8_t FIRST_NOTE = 36;
+static const uint8_t LAST_NOTE = 108;
+static const uint8_t NOTE_STEP = 6;
+static const int NOTE_COUNT = (LAST_NOTE - FIRST_NOTE) / NOTE_STEP + 1;
+
+// Per tone: attack and output latency, the analysed block, then the release
+static const size_t SETTLE = MOZZI_AUDIO_RATE / 10;
+static const size_t LENGTH = 16384;
+static const size_t GAP = MOZZI_AUDIO_RATE / 5;
+static const size_t TONE_SAMPLES = SETTLE + LENGTH + GAP;
+static const int LOBE_BINS = 5; // Blackman-Harris main lobe half width, sidelobes -92 dB
+
+static const uint8_t TOP_OCTAVE = LAST_NOTE - 12;
+static const double MAX_FOLD_BACK_DB = -22.0;
+static const double MAX_TOP_OCTAVE_DB = -33.0;
+
+static const char* const WAVE_NAMES[WaveCount] = {"sine", "triangle", "saw", "square", "chebyshev"};
+
+static SignalProcessor* processor = nullptr;
+static std::vector<int16_t> audio; // left channel
+static size_t tone = 0;
+static bool tone_held = false;
+static size_t tone_start[WaveCount * NOTE_COUNT];
+static double fold_back[WaveCount][NOTE_COUNT];
+
+static uint8_t tone_note(size_t t) {
+    return FIRST_NOTE + (t % NOTE_COUNT) * NOTE_STEP;
+}
+
+static void control_hook(void) {
+    size_t now = audio.size();
+    if (tone_held && now >= tone_start[tone] + SETTLE + LENGTH) {
+        processor->post_event(MidiInputSerial, EventNoteOff, 1, tone_note(tone), 0);
+        tone_held = false;
+        tone++;
+    }
+    if (tone == WaveCount * NOTE_COUNT) {
+        if (now >= tone_start[tone - 1] + TONE_SAMPLES) throw HostStop();
+        return;
+    }
+    if (!tone_held && now >= tone * TONE_SAMPLES) {
+        int wave = tone / NOTE_COUNT;
+        processor->post_event(MidiInputSerial, EventCc, 1, CC_WAVEFORM, (wave * 128 + 127) / WaveCount);
+        processor->post_event(MidiInputSerial, EventNoteOn, 1, tone_note(tone), 127);
+        tone_start[tone] = now;
+        tone_held = true;
+    }
+}
+
+static void audio_sink(int left, int right) {
+    (void)right;
+    audio.push_back((int16_t)(left - (int)MOZZI_AUDIO_BIAS));
+}
+
+// The frequency the oscillator plays, after its phase increment is rounded
+static double played_hz(uint8_t note) {
+    uint64_t increment = ((uint64_t)Q16n16_mtof(Q8n0_to_Q16n16(note)) * WAVE_CELLS) / MOZZI_AUDIO_RATE;
+    return increment * (double)MOZZI_AUDIO_RATE / (WAVE_CELLS * 65536.0);
+}
+
+// Share of the energy of x outside the main lobes of DC and every harmonic of hz
+static double measure_fold_back(const int16_t* x, double hz) {
+    std::vector<double> y(LENGTH);
+    double mean = 0;
+    for (size_t n = 0; n < LENGTH; n++) mean += x[n];
+    mean /= LENGTH;
+
+    double total = 0;
+    for (size_t n = 0; n < LENGTH; n++) {
+        double p = 2.0 * M_PI * n / LENGTH;
+        double w = 0.35875 - 0.48829 * cos(p) + 0.14128 * cos(2 * p) - 0.01168 * cos(3 * p);
+        y[n] = (x[n] - mean) * w;
+        total += y[n] * y[n];
+    }
+    if (total == 0) return 0;
+
+    // Goertzel at every bin in a lobe, each bin once
+    const int half = LENGTH / 2;
+    std::vector<bool> in_lobe(half + 1, false);
+    double bin_hz = (double)MOZZI_AUDIO_RATE / LENGTH;
+    for (double f = 0; f < MOZZI_AUDIO_RATE / 2; f += hz) {
+        int center = (int)lround(f / bin_hz);
+        for (int k = center - LOBE_BINS; k <= center + LOBE_BINS; k++) {
+            if (k >= 0 && k <= half) in_lobe[k] = true;
+        }
+    }
+
+    double harmonic = 0;
+    for (int k = 0; k <= half; k++) {
+        if (!in_lobe[k]) continue;
+        double coeff = 2.0 * cos(2.0 * M_PI * k / LENGTH);
+        double s1 = 0, s2 = 0;
+        for (size_t n = 0; n < LENGTH; n++) {
+            double s0 = y[n] + coeff * s1 - s2;
+            s2 = s1;
+            s1 = s0;
+        }
+        double power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+        harmonic += (k == 0 || k == half) ? power : 2 * power;
+    }
+    return 1.0 - harmonic / (LENGTH * total);
+}
+
+static double to_db(double share) {
+    return 10.0 * log10(share > 1e-12 ? share : 1e-12);
+}
+
+// Worst fold-back of a waveform over notes from first_note, in dB of the output energy
+static double worst_db(int wave, uint8_t first_note, uint8_t* worst_note) {
+    double worst = -INFINITY;
+    for (int i = 0; i < NOTE_COUNT; i++) {
+        uint8_t note = FIRST_NOTE + i * NOTE_STEP;
+        double db = to_db(fold_back[wave][i]);
+        if (note >= first_note && db > worst) {
+            worst = db;
+            *worst_note = note;
+        }
+    }
+    return worst;
+}
+
+// Over the whole sweep the floor is the oscillator's own: it reads the 256 cells
+// without interpolation, so the images of a full table's top harmonics fold back
+// (about -25 dB for saw and square on the low notes of a mip). In the top octave,
+// where the full tables fold back at -8 to -13 dB, only that floor is left.
+static void check_wave(int wave) {
+    uint8_t note = 0;
+    double db = worst_db(wave, FIRST_NOTE, &note);
+    char message[96];
+    snprintf(message, sizeof(message), "%s: worst fold-back %.1f dB at note %d", WAVE_NAMES[wave], db, note);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE_MESSAGE(db < MAX_FOLD_BACK_DB, message);
+
+    db = worst_db(wave, TOP_OCTAVE, &note);
+    snprintf(message, sizeof(message), "%s: top octave %.1f dB at note %d", WAVE_NAMES[wave], db, note);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE_MESSAGE(db < MAX_TOP_OCTAVE_DB, message);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_sine(void) { check_wave(WaveSine); }
+void test_triangle(void) { check_wave(WaveTriangle); }
+void test_saw(void) { check_wave(WaveSaw); }
+void test_square(void) { check_wave(WaveSquare); }
+void test_chebyshev(void) { check_wave(WaveChebyshev); }
+
+// The full saw table at the top of the sweep, where its harmonics fold back:
+// the measure has to see it
+void test_measure_sees_aliasing(void) {
+    Oscil<WAVE_CELLS, MOZZI_AUDIO_RATE> raw(WAVETABLES[WaveSaw][0]);
+    raw.setFreq_Q16n16(Q16n16_mtof(Q8n0_to_Q16n16(96)));
+    std::vector<int16_t> x(LENGTH);
+    for (size_t n = 0; n < LENGTH; n++) x[n] = raw.next();
+
+    double db = to_db(measure_fold_back(x.data(), played_hz(96)));
+    char message[64];
+    snprintf(message, sizeof(message), "unfiltered saw: fold-back %.1f dB at note 96", db);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE_MESSAGE(db > MAX_FOLD_BACK_DB, message);
+}
+
+static void render_sweep(void) {
+    MidiSettingsState state;
+    state.begin();
+    state.set_midi_out_type(OutChannelA, MidiOutMozzi);
+
+    SignalProcessor signal_processor(&state);
+    processor = &signal_processor;
+    osc_init(&signal_processor);
+    host_mozzi_set_hooks(control_hook, audio_sink);
+    audio.reserve(WaveCount * NOTE_COUNT * TONE_SAMPLES + MOZZI_AUDIO_RATE);
+
+    try {
+        signal_processor.begin();
+    } catch (const HostStop&) {
+    }
+    processor = nullptr;
+
+    for (size_t t = 0; t < WaveCount * NOTE_COUNT; t++) {
+        fold_back[t / NOTE_COUNT][t % NOTE_COUNT] =
+            measure_fold_back(&audio[tone_start[t] + SETTLE], played_hz(tone_note(t)));
+    }
+}
+
+int main(void) {
+    nvs_flash_init();
+    render_sweep();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_sine);
+    RUN_TEST(test_triangle);
+    RUN_TEST(test_saw);
+    RUN_TEST(test_square);
+    RUN_TEST(test_chebyshev);
+    RUN_TEST(test_measure_sees_aliasing);
+    return UNITY_END();
+}